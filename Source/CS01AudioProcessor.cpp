@@ -1,32 +1,133 @@
 #include "CS01AudioProcessor.h"
 #include "CS01AudioProcessorEditor.h"
 #include "Parameters.h"
+#include "ModulatableParameter.h"
 #include "CS01Synth/VCOProcessor.h"
 #include "CS01Synth/MidiProcessor.h"
 #include "CS01Synth/IFilter.h"  // Explicit include
 
 //==============================================================================
-CS01AudioProcessor::CS01AudioProcessor()
+CS01AudioProcessor::CS01AudioProcessor(bool compactInstance)
     : AudioProcessor(BusesProperties().withOutput("Output", juce::AudioChannelSet::stereo(), true)),
       apvts(*this, nullptr, "Parameters", createParameterLayout()),
+      compact(compactInstance),
+      parameterSync(apvts),
       presetManager(apvts) {
+    if (!compact)
+        getEditorState();
+
+    buildGraph();
+
     apvts.addParameterListener(ParameterIds::lfoTarget, this);
     apvts.addParameterListener(ParameterIds::filterType, this);
     apvts.addParameterListener(ParameterIds::feet, this);
+    apvts.addParameterListener(ParameterIds::processingRate, this);
+
+    // The same listeners for changes made on the audio thread
+    parameterSync.addListener(ParameterIds::lfoTarget, this);
+    parameterSync.addListener(ParameterIds::filterType, this);
+    parameterSync.addListener(ParameterIds::processingRate, this);
+    startTimer(GRAPH_CHANGE_POLL_MS);
+
+#if CS01_CLAP_DIRECT_PROCESS
+    // The CLAP wrapper derives each parameter's id from the hash of its JUCE parameter ID
+    for (auto* parameter : getParameters()) {
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            clapParameters[static_cast<juce::uint32>(ranged->getParameterID().hashCode())] = ranged;
+    }
+#endif
 }
 
 CS01AudioProcessor::~CS01AudioProcessor() {
     apvts.removeParameterListener(ParameterIds::lfoTarget, this);
     apvts.removeParameterListener(ParameterIds::filterType, this);
     apvts.removeParameterListener(ParameterIds::feet, this);
+    apvts.removeParameterListener(ParameterIds::processingRate, this);
+    stopTimer();
+    cancelPendingUpdate();
 }
 
 //==============================================================================
 void CS01AudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
     midiMessageCollector.reset(sampleRate);
 
-    audioGraph.clear();
+    // Decide the engine rate. In fixed-rate mode the graph runs at 48/96 kHz and
+    // its output is resampled to the host rate.
+    engineSampleRate = getRequestedEngineSampleRate(sampleRate);
+    useInternalRate = std::abs(engineSampleRate - sampleRate) > 1.0e-6;
+    hostSampleRate = sampleRate;
+
+    // In deterministic mode the graph only ever sees quantum-sized blocks
+    quantisedRendering = deterministic;
+    quantumPosition = 0;
+    voiceActive = false;
+    tailSamplesRemaining = 0;
+    maximumHostBlockSize = quantisedRendering ? RENDER_QUANTUM : samplesPerBlock;
+
+    int engineBlockSize = maximumHostBlockSize;
+    int latency = quantisedRendering ? RENDER_QUANTUM : 0;
+
+    if (useInternalRate) {
+        resampler.prepare(engineSampleRate, sampleRate, maximumHostBlockSize);
+        engineBlockSize = resampler.getMaximumInputSamplesRequired();
+        engineBuffer.setSize(getMainBusNumOutputChannels(), engineBlockSize);
+        latency += resampler.getLatencyInOutputSamples();
+    } else {
+        engineBuffer.setSize(0, 0);
+    }
+
+    setLatencySamples(latency);
+
+    if (quantisedRendering) {
+        quantumBuffer.setSize(juce::jmax(1, getMainBusNumOutputChannels()), RENDER_QUANTUM);
+        quantumBuffer.clear();
+    } else {
+        quantumBuffer.setSize(0, 0);
+    }
+
+    engineMidi.ensureSize(2048);
+    chunkMidi.ensureSize(2048);
+    quantumMidi.ensureSize(2048);
+    quantumMidi.clear();
+    quantumParameterEvents.clear();
+    quantumParameterEvents.reserve(MAX_PARAMETER_EVENTS);
+#if CS01_CLAP_DIRECT_PROCESS
+    clapMidi.ensureSize(2048);
+    clapParameterEvents.reserve(MAX_PARAMETER_EVENTS);
+#endif
+
+    programRamp.prepare(parameterSync, sampleRate, PROGRAM_RAMP_SECONDS,
+                        presetManager.getParameterList(), presetManager.getPresetExcludedMask());
+    programChangeTarget.assign(presetManager.getParameterList().size(), 0.0f);
+    if (editorState != nullptr) {
+        editorState->scopeCapture.prepare(sampleRate);
+        editorState->spectrumAnalyser.prepare(sampleRate);
+    }
+#if CS01_ENABLE_PROFILING
+    dspProfiler.prepare(sampleRate);
+#endif
+
+    // The graph was built in the constructor. Releasing it first makes every node prepare
+    // again, and so start from its initial state, even when the spec is unchanged
+    audioGraph.releaseResources();
+
+    // Routing changes still waiting for the timer
+    applyPendingGraphChanges();
+
+    // Deterministic renders restart the noise sequence from the fixed seed
+    if (quantisedRendering)
+        static_cast<VCOProcessor*>(vcoNode->getProcessor())->setNoiseSeed(noiseSeed);
+
+    // Set graph's main bus layout and prepare; the output connections follow the layout
+    audioGraph.setPlayConfigDetails(getMainBusNumInputChannels(), getMainBusNumOutputChannels(),
+                                    engineSampleRate, engineBlockSize);
+    updateVCAOutputConnections();
+    audioGraph.prepareToPlay(engineSampleRate, engineBlockSize);
+    isPrepared = true;
+}
 
+// Nodes and connections are created once; prepareToPlay only prepares them for the spec
+void CS01AudioProcessor::buildGraph() {
     // 1. Add nodes
     midiInputNode =
         audioGraph.addNode(std::make_unique<juce::AudioProcessorGraph::AudioGraphIOProcessor>(
@@ -35,13 +136,10 @@ void CS01AudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
         audioGraph.addNode(std::make_unique<juce::AudioProcessorGraph::AudioGraphIOProcessor>(
             juce::AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode));
     midiProcessorNode = audioGraph.addNode(std::make_unique<MidiProcessor>(apvts));
-    vcoNode =
-        audioGraph.addNode(std::make_unique<VCOProcessor>(apvts));  // Default is ToneGenerator
+    vcoNode = audioGraph.addNode(std::make_unique<VCOProcessor>(apvts, false, compact));
     egNode = audioGraph.addNode(std::make_unique<EGProcessor>(apvts));
     lfoNode = audioGraph.addNode(std::make_unique<LFOProcessor>(apvts));
     vcaNode = audioGraph.addNode(std::make_unique<VCAProcessor>(apvts));
-    vcfNode = audioGraph.addNode(std::make_unique<OriginalVCFProcessor>(apvts));
-    modernVcfNode = audioGraph.addNode(std::make_unique<ModernVCFProcessor>(apvts));
 
     // 2. Set bus layouts
     audioOutputNode->getProcessor()->enableAllBuses();
@@ -50,37 +148,32 @@ void CS01AudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
     egNode->getProcessor()->enableAllBuses();
     lfoNode->getProcessor()->enableAllBuses();
     vcaNode->getProcessor()->enableAllBuses();
-    vcfNode->getProcessor()->enableAllBuses();
-    modernVcfNode->getProcessor()->enableAllBuses();
+
+    // Compact instances add the other filter when it is first selected
+    if (!compact) {
+        addFilterNode(0);
+        addFilterNode(1);
+    }
 
     // 3. Connect nodes
-    // Configure connections based on filter type
-    auto filterType =
-        static_cast<int>(apvts.getRawParameterValue(ParameterIds::filterType)->load());
+    // Routing for the current parameter values; later changes go through
+    // applyPendingGraphChanges on the message thread
+    requestedFilterType.store(
+        static_cast<int>(apvts.getRawParameterValue(ParameterIds::filterType)->load()));
+    requestedLfoTarget.store(
+        static_cast<int>(apvts.getRawParameterValue(ParameterIds::lfoTarget)->load()));
 
     // Audio Path: vco -> vcf -> vca -> output
-    // Connect only the mono channel (ch = 0)
-    if (filterType == 0)  // Original
-    {
-        audioGraph.addConnection({{vcoNode->nodeID, 0}, {vcfNode->nodeID, 0}});
-        audioGraph.addConnection({{vcfNode->nodeID, 0}, {vcaNode->nodeID, 0}});
-    } else  // Modern
-    {
-        audioGraph.addConnection({{vcoNode->nodeID, 0}, {modernVcfNode->nodeID, 0}});
-        audioGraph.addConnection({{modernVcfNode->nodeID, 0}, {vcaNode->nodeID, 0}});
-    }
+    applyFilterRouting(requestedFilterType.load());
     // Connection from VCA to audioOutputNode (automatically configured based on output bus layout)
     updateVCAOutputConnections();
 
     // Sidechain Paths
-    // EG -> VCA (Sidechain)
+    // EG -> VCA (Sidechain); the filters get theirs in addFilterNode
     audioGraph.addConnection({{egNode->nodeID, 0}, {vcaNode->nodeID, 1}});
-    // EG -> VCF (Sidechain)
-    audioGraph.addConnection({{egNode->nodeID, 0}, {vcfNode->nodeID, 1}});
-    // EG -> ModernVCF (Sidechain)
-    audioGraph.addConnection({{egNode->nodeID, 0}, {modernVcfNode->nodeID, 1}});
 
-    // LFO Path is connected dynamically via parameterChanged listener
+    // LFO Path: to the VCO or the active filter
+    applyLfoRouting(requestedLfoTarget.load());
 
     // MIDI Path - Simplified: only midiInput -> midiProcessor
     // No other MIDI connections needed as MidiProcessor directly controls ToneGenerator and
@@ -94,86 +187,105 @@ void CS01AudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
     auto* vcoProcessor = static_cast<VCOProcessor*>(vcoNode->getProcessor());
     auto* egProcessor = static_cast<EGProcessor*>(egNode->getProcessor());
 
-    if (midiProcessor != nullptr && vcoProcessor != nullptr && egProcessor != nullptr) {
-        // Set the sound generator
-        midiProcessor->setSoundGenerator(vcoProcessor->getSoundGenerator());
-        midiProcessor->setEGProcessor(egProcessor);
+    // Set the sound generator
+    midiProcessor->setSoundGenerator(vcoProcessor->getSoundGenerator());
+    midiProcessor->setEGProcessor(egProcessor);
+
+    // Set up VCO generator type change callback
+    vcoProcessor->onGeneratorTypeChanged = [this]() { handleGeneratorTypeChanged(); };
+    parameterSync.addListener(ParameterIds::feet, vcoProcessor);
+
+    // MIDI Program Change is applied from pre-decoded snapshots on the audio thread
+    midiProcessor->onProgramChange = [this](int program) { handleMidiProgramChange(program); };
+}
+
+// Adds the Original (0) or Modern filter with the EG on its sidechain, unless it exists.
+// A node added to a prepared graph is prepared when the graph rebuilds
+void CS01AudioProcessor::addFilterNode(int filterType) {
+    auto& node = filterType == 0 ? vcfNode : modernVcfNode;
+    if (node != nullptr)
+        return;
+
+    std::unique_ptr<juce::AudioProcessor> filter;
+    if (filterType == 0)
+        filter = std::make_unique<OriginalVCFProcessor>(apvts);
+    else
+        filter = std::make_unique<ModernVCFProcessor>(apvts);
+
+    filter->enableAllBuses();
+    node = audioGraph.addNode(std::move(filter));
+    audioGraph.addConnection({{egNode->nodeID, 0}, {node->nodeID, 1}});
+}
 
-        // Set up VCO generator type change callback
-        vcoProcessor->onGeneratorTypeChanged = [this]() { handleGeneratorTypeChanged(); };
+// Connects the VCO and VCA through the selected filter (mono, channel 0)
+void CS01AudioProcessor::applyFilterRouting(int filterType) {
+    addFilterNode(filterType);
+
+    // Remove existing connections (safe to call even if absent)
+    for (auto* filterNode : {vcfNode.get(), modernVcfNode.get()}) {
+        if (filterNode != nullptr) {
+            audioGraph.removeConnection({{vcoNode->nodeID, 0}, {filterNode->nodeID, 0}});
+            audioGraph.removeConnection({{filterNode->nodeID, 0}, {vcaNode->nodeID, 0}});
+        }
     }
-    // 4. Set graph's main bus layout and prepare
-    audioGraph.setPlayConfigDetails(getMainBusNumInputChannels(), getMainBusNumOutputChannels(),
-                                    sampleRate, samplesPerBlock);
-    audioGraph.prepareToPlay(sampleRate, samplesPerBlock);
 
-    // Set initial LFO routing
-    parameterChanged(ParameterIds::lfoTarget,
-                     apvts.getRawParameterValue(ParameterIds::lfoTarget)->load());
+    const auto& activeNode = filterType == 0 ? vcfNode : modernVcfNode;
+    audioGraph.addConnection({{vcoNode->nodeID, 0}, {activeNode->nodeID, 0}});
+    audioGraph.addConnection({{activeNode->nodeID, 0}, {vcaNode->nodeID, 0}});
 }
 
-// Apply pending graph changes on the audio thread
+// Connects the LFO to the VCO or to the modulation input of the active filter
+void CS01AudioProcessor::applyLfoRouting(int lfoTarget) {
+    for (auto* filterNode : {vcfNode.get(), modernVcfNode.get()}) {
+        if (filterNode != nullptr)
+            audioGraph.removeConnection({{lfoNode->nodeID, 0}, {filterNode->nodeID, 2}});
+    }
+    audioGraph.removeConnection({{lfoNode->nodeID, 0}, {vcoNode->nodeID, 0}});
+
+    // The active filter was added by applyFilterRouting; if the request has moved on since,
+    // the next graph change routes the LFO
+    const auto& activeNode = requestedFilterType.load() == 0 ? vcfNode : modernVcfNode;
+
+    if (lfoTarget == 0)
+        audioGraph.addConnection({{lfoNode->nodeID, 0}, {vcoNode->nodeID, 0}});
+    else if (activeNode != nullptr)
+        audioGraph.addConnection({{lfoNode->nodeID, 0}, {activeNode->nodeID, 2}});
+}
+
+// Apply pending graph changes on the message thread. Editing connections makes the
+// graph build a new render sequence, which allocates, so this never runs in
+// processBlock.
 void CS01AudioProcessor::applyPendingGraphChanges() {
-    // Apply filter type change if requested
-    if (pendingFilterTypeChange.exchange(false)) {
-        int newType = requestedFilterType.load();
+    // A switch to white noise from the audio thread waits for its generator (compact)
+    static_cast<VCOProcessor*>(vcoNode->getProcessor())->createPendingNoiseGenerator();
 
-        // If nodes are not ready yet, re-request for next block
-        if (vcoNode == nullptr || vcfNode == nullptr || modernVcfNode == nullptr || vcaNode == nullptr) {
-            requestedFilterType.store(newType);
-            pendingFilterTypeChange.store(true);
-        } else {
-            // Remove existing connections (safe to call even if absent)
-            audioGraph.removeConnection({{vcoNode->nodeID, 0}, {vcfNode->nodeID, 0}});
-            audioGraph.removeConnection({{vcfNode->nodeID, 0}, {vcaNode->nodeID, 0}});
-            audioGraph.removeConnection({{vcoNode->nodeID, 0}, {modernVcfNode->nodeID, 0}});
-            audioGraph.removeConnection({{modernVcfNode->nodeID, 0}, {vcaNode->nodeID, 0}});
-
-            if (newType == 0) {
-                audioGraph.addConnection({{vcoNode->nodeID, 0}, {vcfNode->nodeID, 0}});
-                audioGraph.addConnection({{vcfNode->nodeID, 0}, {vcaNode->nodeID, 0}});
-            } else {
-                audioGraph.addConnection({{vcoNode->nodeID, 0}, {modernVcfNode->nodeID, 0}});
-                audioGraph.addConnection({{modernVcfNode->nodeID, 0}, {vcaNode->nodeID, 0}});
-            }
+    const bool filterTypeChanged = pendingFilterTypeChange.exchange(false);
+    const bool lfoTargetChanged = pendingLfoTargetChange.exchange(false);
 
-            // Notify UI on message thread
-            juce::MessageManager::callAsync([this]() {
-                if (auto* editor = dynamic_cast<CS01AudioProcessorEditor*>(getActiveEditor())) {
-                    editor->filterTypeChanged(getCurrentFilterProcessor());
-                }
-            });
-        }
+    if (filterTypeChanged)
+        applyFilterRouting(requestedFilterType.load());
+
+    // The LFO follows the active filter when it modulates the VCF
+    if (filterTypeChanged || lfoTargetChanged)
+        applyLfoRouting(requestedLfoTarget.load());
+
+    if (filterTypeChanged) {
+        if (auto* editor = dynamic_cast<CS01AudioProcessorEditor*>(getActiveEditor()))
+            editor->filterTypeChanged(getCurrentFilterProcessor());
     }
+}
 
-    // Apply LFO target change if requested
-    if (pendingLfoTargetChange.exchange(false)) {
-        int newTarget = requestedLfoTarget.load();
+void CS01AudioProcessor::timerCallback() {
+    applyPendingGraphChanges();
 
-        if (lfoNode == nullptr || vcfNode == nullptr || modernVcfNode == nullptr || vcoNode == nullptr) {
-            requestedLfoTarget.store(newTarget);
-            pendingLfoTargetChange.store(true);
-        } else {
-            // Disconnect existing LFO connections
-            audioGraph.removeConnection({{lfoNode->nodeID, 0}, {vcfNode->nodeID, 2}});
-            audioGraph.removeConnection({{lfoNode->nodeID, 0}, {modernVcfNode->nodeID, 2}});
-            audioGraph.removeConnection({{lfoNode->nodeID, 0}, {vcoNode->nodeID, 0}});
-
-            if (newTarget == 0) {
-                audioGraph.addConnection({{lfoNode->nodeID, 0}, {vcoNode->nodeID, 0}});
-            } else {
-                int filterType = static_cast<int>(apvts.getRawParameterValue(ParameterIds::filterType)->load());
-                if (filterType == 0) {
-                    audioGraph.addConnection({{lfoNode->nodeID, 0}, {vcfNode->nodeID, 2}});
-                } else {
-                    audioGraph.addConnection({{lfoNode->nodeID, 0}, {modernVcfNode->nodeID, 2}});
-                }
-            }
-        }
+    if (parameterSync.publish()) {
+        if (auto* editor = dynamic_cast<CS01AudioProcessorEditor*>(getActiveEditor()))
+            editor->updateFromParameters();
     }
 }
 
 void CS01AudioProcessor::releaseResources() {
+    isPrepared = false;
     audioGraph.releaseResources();
 }
 
@@ -190,27 +302,353 @@ bool CS01AudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) cons
 
 void CS01AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                       juce::MidiBuffer& midiMessages) {
+    processBlockWithEvents(buffer, midiMessages, nullptr, 0);
+}
+
+void CS01AudioProcessor::processBlockWithEvents(juce::AudioBuffer<float>& buffer,
+                                                juce::MidiBuffer& midiMessages,
+                                                const ParameterEvent* parameterEvents,
+                                                int numParameterEvents) {
+    CS01_REALTIME_SCOPE("CS01AudioProcessor::processBlock");
+    CS01_PROFILE_CONTEXT(dspProfiler);
+    CS01_PROFILE_SCOPE(DspStage::Total, buffer.getNumSamples());
     juce::ScopedNoDenormals noDenormals;
-    // Apply pending graph changes requested from other threads (atomic flags)
-    applyPendingGraphChanges();
-    midiMessageCollector.removeNextBlockOfMessages(midiMessages, buffer.getNumSamples());
-
-    keyboardState.processNextMidiBuffer(midiMessages, 0, buffer.getNumSamples(), true);
-    audioGraph.processBlock(buffer, midiMessages);
-
-    if (auto* editor = dynamic_cast<CS01AudioProcessorEditor*>(getActiveEditor())) {
-        // Forward a copy of the audio buffer to the UI thread to avoid touching UI from the audio thread.
-        juce::Component::SafePointer<CS01AudioProcessorEditor> safeEditor(editor);
-        juce::AudioBuffer<float> uiBuffer(buffer);
-        juce::MessageManager::callAsync([safeEditor, uiBuffer = std::move(uiBuffer)]() mutable {
-            if (auto* ed = safeEditor.getComponent()) {
-                ed->getOscilloscope().pushBuffer(uiBuffer);
-                ed->getAudioVisualiser().pushBuffer(uiBuffer);
+
+    if (quantisedRendering) {
+        // Only the host's MIDI is rendered; live input would not be reproducible
+        keyboardState.processNextMidiBuffer(midiMessages, 0, buffer.getNumSamples(), false);
+        lastBlockSkipped = false;
+        renderQuantised(buffer, midiMessages, parameterEvents, numParameterEvents);
+    } else {
+        midiMessageCollector.removeNextBlockOfMessages(midiMessages, buffer.getNumSamples());
+        keyboardState.processNextMidiBuffer(midiMessages, 0, buffer.getNumSamples(), true);
+
+        // Nothing to play and nothing left ringing: the graph would only render silence. It
+        // still runs while the spectrum view is open, whose filter curve follows the graph
+        const auto* shownState = activeEditorState.load(std::memory_order_acquire);
+        lastBlockSkipped = isIdle() && midiMessages.isEmpty() && numParameterEvents == 0 &&
+                           !programRamp.isActive() &&
+                           (shownState == nullptr || !shownState->spectrumAnalyser.isEnabled());
+
+        if (lastBlockSkipped)
+            buffer.clear();
+        else
+            renderSegments(buffer, midiMessages, parameterEvents, numParameterEvents);
+    }
+
+    updateIdleState(buffer.getNumSamples());
+
+    // Cheap enough to run unconditionally once the taps exist; the editor only reads
+    // finished snapshots. The taps are independent of each other, so they may run on the
+    // host's workers
+    if (activeEditorState.load(std::memory_order_acquire) == nullptr)
+        return;
+
+    analysisSamples = buffer.getReadPointer(0);
+    numAnalysisSamples = buffer.getNumSamples();
+
+    taskDispatcher.add(
+        [](void* context) noexcept {
+            auto& self = *static_cast<CS01AudioProcessor*>(context);
+            self.editorState->scopeCapture.process(self.analysisSamples, self.numAnalysisSamples);
+        },
+        this);
+    taskDispatcher.add(
+        [](void* context) noexcept {
+            auto& self = *static_cast<CS01AudioProcessor*>(context);
+            self.editorState->spectrumAnalyser.pushSamples(self.analysisSamples,
+                                                           self.numAnalysisSamples);
+        },
+        this);
+    taskDispatcher.add(
+        [](void* context) noexcept {
+            auto& self = *static_cast<CS01AudioProcessor*>(context);
+            self.editorState->outputTap.push(self.analysisSamples, self.numAnalysisSamples);
+        },
+        this);
+    taskDispatcher.run();
+}
+
+double CS01AudioProcessor::getTailLengthSeconds() const {
+    return egNode->getProcessor()->getTailLengthSeconds() + getDecaySeconds();
+}
+
+// After the voice stops, the filter still rings and the VCA's output coupling settles.
+// Either filter may be carrying the sound, so the slower one counts
+double CS01AudioProcessor::getDecaySeconds() const {
+    double filterDecay = 0.0;
+    for (auto* node : {vcfNode.get(), modernVcfNode.get()})
+        if (node != nullptr)
+            filterDecay = juce::jmax(filterDecay, node->getProcessor()->getTailLengthSeconds());
+
+    return filterDecay + vcaNode->getProcessor()->getTailLengthSeconds();
+}
+
+// The voice is sounding while the EG runs or the generator plays (the VCA passes it with
+// less than full EG depth); after that, the tail is counted down on the host timeline
+void CS01AudioProcessor::updateIdleState(int numSamples) {
+    auto* vcoProcessor = static_cast<VCOProcessor*>(vcoNode->getProcessor());
+    auto* generator = vcoProcessor->getSoundGenerator();
+
+    if (static_cast<EGProcessor*>(egNode->getProcessor())->isActive() ||
+        (generator != nullptr && generator->isActive())) {
+        voiceActive = true;
+    } else if (voiceActive) {
+        voiceActive = false;
+        tailSamplesRemaining = juce::roundToInt(getDecaySeconds() * hostSampleRate);
+    } else {
+        tailSamplesRemaining = juce::jmax(0, tailSamplesRemaining - numSamples);
+    }
+}
+
+// Message thread. The state is never destroyed before the processor, so once published the
+// audio thread can keep using it
+CS01AudioProcessor::EditorState& CS01AudioProcessor::getEditorState() {
+    if (editorState == nullptr) {
+        editorState = std::make_unique<EditorState>();
+        editorState->scopeCapture.prepare(hostSampleRate);
+        editorState->spectrumAnalyser.prepare(hostSampleRate);
+        activeEditorState.store(editorState.get(), std::memory_order_release);
+    }
+
+    return *editorState;
+}
+
+// Render the block in segments so that program changes and parameter events take effect
+// at their exact sample position and parameter ramps advance smoothly.
+void CS01AudioProcessor::renderSegments(juce::AudioBuffer<float>& buffer,
+                                        juce::MidiBuffer& midiMessages,
+                                        const ParameterEvent* parameterEvents,
+                                        int numParameterEvents) {
+    const int numSamples = buffer.getNumSamples();
+    int start = 0;
+    int nextParameterEvent = 0;
+
+    while (start < numSamples) {
+        while (nextParameterEvent < numParameterEvents &&
+               parameterEvents[nextParameterEvent].samplePosition <= start)
+            applyParameterEvent(parameterEvents[nextParameterEvent++]);
+
+        int end = numSamples;
+
+        if (nextParameterEvent < numParameterEvents)
+            end = juce::jmin(end, parameterEvents[nextParameterEvent].samplePosition);
+
+        // Hosts may exceed the announced block size; split so the engine buffers suffice
+        if (useInternalRate)
+            end = juce::jmin(end, start + maximumHostBlockSize);
+
+        if (programRamp.isActive())
+            end = juce::jmin(end, start + PROGRAM_RAMP_STEP);
+
+        // Stop just before the next program change so it starts a new segment. In
+        // deterministic mode every event does, so notes start at their exact sample.
+        for (auto it = midiMessages.findNextSamplePosition(start + 1); it != midiMessages.cend();
+             ++it) {
+            const auto metadata = *it;
+            if (metadata.samplePosition >= end)
+                break;
+
+            const bool isProgramChange =
+                metadata.numBytes > 0 && (metadata.data[0] & 0xf0) == 0xc0;
+            if (quantisedRendering || isProgramChange) {
+                end = metadata.samplePosition;
+                break;
             }
-        });
+        }
+
+        if (start == 0 && end == numSamples) {
+            processEngineBlock(buffer, midiMessages);
+        } else {
+            juce::AudioBuffer<float> segment(buffer.getArrayOfWritePointers(),
+                                             buffer.getNumChannels(), start, end - start);
+
+            chunkMidi.clear();
+            chunkMidi.addEvents(midiMessages, start, end - start, -start);
+            processEngineBlock(segment, chunkMidi);
+        }
+
+        programRamp.advance(end - start);
+        start = end;
+    }
+
+    // Events past the end of the block still count
+    while (nextParameterEvent < numParameterEvents)
+        applyParameterEvent(parameterEvents[nextParameterEvent++]);
+}
+
+void CS01AudioProcessor::applyParameterEvent(const ParameterEvent& event) noexcept {
+    if (event.parameter == nullptr)
+        return;
+
+    if (event.isModulation) {
+        if (auto* modulatable = dynamic_cast<ModulatableParameter*>(event.parameter))
+            modulatable->setModulation(event.value);
+    } else {
+        // The host already has the value; echoing it back would record it as a user edit
+        parameterSync.setValue(*event.parameter, event.value, ParameterSync::Notify::Editor);
+    }
+}
+
+// Deterministic mode: the graph runs on RENDER_QUANTUM-sample blocks of a fixed timeline.
+// Events are collected into the quantum they fall in, and each quantum is rendered once
+// it is complete, so the host sees the output one quantum late whatever its block size.
+void CS01AudioProcessor::renderQuantised(juce::AudioBuffer<float>& buffer,
+                                         const juce::MidiBuffer& midiMessages,
+                                         const ParameterEvent* parameterEvents,
+                                         int numParameterEvents) {
+    const int numSamples = buffer.getNumSamples();
+    int position = 0;
+
+    while (position < numSamples) {
+        const int numToCopy = juce::jmin(numSamples - position, RENDER_QUANTUM - quantumPosition);
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            buffer.copyFrom(channel, position, quantumBuffer,
+                            juce::jmin(channel, quantumBuffer.getNumChannels() - 1),
+                            quantumPosition, numToCopy);
+
+        collectQuantumEvents(midiMessages, parameterEvents, numParameterEvents, position,
+                             numToCopy, quantumPosition - position);
+
+        position += numToCopy;
+        quantumPosition += numToCopy;
+
+        if (quantumPosition == RENDER_QUANTUM) {
+            quantumBuffer.clear();
+            renderSegments(quantumBuffer, quantumMidi, quantumParameterEvents.data(),
+                           static_cast<int>(quantumParameterEvents.size()));
+            quantumMidi.clear();
+            quantumParameterEvents.clear();
+            quantumPosition = 0;
+        }
+    }
+}
+
+// Events at the same sample are applied in a fixed order regardless of how the host
+// sorted them: parameter events, then controllers, pitch bend and program changes, then
+// note-offs, then note-ons
+void CS01AudioProcessor::collectQuantumEvents(const juce::MidiBuffer& midiMessages,
+                                              const ParameterEvent* parameterEvents,
+                                              int numParameterEvents, int startSample,
+                                              int numSamples, int offset) {
+    for (int i = 0; i < numParameterEvents; ++i) {
+        auto event = parameterEvents[i];
+        if (event.samplePosition < startSample || event.samplePosition >= startSample + numSamples)
+            continue;
+
+        // Capacity is reserved in prepareToPlay
+        if (quantumParameterEvents.size() < quantumParameterEvents.capacity()) {
+            event.samplePosition += offset;
+            quantumParameterEvents.push_back(event);
+        }
+    }
+
+    const auto getOrder = [](const juce::MidiMessageMetadata& metadata) {
+        if (metadata.numBytes < 3)
+            return 0;
+
+        const auto status = metadata.data[0] & 0xf0;
+        if (status == 0x80 || (status == 0x90 && metadata.data[2] == 0))
+            return 1;
+        return status == 0x90 ? 2 : 0;
+    };
+
+    // addEvent keeps events at equal positions in insertion order
+    for (int order = 0; order < 3; ++order) {
+        for (auto it = midiMessages.findNextSamplePosition(startSample);
+             it != midiMessages.cend(); ++it) {
+            const auto metadata = *it;
+            if (metadata.samplePosition >= startSample + numSamples)
+                break;
+
+            if (getOrder(metadata) == order)
+                quantumMidi.addEvent(metadata.data, metadata.numBytes,
+                                     metadata.samplePosition + offset);
+        }
+    }
+}
+
+// Called from MidiProcessor on the audio thread. Everything but a filter type change takes
+// effect at the event; rewiring the graph allocates, so a new filter type is applied by
+// the timer, up to GRAPH_CHANGE_POLL_MS later
+void CS01AudioProcessor::handleMidiProgramChange(int programIndex) {
+    if (presetManager.copyRealtimeSnapshot(programIndex, programChangeTarget.data(),
+                                           programChangeTarget.size())) {
+        programRamp.start(programChangeTarget.data());
+        presetManager.setCurrentProgramIndex(programIndex);
     }
 }
 
+void CS01AudioProcessor::processEngineBlock(juce::AudioBuffer<float>& buffer,
+                                            juce::MidiBuffer& midiMessages) {
+    if (!useInternalRate) {
+        audioGraph.processBlock(buffer, midiMessages);
+        return;
+    }
+
+    const int numSamples = buffer.getNumSamples();
+    const int numEngineSamples = resampler.getNumInputSamplesRequired(numSamples);
+
+    // Map event positions onto the engine timeline
+    const double ratio = engineSampleRate / hostSampleRate;
+    engineMidi.clear();
+
+    for (const auto metadata : midiMessages) {
+        const int position = juce::jlimit(
+            0, juce::jmax(0, numEngineSamples - 1),
+            static_cast<int>(metadata.samplePosition * ratio));
+        engineMidi.addEvent(metadata.data, metadata.numBytes, position);
+    }
+
+    juce::AudioBuffer<float> engineBlock(engineBuffer.getArrayOfWritePointers(),
+                                         engineBuffer.getNumChannels(), numEngineSamples);
+
+    if (numEngineSamples > 0) {
+        engineBlock.clear();
+        audioGraph.processBlock(engineBlock, engineMidi);
+    }
+
+    // The engine is mono; resample once and duplicate to the remaining channels
+    {
+        CS01_PROFILE_SCOPE(DspStage::Resampler, numSamples);
+        resampler.process(engineBlock.getReadPointer(0), numEngineSamples,
+                          buffer.getWritePointer(0), numSamples);
+    }
+
+    for (int channel = 1; channel < buffer.getNumChannels(); ++channel)
+        buffer.copyFrom(channel, 0, buffer, 0, 0, numSamples);
+}
+
+void CS01AudioProcessor::setDeterministic(bool shouldBeDeterministic, juce::int64 noiseSeedToUse) {
+    deterministic = shouldBeDeterministic;
+    noiseSeed = noiseSeedToUse;
+}
+
+double CS01AudioProcessor::getRequestedEngineSampleRate(double sampleRate) const {
+    switch (static_cast<int>(apvts.getRawParameterValue(ParameterIds::processingRate)->load())) {
+        case 1:
+            return ENGINE_RATE_48K;
+        case 2:
+            return ENGINE_RATE_96K;
+        default:
+            return sampleRate;
+    }
+}
+
+// Re-prepare on the message thread after the engine rate has been changed
+void CS01AudioProcessor::handleAsyncUpdate() {
+    if (!isPrepared)
+        return;
+
+    if (std::abs(getRequestedEngineSampleRate(hostSampleRate) - engineSampleRate) < 1.0e-6)
+        return;
+
+    suspendProcessing(true);
+    prepareToPlay(hostSampleRate, maximumHostBlockSize);
+    suspendProcessing(false);
+}
+
 //==============================================================================
 //==============================================================================
 int CS01AudioProcessor::getNumPrograms() {
@@ -262,7 +700,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout CS01AudioProcessor::createPa
         std::make_unique<juce::AudioParameterFloat>(
             ParameterIds::pwmSpeed, "PWM Speed",
             juce::NormalisableRange<float>(0.0f, 60.0f, 0.01f, 0.25f), 2.0f),
-        std::make_unique<juce::AudioParameterFloat>(
+        std::make_unique<ModulatableParameter>(
             ParameterIds::pitch, "Pitch", juce::NormalisableRange<float>(-1.0f, 1.0f, 0.001f),
             0.0f),
         std::make_unique<juce::AudioParameterFloat>(
@@ -274,7 +712,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout CS01AudioProcessor::createPa
 
     auto vcfGroup = std::make_unique<juce::AudioProcessorParameterGroup>(
         "vcf", "VCF", "|",
-        std::make_unique<juce::AudioParameterFloat>(
+        std::make_unique<ModulatableParameter>(
             ParameterIds::cutoff, "Cutoff",
             juce::NormalisableRange<float>(20.0f, 20000.0f, 1.0f, 0.3f), 20000.0f),
         std::make_unique<juce::AudioParameterFloat>(
@@ -341,13 +779,18 @@ juce::AudioProcessorValueTreeState::ParameterLayout CS01AudioProcessor::createPa
 
     auto globalGroup = std::make_unique<juce::AudioProcessorParameterGroup>(
         "global", "Global", "|",
-        std::make_unique<juce::AudioParameterFloat>(
+        std::make_unique<ModulatableParameter>(
             ParameterIds::volume, "Volume", juce::NormalisableRange<float>(0.0f, 1.0f), 0.7f),
         std::make_unique<juce::AudioParameterFloat>(ParameterIds::breathInput, "Breath Input",
                                                     juce::NormalisableRange<float>(0.0f, 1.0f),
                                                     0.0f),
         std::make_unique<juce::AudioParameterChoice>(ParameterIds::filterType, "Filter Type",
-                                                     juce::StringArray{"Original", "Modern"}, 0));
+                                                     juce::StringArray{"Original", "Modern"}, 0),
+        // Engine mode: run the synth chain at a fixed internal rate independent of the host
+        std::make_unique<juce::AudioParameterChoice>(
+            ParameterIds::processingRate, "Processing Rate",
+            juce::StringArray{"Host", "48 kHz", "96 kHz"}, 0,
+            juce::AudioParameterChoiceAttributes().withAutomatable(false)));
     layout.add(std::move(globalGroup));
 
     return layout;
@@ -436,17 +879,25 @@ void CS01AudioProcessor::parameterChanged(const juce::String& parameterID, float
         return;
     }
 
-    if (parameterID == ParameterIds::lfoTarget) {
-        // Record request and apply on audio thread
-        requestedLfoTarget.store(static_cast<int>(newValue));
-        pendingLfoTargetChange.store(true);
+    if (parameterID == ParameterIds::lfoTarget || parameterID == ParameterIds::filterType) {
+        if (parameterID == ParameterIds::lfoTarget) {
+            requestedLfoTarget.store(static_cast<int>(newValue));
+            pendingLfoTargetChange.store(true);
+        } else {
+            requestedFilterType.store(static_cast<int>(newValue));
+            pendingFilterTypeChange.store(true);
+        }
+
+        // UI and state restores apply at once; automation from the audio thread
+        // is picked up by the timer
+        if (juce::MessageManager::existsAndIsCurrentThread())
+            applyPendingGraphChanges();
         return;
     }
 
-    if (parameterID == ParameterIds::filterType) {
-        // Record request and apply on audio thread
-        requestedFilterType.store(static_cast<int>(newValue));
-        pendingFilterTypeChange.store(true);
+    if (parameterID == ParameterIds::processingRate) {
+        // Changing the engine rate needs a full re-prepare
+        triggerAsyncUpdate();
         return;
     }
 }
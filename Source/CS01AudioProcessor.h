@@ -11,16 +11,42 @@
 #include "CS01Synth/VCAProcessor.h"
 #include "CS01Synth/OriginalVCFProcessor.h"
 #include "CS01Synth/ModernVCFProcessor.h"
+#include "CS01Synth/PolyphaseResampler.h"
+#include "CS01Synth/ParameterRamp.h"
+#include "CS01Synth/ParameterSync.h"
+#include "CS01Synth/TriggeredScopeCapture.h"
+#include "CS01Synth/SpectrumAnalyser.h"
+#include "CS01Synth/DspProfiler.h"
+#include "CS01Synth/OutputTap.h"
+#include "CS01Synth/RealtimeScope.h"
+#include "CS01Synth/TaskDispatcher.h"
+#include "ModulatableParameter.h"
+
+// Set by CMakeLists.txt (option CS01_COMPACT_INSTANCES)
+#ifndef CS01_COMPACT_INSTANCES
+#define CS01_COMPACT_INSTANCES 1
+#endif
 
 class CS01AudioProcessor : public juce::AudioProcessor,
-                           public juce::AudioProcessorValueTreeState::Listener {
+#if CS01_CLAP_DIRECT_PROCESS
+                           public clap_juce_extensions::clap_juce_audio_processor_capabilities,
+#endif
+                           public juce::AudioProcessorValueTreeState::Listener,
+                           private juce::AsyncUpdater,
+                           private juce::Timer {
    public:
     // Get current filter processor
     IFilter* getCurrentFilterProcessor();
     //==============================================================================
-    CS01AudioProcessor();
+    // Compact instances create the noise generator, the filter that is not selected and the
+    // editor-only analysis state (scope, spectrum, output tap) the first time they are needed
+    explicit CS01AudioProcessor(bool compactInstance = CS01_COMPACT_INSTANCES != 0);
     ~CS01AudioProcessor() override;
 
+    bool isCompactInstance() const {
+        return compact;
+    }
+
     //==============================================================================
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
@@ -29,6 +55,30 @@ class CS01AudioProcessor : public juce::AudioProcessor,
 
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
+    // A parameter change at a sample position within the block: a new normalised value, or
+    // a normalised modulation offset for a ModulatableParameter
+    struct ParameterEvent {
+        int samplePosition = 0;
+        juce::RangedAudioParameter* parameter = nullptr;
+        float value = 0.0f;
+        bool isModulation = false;
+    };
+    static constexpr int MAX_PARAMETER_EVENTS = 1024;  // Per block; later ones are dropped
+
+    // processBlock with sample-accurate parameter events (sorted by position); the block is
+    // split at each event, so it takes effect at its exact sample without changing the
+    // block size the host runs at
+    void processBlockWithEvents(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages,
+                                const ParameterEvent* parameterEvents, int numParameterEvents);
+
+#if CS01_CLAP_DIRECT_PROCESS
+    // CLAP: note and parameter events are taken straight from the host's event list
+    bool supportsDirectProcess() override {
+        return true;
+    }
+    clap_process_status clap_direct_process(const clap_process* process) noexcept override;
+#endif
+
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override;
@@ -46,9 +96,8 @@ class CS01AudioProcessor : public juce::AudioProcessor,
     bool isMidiEffect() const override {
         return false;
     }
-    double getTailLengthSeconds() const override {
-        return 0.0;
-    }
+    // Release time plus the ring-down of the filters and the VCA, for the current settings
+    double getTailLengthSeconds() const override;
 
     //==============================================================================
     int getNumPrograms() override;
@@ -69,6 +118,63 @@ class CS01AudioProcessor : public juce::AudioProcessor,
     void parameterChanged(const juce::String& parameterID, float newValue) override;
     void processorLayoutsChanged() override;
 
+    // Rate the VCO/VCF/VCA chain runs at (equals the host rate in Host mode)
+    double getEngineSampleRate() const {
+        return engineSampleRate;
+    }
+
+    // True once the last note has ended and its tail has died away. The output stays silent
+    // until the next event, so processBlock skips the graph until then
+    bool isIdle() const {
+        return !voiceActive && tailSamplesRemaining == 0;
+    }
+
+    // The analysis state below is created on first access in compact instances, so these
+    // are for the message thread only
+
+    // Zero-crossing triggered capture of the output for the oscilloscope
+    TriggeredScopeCapture& getScopeCapture() {
+        return getEditorState().scopeCapture;
+    }
+
+    // FFT analysis of the output; idle until the editor enables it
+    SpectrumAnalyser& getSpectrumAnalyser() {
+        return getEditorState().spectrumAnalyser;
+    }
+
+    // Raw output for the waveform display; idle until the editor enables it
+    OutputTap& getOutputTap() {
+        return getEditorState().outputTap;
+    }
+
+    bool hasEditorState() const {
+        return editorState != nullptr;
+    }
+
+    // Deterministic rendering for offline jobs: noise is seeded, events at the same sample
+    // are applied in a fixed order at their exact position, and the graph always runs on
+    // RENDER_QUANTUM-sample blocks, so the output is bit-identical for the same input at
+    // any host block size. Costs RENDER_QUANTUM samples of latency, and live input (the
+    // on-screen keyboard) is ignored. Takes effect at the next prepareToPlay.
+    static constexpr int RENDER_QUANTUM = 32;
+    void setDeterministic(bool shouldBeDeterministic, juce::int64 noiseSeedToUse = 0);
+    bool isDeterministic() const {
+        return deterministic;
+    }
+
+    // Worker threads offered by the host (e.g. a CLAP thread pool) for the independent
+    // per-block work; without one, that work runs serially in processBlock
+    void setTaskExecutor(TaskDispatcher::Executor* executor) {
+        taskDispatcher.setExecutor(executor);
+    }
+
+#if CS01_ENABLE_PROFILING
+    // Per-stage DSP timings (only in profiling builds)
+    DspProfiler& getDspProfiler() {
+        return dspProfiler;
+    }
+#endif
+
    public:
     juce::AudioProcessorValueTreeState& getValueTreeState() {
         return apvts;
@@ -86,7 +192,32 @@ class CS01AudioProcessor : public juce::AudioProcessor,
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     void updateVCAOutputConnections();
     void handleGeneratorTypeChanged();
+    void buildGraph();
+    void addFilterNode(int filterType);
+    void applyFilterRouting(int filterType);
+    void applyLfoRouting(int lfoTarget);
     void applyPendingGraphChanges();
+    void handleAsyncUpdate() override;
+    void timerCallback() override;
+
+    double getRequestedEngineSampleRate(double sampleRate) const;
+    void processEngineBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages);
+    void renderSegments(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages,
+                        const ParameterEvent* parameterEvents, int numParameterEvents);
+    void renderQuantised(juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midiMessages,
+                         const ParameterEvent* parameterEvents, int numParameterEvents);
+    void collectQuantumEvents(const juce::MidiBuffer& midiMessages,
+                              const ParameterEvent* parameterEvents, int numParameterEvents,
+                              int startSample, int numSamples, int offset);
+    void applyParameterEvent(const ParameterEvent& event) noexcept;
+    double getDecaySeconds() const;
+    void updateIdleState(int numSamples);
+    void handleMidiProgramChange(int programIndex);
+
+    const bool compact;
+
+    // Parameter changes made on the audio thread, published from the timer
+    ParameterSync parameterSync;
 
     juce::MidiKeyboardState keyboardState;
     juce::MidiMessageCollector midiMessageCollector;
@@ -104,11 +235,80 @@ class CS01AudioProcessor : public juce::AudioProcessor,
     // プログラム管理
     ProgramManager presetManager;
 
-    // Pending graph change flags (thread-safe)
+    // Graph changes requested from other threads (e.g. automation on the audio
+    // thread), applied on the message thread
+    static constexpr int GRAPH_CHANGE_POLL_MS = 30;
     std::atomic<bool> pendingFilterTypeChange{false};
     std::atomic<int> requestedFilterType{0};
     std::atomic<bool> pendingLfoTargetChange{false};
     std::atomic<int> requestedLfoTarget{0};
 
+    // Fixed internal rate engine mode
+    static constexpr double ENGINE_RATE_48K = 48000.0;
+    static constexpr double ENGINE_RATE_96K = 96000.0;
+    bool isPrepared = false;
+    bool useInternalRate = false;
+    double hostSampleRate = 44100.0;
+    double engineSampleRate = 44100.0;
+    int maximumHostBlockSize = 0;
+    PolyphaseResampler resampler;
+    juce::AudioBuffer<float> engineBuffer;
+    juce::MidiBuffer engineMidi;
+    juce::MidiBuffer chunkMidi;
+
+    // Deterministic mode (fixed render quantum, one quantum behind the host)
+    bool deterministic = false;
+    juce::int64 noiseSeed = 0;
+    bool quantisedRendering = false;
+    int quantumPosition = 0;
+    juce::AudioBuffer<float> quantumBuffer;
+    juce::MidiBuffer quantumMidi;
+    std::vector<ParameterEvent> quantumParameterEvents;
+
+    // Host-rate samples left for the filters and the VCA to ring down after the voice (EG
+    // and sound generator) stopped; lastBlockSkipped is set when the graph did not run
+    bool voiceActive = false;
+    int tailSamplesRemaining = 0;
+    bool lastBlockSkipped = false;
+
+    // MIDI Program Change: pre-decoded target values applied with a short ramp
+    static constexpr double PROGRAM_RAMP_SECONDS = 0.01;
+    static constexpr int PROGRAM_RAMP_STEP = 32;  // Samples between ramp updates
+    ParameterRamp programRamp;
+    std::vector<float> programChangeTarget;
+
+    // Only the editor reads these. Published to the audio thread once they exist
+    struct EditorState {
+        TriggeredScopeCapture scopeCapture;
+        SpectrumAnalyser spectrumAnalyser;
+        OutputTap outputTap;
+    };
+    EditorState& getEditorState();
+    std::unique_ptr<EditorState> editorState;
+    std::atomic<EditorState*> activeEditorState{nullptr};
+
+    // Audio thread: the editor is showing the output, so blocks keep coming even when idle
+    bool isEditorTapEnabled() const noexcept {
+        const auto* shownState = activeEditorState.load(std::memory_order_acquire);
+        return shownState != nullptr &&
+               (shownState->spectrumAnalyser.isEnabled() || shownState->outputTap.isEnabled());
+    }
+
+    // The analysis taps only read the finished output, so they run as one task batch
+    TaskDispatcher taskDispatcher;
+    const float* analysisSamples = nullptr;
+    int numAnalysisSamples = 0;
+
+#if CS01_ENABLE_PROFILING
+    DspProfiler dspProfiler;
+#endif
+
+#if CS01_CLAP_DIRECT_PROCESS
+    // CLAP parameter ids are derived from the JUCE parameter IDs; see CS01AudioProcessorClap.cpp
+    std::map<juce::uint32, juce::RangedAudioParameter*> clapParameters;
+    juce::MidiBuffer clapMidi;
+    std::vector<ParameterEvent> clapParameterEvents;
+#endif
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CS01AudioProcessor)
 };
@@ -0,0 +1,107 @@
+#include "CS01AudioProcessor.h"
+
+#if CS01_CLAP_DIRECT_PROCESS
+
+// Direct CLAP processing: instead of JUCE's block-quantised parameter model, note and
+// parameter events are read from the host's timestamped event list and rendered through
+// processBlockWithEvents, which splits the block at every parameter event. Parameter
+// modulation goes to ModulatableParameter as an offset and never rewrites the value.
+clap_process_status CS01AudioProcessor::clap_direct_process(const clap_process* process) noexcept {
+    if (process->audio_outputs_count == 0 || process->audio_outputs[0].data32 == nullptr)
+        return CLAP_PROCESS_CONTINUE;
+
+    const auto& output = process->audio_outputs[0];
+    const int numSamples = static_cast<int>(process->frames_count);
+    juce::AudioBuffer<float> buffer(output.data32, static_cast<int>(output.channel_count),
+                                    numSamples);
+
+    // The wrapper's own process() holds the callback lock and checks for suspension, which
+    // handleAsyncUpdate relies on while it prepares the graph again. Never wait for the lock
+    const juce::ScopedTryLock callbackLock(getCallbackLock());
+    if (!callbackLock.isLocked() || isSuspended()) {
+        buffer.clear();
+        process->audio_outputs[0].constant_mask = ~juce::uint64(0);
+        return CLAP_PROCESS_CONTINUE;
+    }
+
+    clapMidi.clear();
+    clapParameterEvents.clear();
+
+    const auto addParameterEvent = [this](clap_id id, int position, double value,
+                                          bool isModulation) {
+        const auto parameter = clapParameters.find(id);
+        if (parameter != clapParameters.end() &&
+            clapParameterEvents.size() < clapParameterEvents.capacity())
+            clapParameterEvents.push_back(
+                {position, parameter->second, static_cast<float>(value), isModulation});
+    };
+
+    const auto* events = process->in_events;
+    const auto numEvents = events->size(events);
+
+    for (juce::uint32 i = 0; i < numEvents; ++i) {
+        const auto* header = events->get(events, i);
+        if (header == nullptr || header->space_id != CLAP_CORE_EVENT_SPACE_ID)
+            continue;
+
+        const int position = juce::jlimit(0, juce::jmax(0, numSamples - 1),
+                                          static_cast<int>(header->time));
+
+        switch (header->type) {
+            case CLAP_EVENT_NOTE_ON:
+            case CLAP_EVENT_NOTE_OFF:
+            case CLAP_EVENT_NOTE_CHOKE: {
+                const auto* note = reinterpret_cast<const clap_event_note*>(header);
+                if (note->key < 0 || note->key > 127)
+                    break;  // Wildcard notes have nothing to start or stop on a mono synth
+
+                const int channel = juce::jlimit(1, 16, note->channel + 1);
+                const auto velocity = static_cast<float>(note->velocity);
+
+                if (header->type == CLAP_EVENT_NOTE_ON)
+                    clapMidi.addEvent(juce::MidiMessage::noteOn(channel, note->key, velocity),
+                                      position);
+                else
+                    clapMidi.addEvent(juce::MidiMessage::noteOff(channel, note->key, velocity),
+                                      position);
+                break;
+            }
+
+            case CLAP_EVENT_MIDI: {
+                const auto* midi = reinterpret_cast<const clap_event_midi*>(header);
+                const int numBytes =
+                    juce::MidiMessage::getMessageLengthFromFirstByte(midi->data[0]);
+                clapMidi.addEvent(midi->data, juce::jmin(3, numBytes), position);
+                break;
+            }
+
+            // The wrapper exposes parameters normalised to 0..1, so values and modulation
+            // amounts are normalised as well
+            case CLAP_EVENT_PARAM_VALUE: {
+                const auto* change = reinterpret_cast<const clap_event_param_value*>(header);
+                addParameterEvent(change->param_id, position, change->value, false);
+                break;
+            }
+
+            case CLAP_EVENT_PARAM_MOD: {
+                const auto* modulation = reinterpret_cast<const clap_event_param_mod*>(header);
+                addParameterEvent(modulation->param_id, position, modulation->amount, true);
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    processBlockWithEvents(buffer, clapMidi, clapParameterEvents.data(),
+                           static_cast<int>(clapParameterEvents.size()));
+
+    // A skipped block is all zeros, and once idle the host may stop calling until the next
+    // event arrives. Not while the editor shows the output, which would freeze on the
+    // last block
+    process->audio_outputs[0].constant_mask = lastBlockSkipped ? ~juce::uint64(0) : 0;
+    return isIdle() && !isEditorTapEnabled() ? CLAP_PROCESS_SLEEP : CLAP_PROCESS_CONTINUE;
+}
+
+#endif
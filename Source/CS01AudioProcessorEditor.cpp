@@ -10,10 +10,13 @@ using namespace juce;
 CS01AudioProcessorEditor::CS01AudioProcessorEditor(CS01AudioProcessor& p)
     : AudioProcessorEditor(&p),
       audioProcessor(p),
+      refreshScheduler(*this),
       midiKeyboard(p.getKeyboardState(),
                    juce::MidiKeyboardComponent::Orientation::horizontalKeyboard),
       oscilloscopeComponent(p.getTotalNumOutputChannels()),
-      audioVisualiser(p.getTotalNumOutputChannels()) {
+      audioVisualiser(p.getTotalNumOutputChannels()),
+      spectrumAnalyserComponent(p.getSpectrumAnalyser(),
+                                [this] { return audioProcessor.getCurrentFilterProcessor(); }) {
     lookAndFeel = std::make_unique<CS01LookAndFeel>();
     setLookAndFeel(lookAndFeel.get());
 
@@ -23,11 +26,14 @@ CS01AudioProcessorEditor::CS01AudioProcessorEditor(CS01AudioProcessor& p)
 
     // Initialize oscilloscope component
     oscilloscopeComponent.setBufferSize(512);
+    oscilloscopeComponent.setTriggerSource(&p.getScopeCapture());
+    p.getOutputTap().setEnabled(true);
 
     // Create and make all components visible
     addAndMakeVisible(midiKeyboard);
     addAndMakeVisible(audioVisualiser);
     addAndMakeVisible(oscilloscopeComponent);
+    addAndMakeVisible(spectrumAnalyserComponent);
     modulationComponent.reset(new ModulationComponent(audioProcessor));
     addAndMakeVisible(modulationComponent.get());
     vcoComponent.reset(new VCOComponent(audioProcessor.getValueTreeState()));
@@ -51,6 +57,19 @@ CS01AudioProcessorEditor::CS01AudioProcessorEditor(CS01AudioProcessor& p)
     filterTypeComponent.reset(new FilterTypeComponent(audioProcessor.getValueTreeState()));
     addAndMakeVisible(filterTypeComponent.get());
 
+    refreshScheduler.addClient(oscilloscopeComponent);
+    refreshScheduler.addClient(spectrumAnalyserComponent);
+    refreshScheduler.addClient(*modulationComponent);
+    refreshScheduler.addClient(*vcoComponent);
+    refreshScheduler.addClient(*programPanel);
+    refreshScheduler.addClient(*this);
+
+#if CS01_ENABLE_PROFILING
+    dspLoadOverlay = std::make_unique<DspLoadOverlay>(audioProcessor.getDspProfiler());
+    addAndMakeVisible(dspLoadOverlay.get());
+    refreshScheduler.addClient(*dspLoadOverlay);
+#endif
+
     // Define layout structure in the constructor
     upperFlex.flexDirection = juce::FlexBox::Direction::row;
     upperFlex.items.add(juce::FlexItem(*modulationComponent).withFlex(4));
@@ -65,6 +84,7 @@ CS01AudioProcessorEditor::CS01AudioProcessorEditor(CS01AudioProcessor& p)
     visualizerFlex.flexDirection = juce::FlexBox::Direction::column;
     visualizerFlex.items.add(juce::FlexItem(oscilloscopeComponent).withFlex(1));
     visualizerFlex.items.add(juce::FlexItem(audioVisualiser).withFlex(1));
+    visualizerFlex.items.add(juce::FlexItem(spectrumAnalyserComponent).withFlex(1));
 
     // Add waveform display FlexBox to the upper FlexBox
     upperFlex.items.add(juce::FlexItem(visualizerFlex).withFlex(4));
@@ -85,6 +105,7 @@ CS01AudioProcessorEditor::CS01AudioProcessorEditor(CS01AudioProcessor& p)
 }
 
 CS01AudioProcessorEditor::~CS01AudioProcessorEditor() {
+    audioProcessor.getOutputTap().setEnabled(false);
     setLookAndFeel(nullptr);
 }
 
@@ -95,9 +116,42 @@ void CS01AudioProcessorEditor::paint(juce::Graphics& g) {
 
 void CS01AudioProcessorEditor::resized() {
     mainFlex.performLayout(getLocalBounds().reduced(10));
+
+#if CS01_ENABLE_PROFILING
+    // Over the top right corner of the scope
+    const auto scopeBounds = oscilloscopeComponent.getBounds();
+    dspLoadOverlay->setBounds(scopeBounds.getRight() - 170, scopeBounds.getY(), 170,
+                              dspLoadOverlay->getIdealHeight());
+    dspLoadOverlay->toFront(false);
+#endif
+}
+
+void CS01AudioProcessorEditor::refresh() {
+    const int numSamples =
+        audioProcessor.getOutputTap().pull(tapSamples.data(), static_cast<int>(tapSamples.size()));
+    if (numSamples == 0)
+        return;
+
+    // The engine is mono; every channel of the display shows the same signal
+    const float* channels[] = {tapSamples.data(), tapSamples.data()};
+    audioVisualiser.pushBuffer(channels,
+                               juce::jmin(2, audioProcessor.getTotalNumOutputChannels()),
+                               numSamples);
 }
 
 // Called when filter type changes
+void CS01AudioProcessorEditor::updateFromParameters() {
+    modulationComponent->updateFromParameters();
+    vcoComponent->updateFromParameters();
+    lfoComponent->updateFromParameters();
+    vcfComponent->updateFromParameters();
+    vcaComponent->updateFromParameters();
+    egComponent->updateFromParameters();
+    breathControlComponent->updateFromParameters();
+    volumeComponent->updateFromParameters();
+    filterTypeComponent->updateFromParameters();
+}
+
 void CS01AudioProcessorEditor::filterTypeChanged(IFilter* newFilterProcessor) {
     // Get resonance control type from IFilterProcessor
     if (newFilterProcessor != nullptr && vcfComponent != nullptr) {
@@ -15,12 +15,17 @@ class IFilter;
 #include "UI/ProgramPanel.h"
 #include "UI/FilterTypeComponent.h"
 #include "UI/OscilloscopeComponent.h"
+#include "UI/SpectrumAnalyserComponent.h"
+#include "UI/UIRefreshScheduler.h"
+#include "UI/DspLoadOverlay.h"
+#include "CS01Synth/OutputTap.h"
 
 // Forward declarations
 class CS01LookAndFeel;
 
 //==============================================================================
-class CS01AudioProcessorEditor : public juce::AudioProcessorEditor {
+class CS01AudioProcessorEditor : public juce::AudioProcessorEditor,
+                                 private UIRefreshScheduler::Client {
    public:
     CS01AudioProcessorEditor(CS01AudioProcessor&);
     ~CS01AudioProcessorEditor() override;
@@ -31,16 +36,19 @@ class CS01AudioProcessorEditor : public juce::AudioProcessorEditor {
     // フィルタータイプが変更されたときに呼び出される
     void filterTypeChanged(IFilter* newFilterProcessor);
 
-    OscilloscopeComponent& getOscilloscope() {
-        return oscilloscopeComponent;
-    }
-    juce::AudioVisualiserComponent& getAudioVisualiser() {
-        return audioVisualiser;
-    }
+    // Re-reads every control's parameter, for values set without notifying the parameter's
+    // listeners (host automation applied on the audio thread)
+    void updateFromParameters();
 
    private:
+    // Moves the output collected by the processor's tap into the waveform display
+    void refresh() override;
+
     CS01AudioProcessor& audioProcessor;
 
+    // One display-synced tick drives every component that shows changing state
+    UIRefreshScheduler refreshScheduler;
+
     juce::MidiKeyboardComponent midiKeyboard;
 
     std::unique_ptr<ModulationComponent> modulationComponent;
@@ -56,11 +64,17 @@ class CS01AudioProcessorEditor : public juce::AudioProcessorEditor {
     std::unique_ptr<CS01LookAndFeel> lookAndFeel;
     OscilloscopeComponent oscilloscopeComponent;
     juce::AudioVisualiserComponent audioVisualiser;
+    SpectrumAnalyserComponent spectrumAnalyserComponent;
+    std::array<float, OutputTap::CAPACITY> tapSamples{};
 
     juce::FlexBox upperFlex;
     juce::FlexBox lowerFlex;
     juce::FlexBox mainFlex;
     juce::FlexBox visualizerFlex;  // FlexBox for waveform display
 
+#if CS01_ENABLE_PROFILING
+    std::unique_ptr<DspLoadOverlay> dspLoadOverlay;
+#endif
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CS01AudioProcessorEditor)
 };
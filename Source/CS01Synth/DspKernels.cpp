@@ -0,0 +1,354 @@
+#include "DspKernels.h"
+
+#if JUCE_INTEL
+#include <immintrin.h>
+#define CS01_KERNELS_SSE2 1
+#define CS01_KERNELS_AVX2 1
+#elif JUCE_ARM && (defined(__aarch64__) || defined(_M_ARM64))
+#include <arm_neon.h>
+#define CS01_KERNELS_NEON 1
+#endif
+
+// GCC and Clang compile each x86 variant for its own instruction set, so the rest of the
+// binary keeps the baseline; MSVC accepts the intrinsics without it. FMA is left out on
+// purpose, so products and sums round exactly as in the scalar forms.
+#if defined(__GNUC__) || defined(__clang__)
+#define CS01_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CS01_TARGET(isa)
+#endif
+
+namespace {
+//==============================================================================
+namespace scalar {
+void pitchToPhaseIncrement(float* values, int numSamples, float referenceIncrement) {
+    for (int i = 0; i < numSamples; ++i)
+        values[i] = DspKernels::getPhaseIncrement(values[i], referenceIncrement);
+}
+
+void applyVCAGain(float* samples, const float* eg, int numSamples, float egDepth,
+                  float breathGain, float volumeGain) {
+    for (int i = 0; i < numSamples; ++i)
+        samples[i] = DspKernels::getVCAOutput(samples[i], eg[i], egDepth, breathGain, volumeGain);
+}
+
+void dotProductPair(const float* x, const float* c0, const float* c1, int numTaps,
+                    float* sums) {
+    float sum0 = 0.0f;
+    float sum1 = 0.0f;
+
+    for (int k = 0; k < numTaps; ++k) {
+        sum0 += x[k] * c0[k];
+        sum1 += x[k] * c1[k];
+    }
+
+    sums[0] = sum0;
+    sums[1] = sum1;
+}
+}  // namespace scalar
+
+//==============================================================================
+#if CS01_KERNELS_SSE2
+namespace sse2 {
+CS01_TARGET("sse2")
+__m128 fastExp2(__m128 x) {
+    // Truncate, then step down where that rounded up (negative x): floor
+    __m128i whole = _mm_cvttps_epi32(x);
+    const __m128 roundedUp = _mm_cmplt_ps(x, _mm_cvtepi32_ps(whole));
+    whole = _mm_add_epi32(whole, _mm_castps_si128(roundedUp));  // All ones is -1
+
+    const __m128 f = _mm_sub_ps(x, _mm_cvtepi32_ps(whole));
+    __m128 fraction = _mm_add_ps(_mm_set1_ps(DspKernels::EXP2_C4),
+                                 _mm_mul_ps(f, _mm_set1_ps(DspKernels::EXP2_C5)));
+    fraction = _mm_add_ps(_mm_set1_ps(DspKernels::EXP2_C3), _mm_mul_ps(f, fraction));
+    fraction = _mm_add_ps(_mm_set1_ps(DspKernels::EXP2_C2), _mm_mul_ps(f, fraction));
+    fraction = _mm_add_ps(_mm_set1_ps(DspKernels::EXP2_C1), _mm_mul_ps(f, fraction));
+    fraction = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(f, fraction));
+
+    return _mm_castsi128_ps(
+        _mm_add_epi32(_mm_castps_si128(fraction), _mm_slli_epi32(whole, 23)));
+}
+
+CS01_TARGET("sse2")
+void pitchToPhaseIncrement(float* values, int numSamples, float referenceIncrement) {
+    const __m128 reference = _mm_set1_ps(referenceIncrement);
+    const __m128 a4 = _mm_set1_ps(69.0f);
+    const __m128 perSemitone = _mm_set1_ps(1.0f / 12.0f);
+
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        const __m128 octaves = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(values + i), a4), perSemitone);
+        _mm_storeu_ps(values + i, _mm_mul_ps(reference, fastExp2(octaves)));
+    }
+
+    scalar::pitchToPhaseIncrement(values + i, numSamples - i, referenceIncrement);
+}
+
+CS01_TARGET("sse2")
+void applyVCAGain(float* samples, const float* eg, int numSamples, float egDepth,
+                  float breathGain, float volumeGain) {
+    const __m128 offset = _mm_set1_ps(1.0f - egDepth);
+    const __m128 depth = _mm_set1_ps(egDepth);
+    const __m128 breath = _mm_set1_ps(breathGain);
+    const __m128 volume = _mm_set1_ps(volumeGain);
+    const __m128 threshold = _mm_set1_ps(DspKernels::VCA_SATURATION_THRESHOLD);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        __m128 controlVoltage = _mm_add_ps(offset, _mm_mul_ps(_mm_loadu_ps(eg + i), depth));
+        controlVoltage = _mm_mul_ps(controlVoltage, breath);
+
+        const __m128 output =
+            _mm_mul_ps(_mm_loadu_ps(samples + i), _mm_mul_ps(controlVoltage, volume));
+        const __m128 magnitude = _mm_andnot_ps(signBit, output);
+        const __m128 excess = _mm_sub_ps(magnitude, threshold);
+        const __m128 saturated = _mm_add_ps(
+            threshold,
+            _mm_div_ps(excess, _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(excess, _mm_set1_ps(0.5f)))));
+
+        // The sign of the output on the saturated magnitude, where it is above the threshold
+        const __m128 isSaturated = _mm_cmpgt_ps(magnitude, threshold);
+        const __m128 signedSaturated = _mm_or_ps(saturated, _mm_and_ps(output, signBit));
+        _mm_storeu_ps(samples + i, _mm_or_ps(_mm_and_ps(isSaturated, signedSaturated),
+                                             _mm_andnot_ps(isSaturated, output)));
+    }
+
+    scalar::applyVCAGain(samples + i, eg + i, numSamples - i, egDepth, breathGain, volumeGain);
+}
+
+CS01_TARGET("sse2")
+float horizontalSum(__m128 v) {
+    const __m128 pairs = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+}
+
+CS01_TARGET("sse2")
+void dotProductPair(const float* x, const float* c0, const float* c1, int numTaps,
+                    float* sums) {
+    __m128 sum0 = _mm_setzero_ps();
+    __m128 sum1 = _mm_setzero_ps();
+
+    int k = 0;
+    for (; k + 4 <= numTaps; k += 4) {
+        const __m128 input = _mm_loadu_ps(x + k);
+        sum0 = _mm_add_ps(sum0, _mm_mul_ps(input, _mm_loadu_ps(c0 + k)));
+        sum1 = _mm_add_ps(sum1, _mm_mul_ps(input, _mm_loadu_ps(c1 + k)));
+    }
+
+    scalar::dotProductPair(x + k, c0 + k, c1 + k, numTaps - k, sums);
+    sums[0] += horizontalSum(sum0);
+    sums[1] += horizontalSum(sum1);
+}
+}  // namespace sse2
+#endif
+
+//==============================================================================
+#if CS01_KERNELS_AVX2
+namespace avx2 {
+CS01_TARGET("avx2")
+__m256 fastExp2(__m256 x) {
+    __m256i whole = _mm256_cvttps_epi32(x);
+    const __m256 roundedUp = _mm256_cmp_ps(x, _mm256_cvtepi32_ps(whole), _CMP_LT_OQ);
+    whole = _mm256_add_epi32(whole, _mm256_castps_si256(roundedUp));
+
+    const __m256 f = _mm256_sub_ps(x, _mm256_cvtepi32_ps(whole));
+    __m256 fraction = _mm256_add_ps(_mm256_set1_ps(DspKernels::EXP2_C4),
+                                    _mm256_mul_ps(f, _mm256_set1_ps(DspKernels::EXP2_C5)));
+    fraction = _mm256_add_ps(_mm256_set1_ps(DspKernels::EXP2_C3), _mm256_mul_ps(f, fraction));
+    fraction = _mm256_add_ps(_mm256_set1_ps(DspKernels::EXP2_C2), _mm256_mul_ps(f, fraction));
+    fraction = _mm256_add_ps(_mm256_set1_ps(DspKernels::EXP2_C1), _mm256_mul_ps(f, fraction));
+    fraction = _mm256_add_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(f, fraction));
+
+    return _mm256_castsi256_ps(
+        _mm256_add_epi32(_mm256_castps_si256(fraction), _mm256_slli_epi32(whole, 23)));
+}
+
+CS01_TARGET("avx2")
+void pitchToPhaseIncrement(float* values, int numSamples, float referenceIncrement) {
+    const __m256 reference = _mm256_set1_ps(referenceIncrement);
+    const __m256 a4 = _mm256_set1_ps(69.0f);
+    const __m256 perSemitone = _mm256_set1_ps(1.0f / 12.0f);
+
+    int i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        const __m256 octaves =
+            _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(values + i), a4), perSemitone);
+        _mm256_storeu_ps(values + i, _mm256_mul_ps(reference, fastExp2(octaves)));
+    }
+
+    sse2::pitchToPhaseIncrement(values + i, numSamples - i, referenceIncrement);
+}
+
+CS01_TARGET("avx2")
+void applyVCAGain(float* samples, const float* eg, int numSamples, float egDepth,
+                  float breathGain, float volumeGain) {
+    const __m256 offset = _mm256_set1_ps(1.0f - egDepth);
+    const __m256 depth = _mm256_set1_ps(egDepth);
+    const __m256 breath = _mm256_set1_ps(breathGain);
+    const __m256 volume = _mm256_set1_ps(volumeGain);
+    const __m256 threshold = _mm256_set1_ps(DspKernels::VCA_SATURATION_THRESHOLD);
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+
+    int i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        __m256 controlVoltage =
+            _mm256_add_ps(offset, _mm256_mul_ps(_mm256_loadu_ps(eg + i), depth));
+        controlVoltage = _mm256_mul_ps(controlVoltage, breath);
+
+        const __m256 output =
+            _mm256_mul_ps(_mm256_loadu_ps(samples + i), _mm256_mul_ps(controlVoltage, volume));
+        const __m256 magnitude = _mm256_andnot_ps(signBit, output);
+        const __m256 excess = _mm256_sub_ps(magnitude, threshold);
+        const __m256 saturated = _mm256_add_ps(
+            threshold, _mm256_div_ps(excess, _mm256_add_ps(_mm256_set1_ps(1.0f),
+                                                           _mm256_mul_ps(excess, _mm256_set1_ps(0.5f)))));
+
+        const __m256 isSaturated = _mm256_cmp_ps(magnitude, threshold, _CMP_GT_OQ);
+        const __m256 signedSaturated = _mm256_or_ps(saturated, _mm256_and_ps(output, signBit));
+        _mm256_storeu_ps(samples + i, _mm256_blendv_ps(output, signedSaturated, isSaturated));
+    }
+
+    sse2::applyVCAGain(samples + i, eg + i, numSamples - i, egDepth, breathGain, volumeGain);
+}
+
+CS01_TARGET("avx2")
+void dotProductPair(const float* x, const float* c0, const float* c1, int numTaps,
+                    float* sums) {
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+
+    int k = 0;
+    for (; k + 8 <= numTaps; k += 8) {
+        const __m256 input = _mm256_loadu_ps(x + k);
+        sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(input, _mm256_loadu_ps(c0 + k)));
+        sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(input, _mm256_loadu_ps(c1 + k)));
+    }
+
+    sse2::dotProductPair(x + k, c0 + k, c1 + k, numTaps - k, sums);
+    sums[0] += sse2::horizontalSum(
+        _mm_add_ps(_mm256_castps256_ps128(sum0), _mm256_extractf128_ps(sum0, 1)));
+    sums[1] += sse2::horizontalSum(
+        _mm_add_ps(_mm256_castps256_ps128(sum1), _mm256_extractf128_ps(sum1, 1)));
+}
+}  // namespace avx2
+#endif
+
+//==============================================================================
+#if CS01_KERNELS_NEON
+namespace neon {
+float32x4_t fastExp2(float32x4_t x) {
+    int32x4_t whole = vcvtq_s32_f32(x);  // Truncates
+    const uint32x4_t roundedUp = vcltq_f32(x, vcvtq_f32_s32(whole));
+    whole = vaddq_s32(whole, vreinterpretq_s32_u32(roundedUp));
+
+    const float32x4_t f = vsubq_f32(x, vcvtq_f32_s32(whole));
+    float32x4_t fraction =
+        vaddq_f32(vdupq_n_f32(DspKernels::EXP2_C4), vmulq_n_f32(f, DspKernels::EXP2_C5));
+    fraction = vaddq_f32(vdupq_n_f32(DspKernels::EXP2_C3), vmulq_f32(f, fraction));
+    fraction = vaddq_f32(vdupq_n_f32(DspKernels::EXP2_C2), vmulq_f32(f, fraction));
+    fraction = vaddq_f32(vdupq_n_f32(DspKernels::EXP2_C1), vmulq_f32(f, fraction));
+    fraction = vaddq_f32(vdupq_n_f32(1.0f), vmulq_f32(f, fraction));
+
+    return vreinterpretq_f32_s32(
+        vaddq_s32(vreinterpretq_s32_f32(fraction), vshlq_n_s32(whole, 23)));
+}
+
+void pitchToPhaseIncrement(float* values, int numSamples, float referenceIncrement) {
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        const float32x4_t octaves =
+            vmulq_n_f32(vsubq_f32(vld1q_f32(values + i), vdupq_n_f32(69.0f)), 1.0f / 12.0f);
+        vst1q_f32(values + i, vmulq_n_f32(fastExp2(octaves), referenceIncrement));
+    }
+
+    scalar::pitchToPhaseIncrement(values + i, numSamples - i, referenceIncrement);
+}
+
+void applyVCAGain(float* samples, const float* eg, int numSamples, float egDepth,
+                  float breathGain, float volumeGain) {
+    const float32x4_t offset = vdupq_n_f32(1.0f - egDepth);
+    const float32x4_t threshold = vdupq_n_f32(DspKernels::VCA_SATURATION_THRESHOLD);
+
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        float32x4_t controlVoltage = vaddq_f32(offset, vmulq_n_f32(vld1q_f32(eg + i), egDepth));
+        controlVoltage = vmulq_n_f32(controlVoltage, breathGain);
+
+        const float32x4_t output =
+            vmulq_f32(vld1q_f32(samples + i), vmulq_n_f32(controlVoltage, volumeGain));
+        const float32x4_t magnitude = vabsq_f32(output);
+        const float32x4_t excess = vsubq_f32(magnitude, threshold);
+        const float32x4_t saturated = vaddq_f32(
+            threshold, vdivq_f32(excess, vaddq_f32(vdupq_n_f32(1.0f), vmulq_n_f32(excess, 0.5f))));
+
+        // Copy the sign of the output onto the saturated magnitude where it is over
+        const uint32x4_t isSaturated = vcgtq_f32(magnitude, threshold);
+        const float32x4_t signedSaturated =
+            vbslq_f32(vdupq_n_u32(0x80000000u), output, saturated);
+        vst1q_f32(samples + i, vbslq_f32(isSaturated, signedSaturated, output));
+    }
+
+    scalar::applyVCAGain(samples + i, eg + i, numSamples - i, egDepth, breathGain, volumeGain);
+}
+
+void dotProductPair(const float* x, const float* c0, const float* c1, int numTaps,
+                    float* sums) {
+    float32x4_t sum0 = vdupq_n_f32(0.0f);
+    float32x4_t sum1 = vdupq_n_f32(0.0f);
+
+    int k = 0;
+    for (; k + 4 <= numTaps; k += 4) {
+        const float32x4_t input = vld1q_f32(x + k);
+        sum0 = vaddq_f32(sum0, vmulq_f32(input, vld1q_f32(c0 + k)));
+        sum1 = vaddq_f32(sum1, vmulq_f32(input, vld1q_f32(c1 + k)));
+    }
+
+    scalar::dotProductPair(x + k, c0 + k, c1 + k, numTaps - k, sums);
+    sums[0] += vaddvq_f32(sum0);
+    sums[1] += vaddvq_f32(sum1);
+}
+}  // namespace neon
+#endif
+
+//==============================================================================
+const DspKernels scalarKernels{scalar::pitchToPhaseIncrement, scalar::applyVCAGain,
+                               scalar::dotProductPair, DspKernels::InstructionSet::Scalar,
+                               "Scalar"};
+#if CS01_KERNELS_SSE2
+const DspKernels sse2Kernels{sse2::pitchToPhaseIncrement, sse2::applyVCAGain,
+                             sse2::dotProductPair, DspKernels::InstructionSet::SSE2, "SSE2"};
+#endif
+#if CS01_KERNELS_AVX2
+const DspKernels avx2Kernels{avx2::pitchToPhaseIncrement, avx2::applyVCAGain,
+                             avx2::dotProductPair, DspKernels::InstructionSet::AVX2, "AVX2"};
+#endif
+#if CS01_KERNELS_NEON
+const DspKernels neonKernels{neon::pitchToPhaseIncrement, neon::applyVCAGain,
+                             neon::dotProductPair, DspKernels::InstructionSet::NEON, "NEON"};
+#endif
+}  // namespace
+
+std::vector<const DspKernels*> DspKernels::getSupported() {
+    std::vector<const DspKernels*> supported{&scalarKernels};
+
+#if CS01_KERNELS_SSE2
+    if (juce::SystemStats::hasSSE2())
+        supported.push_back(&sse2Kernels);
+#endif
+#if CS01_KERNELS_AVX2
+    // The AVX2 variants finish blocks with the SSE2 ones
+    if (juce::SystemStats::hasSSE2() && juce::SystemStats::hasAVX2())
+        supported.push_back(&avx2Kernels);
+#endif
+#if CS01_KERNELS_NEON
+    supported.push_back(&neonKernels);
+#endif
+
+    return supported;
+}
+
+const DspKernels& DspKernels::get() {
+    static const DspKernels& selected = *getSupported().back();
+    return selected;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <bit>
+#include <vector>
+
+//==============================================================================
+// Element-wise routines of the audio path, with a variant per instruction set: scalar,
+// SSE2, AVX2 and NEON. The best variant this CPU runs is chosen once, from CPUID on x86
+// and at compile time on ARM (NEON is part of AArch64), so one binary uses the widest
+// vectors available on every machine. Hold the reference from get() as a member so the
+// choice is made on the message thread, never in processBlock.
+//
+// Vector variants perform the same operations in the same order as the scalar forms below,
+// lane by lane; only the dot products are summed in a different order.
+class DspKernels {
+   public:
+    enum class InstructionSet { Scalar, SSE2, AVX2, NEON };
+
+    // MIDI pitches (semitones) to phase increments (cycles per sample), in place
+    void (*pitchToPhaseIncrement)(float* values, int numSamples, float referenceIncrement);
+
+    // IG02600 VCA: gain from the EG control voltage, then soft saturation, in place
+    void (*applyVCAGain)(float* samples, const float* eg, int numSamples, float egDepth,
+                         float breathGain, float volumeGain);
+
+    // Two polyphase branches against the same input: sums[0] = x.c0, sums[1] = x.c1
+    void (*dotProductPair)(const float* x, const float* c0, const float* c1, int numTaps,
+                           float* sums);
+
+    InstructionSet instructionSet;
+    const char* name;
+
+    // The variant selected for this CPU
+    static const DspKernels& get();
+
+    // Every variant this CPU can run, scalar first; for tests and benchmarks
+    static std::vector<const DspKernels*> getSupported();
+
+    //==============================================================================
+    // 2^x as 2^floor(x) times a polynomial of the fraction, with an error below 0.002 cents
+    static float fastExp2(float x) noexcept {
+        auto whole = static_cast<juce::int32>(x);
+        whole -= x < static_cast<float>(whole) ? 1 : 0;  // floor
+        const float f = x - static_cast<float>(whole);
+        const float fraction =
+            1.0f + f * (EXP2_C1 + f * (EXP2_C2 + f * (EXP2_C3 + f * (EXP2_C4 + f * EXP2_C5))));
+        return std::bit_cast<float>(std::bit_cast<juce::int32>(fraction) + whole * (1 << 23));
+    }
+
+    static float getPhaseIncrement(float pitch, float referenceIncrement) noexcept {
+        return referenceIncrement * fastExp2((pitch - 69.0f) * (1.0f / 12.0f));
+    }
+
+    // The VCA gain is the control voltage times the volume curve; above 0.7 the output
+    // saturates softly
+    static float getVCAOutput(float input, float eg, float egDepth, float breathGain,
+                              float volumeGain) noexcept {
+        float controlVoltage = (1.0f - egDepth) + (eg * egDepth);
+        controlVoltage *= breathGain;
+
+        float output = input * (controlVoltage * volumeGain);
+
+        if (std::abs(output) > VCA_SATURATION_THRESHOLD) {
+            const float sign = (output > 0.0f) ? 1.0f : -1.0f;
+            const float excess = std::abs(output) - VCA_SATURATION_THRESHOLD;
+            output = sign * (VCA_SATURATION_THRESHOLD + excess / (1.0f + excess * 0.5f));
+        }
+
+        return output;
+    }
+
+    static constexpr float EXP2_C1 = 6.931513629e-01f;
+    static constexpr float EXP2_C2 = 2.401641535e-01f;
+    static constexpr float EXP2_C3 = 5.580044718e-02f;
+    static constexpr float EXP2_C4 = 9.016687522e-03f;
+    static constexpr float EXP2_C5 = 1.867182894e-03f;
+    static constexpr float VCA_SATURATION_THRESHOLD = 0.7f;
+};
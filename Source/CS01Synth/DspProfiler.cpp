@@ -0,0 +1,148 @@
+#include "DspProfiler.h"
+
+thread_local DspProfiler* DspProfiler::current = nullptr;
+
+namespace {
+// Resolved once at startup so the audio thread never hits a guarded static
+const double nanosecondsPerTick =
+    1.0e9 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+}  // namespace
+
+void DspProfiler::record(DspStage stage, juce::int64 nanoseconds, int numSamples) noexcept {
+    auto& data = stages[static_cast<size_t>(stage)];
+    const auto duration = static_cast<juce::uint64>(juce::jmax<juce::int64>(0, nanoseconds));
+
+    data.numBlocks.fetch_add(1, std::memory_order_relaxed);
+    data.numSamples.fetch_add(static_cast<juce::uint64>(numSamples), std::memory_order_relaxed);
+    data.totalNanoseconds.fetch_add(duration, std::memory_order_relaxed);
+    data.buckets[static_cast<size_t>(getBucketIndex(nanoseconds))].fetch_add(
+        1, std::memory_order_relaxed);
+
+    // Single writer per stage in practice, but stay correct if that changes
+    auto previousMax = data.maxNanoseconds.load(std::memory_order_relaxed);
+    while (duration > previousMax &&
+           !data.maxNanoseconds.compare_exchange_weak(previousMax, duration,
+                                                      std::memory_order_relaxed)) {
+    }
+}
+
+DspProfiler::Statistics DspProfiler::getStatistics(DspStage stage) const noexcept {
+    const auto& data = stages[static_cast<size_t>(stage)];
+
+    Statistics statistics;
+    statistics.numBlocks = data.numBlocks.load(std::memory_order_relaxed);
+    if (statistics.numBlocks == 0)
+        return statistics;
+
+    const double totalMicroseconds =
+        static_cast<double>(data.totalNanoseconds.load(std::memory_order_relaxed)) / 1000.0;
+    statistics.meanMicroseconds = totalMicroseconds / static_cast<double>(statistics.numBlocks);
+    statistics.maxMicroseconds =
+        static_cast<double>(data.maxNanoseconds.load(std::memory_order_relaxed)) / 1000.0;
+
+    // Percentiles from the histogram; counts may be mid-update, so use their own total
+    std::array<juce::uint32, NUM_BUCKETS> counts;
+    juce::uint64 histogramTotal = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] = data.buckets[i].load(std::memory_order_relaxed);
+        histogramTotal += counts[i];
+    }
+
+    const auto percentile = [&](double fraction) {
+        const auto target = static_cast<juce::uint64>(std::ceil(fraction * histogramTotal));
+        juce::uint64 accumulated = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            accumulated += counts[i];
+            if (accumulated >= target && accumulated > 0)
+                return juce::jmin(getBucketUpperBound(static_cast<int>(i)) / 1000.0,
+                                  statistics.maxMicroseconds);
+        }
+        return statistics.maxMicroseconds;
+    };
+
+    statistics.medianMicroseconds = percentile(0.5);
+    statistics.p99Microseconds = percentile(0.99);
+
+    // All stages cover the same stretch of audio as the Total stage
+    const auto audioSamples =
+        stages[static_cast<size_t>(DspStage::Total)].numSamples.load(std::memory_order_relaxed);
+    if (audioSamples > 0) {
+        const double audioMicroseconds =
+            static_cast<double>(audioSamples) / sampleRate.load() * 1.0e6;
+        statistics.cpuLoad = totalMicroseconds / audioMicroseconds;
+    }
+
+    return statistics;
+}
+
+void DspProfiler::reset() noexcept {
+    for (auto& data : stages) {
+        data.numBlocks.store(0);
+        data.numSamples.store(0);
+        data.totalNanoseconds.store(0);
+        data.maxNanoseconds.store(0);
+        for (auto& bucket : data.buckets)
+            bucket.store(0);
+    }
+}
+
+juce::String DspProfiler::createReport() const {
+    juce::String report;
+    report << "Stage            blocks    mean us  median us     p99 us     max us    load %\n";
+
+    for (int i = 0; i < NUM_STAGES; ++i) {
+        const auto stage = static_cast<DspStage>(i);
+        const auto statistics = getStatistics(stage);
+        if (statistics.numBlocks == 0)
+            continue;
+
+        report << juce::String(getStageName(stage)).paddedRight(' ', 14)
+               << juce::String(static_cast<juce::int64>(statistics.numBlocks)).paddedLeft(' ', 9)
+               << juce::String(statistics.meanMicroseconds, 2).paddedLeft(' ', 11)
+               << juce::String(statistics.medianMicroseconds, 2).paddedLeft(' ', 11)
+               << juce::String(statistics.p99Microseconds, 2).paddedLeft(' ', 11)
+               << juce::String(statistics.maxMicroseconds, 2).paddedLeft(' ', 11)
+               << juce::String(statistics.cpuLoad * 100.0, 2).paddedLeft(' ', 10) << "\n";
+    }
+
+    return report;
+}
+
+const char* DspProfiler::getStageName(DspStage stage) noexcept {
+    switch (stage) {
+        case DspStage::Total: return "Total";
+        case DspStage::Midi: return "MIDI";
+        case DspStage::VCO: return "VCO";
+        case DspStage::ToneGenerator: return "ToneGenerator";
+        case DspStage::Noise: return "Noise";
+        case DspStage::EG: return "EG";
+        case DspStage::LFO: return "LFO";
+        case DspStage::OriginalVCF: return "VCF (Original)";
+        case DspStage::IG02610Filter: return "IG02610";
+        case DspStage::ModernVCF: return "VCF (Modern)";
+        case DspStage::VCA: return "VCA";
+        case DspStage::Resampler: return "Resampler";
+        case DspStage::NumStages: break;
+    }
+    return "";
+}
+
+int DspProfiler::getBucketIndex(juce::int64 nanoseconds) noexcept {
+    // Four buckets per octave: the top bit selects the octave, the next two the quarter
+    const auto value =
+        static_cast<juce::uint32>(juce::jlimit<juce::int64>(1, 0xffffffff, nanoseconds));
+    const int octave = juce::findHighestSetBit(value);
+    const int quarter = octave >= 2 ? static_cast<int>((value >> (octave - 2)) & 3)
+                                    : static_cast<int>((value << (2 - octave)) & 3);
+    return juce::jmin(NUM_BUCKETS - 1, octave * 4 + quarter);
+}
+
+double DspProfiler::getBucketUpperBound(int bucketIndex) noexcept {
+    const int octave = bucketIndex / 4;
+    const int quarter = bucketIndex % 4;
+    return std::ldexp(1.0 + (quarter + 1) * 0.25, octave);
+}
+
+juce::int64 DspProfiler::ticksToNanoseconds(juce::int64 ticks) noexcept {
+    return static_cast<juce::int64>(static_cast<double>(ticks) * nanosecondsPerTick);
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+// Hot-path instrumentation is only compiled in when CS01_ENABLE_PROFILING is
+// set (CMake option CS01_ENABLE_PROFILING, on by default in Debug builds).
+#ifndef CS01_ENABLE_PROFILING
+#define CS01_ENABLE_PROFILING 0
+#endif
+
+//==============================================================================
+// Stages that can be measured. Stages nest: Total contains the graph nodes,
+// VCO contains ToneGenerator, and so on, so times are inclusive.
+enum class DspStage {
+    Total,
+    Midi,
+    VCO,
+    ToneGenerator,
+    Noise,
+    EG,
+    LFO,
+    OriginalVCF,
+    IG02610Filter,
+    ModernVCF,
+    VCA,
+    Resampler,
+    NumStages
+};
+
+//==============================================================================
+// Per-stage wall-clock time per block, recorded from the audio thread into
+// lock-free log-scale histograms (quarter-octave buckets of nanoseconds).
+// Readers on other threads get a consistent enough view for display without
+// ever blocking the audio thread.
+//
+// Measurements are attributed to the profiler installed for the current
+// thread with ScopedContext, so DSP classes do not need a reference to it.
+class DspProfiler {
+   public:
+    static constexpr int NUM_STAGES = static_cast<int>(DspStage::NumStages);
+    static constexpr int NUM_BUCKETS = 128;
+
+    struct Statistics {
+        juce::uint64 numBlocks = 0;
+        double meanMicroseconds = 0.0;
+        double maxMicroseconds = 0.0;
+        double medianMicroseconds = 0.0;  // Bucket upper bound, within ~19 %
+        double p99Microseconds = 0.0;
+        double cpuLoad = 0.0;  // Share of the real-time budget (1.0 = all of it)
+    };
+
+    DspProfiler() = default;
+    ~DspProfiler() = default;
+
+    // Sample rate the Total stage's samples refer to
+    void prepare(double hostSampleRate) noexcept {
+        sampleRate.store(hostSampleRate);
+    }
+
+    // Audio thread
+    void record(DspStage stage, juce::int64 nanoseconds, int numSamples) noexcept;
+
+    // Any thread
+    Statistics getStatistics(DspStage stage) const noexcept;
+    void reset() noexcept;
+    juce::String createReport() const;
+
+    static const char* getStageName(DspStage stage) noexcept;
+    static int getBucketIndex(juce::int64 nanoseconds) noexcept;
+    static double getBucketUpperBound(int bucketIndex) noexcept;
+
+    //==============================================================================
+    // Installs a profiler for the current thread for the lifetime of the scope
+    class ScopedContext {
+       public:
+        explicit ScopedContext(DspProfiler& profiler) noexcept : previous(current) {
+            current = &profiler;
+        }
+        ~ScopedContext() noexcept {
+            current = previous;
+        }
+
+       private:
+        DspProfiler* previous;
+        JUCE_DECLARE_NON_COPYABLE(ScopedContext)
+    };
+
+    // Times the enclosing scope; does nothing without a profiler on this thread
+    class ScopedMeasurement {
+       public:
+        ScopedMeasurement(DspStage stageToMeasure, int numSamplesInBlock) noexcept
+            : profiler(current), stage(stageToMeasure), numSamples(numSamplesInBlock) {
+            if (profiler != nullptr)
+                startTicks = juce::Time::getHighResolutionTicks();
+        }
+        ~ScopedMeasurement() noexcept {
+            if (profiler != nullptr)
+                profiler->record(stage, ticksToNanoseconds(juce::Time::getHighResolutionTicks() -
+                                                           startTicks),
+                                 numSamples);
+        }
+
+       private:
+        DspProfiler* profiler;
+        DspStage stage;
+        int numSamples;
+        juce::int64 startTicks = 0;
+        JUCE_DECLARE_NON_COPYABLE(ScopedMeasurement)
+    };
+
+    static DspProfiler* getCurrent() noexcept {
+        return current;
+    }
+
+   private:
+    static juce::int64 ticksToNanoseconds(juce::int64 ticks) noexcept;
+
+    struct StageData {
+        std::atomic<juce::uint64> numBlocks{0};
+        std::atomic<juce::uint64> numSamples{0};
+        std::atomic<juce::uint64> totalNanoseconds{0};
+        std::atomic<juce::uint64> maxNanoseconds{0};
+        std::array<std::atomic<juce::uint32>, NUM_BUCKETS> buckets{};
+    };
+
+    std::array<StageData, NUM_STAGES> stages;
+    std::atomic<double> sampleRate{44100.0};
+
+    static thread_local DspProfiler* current;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DspProfiler)
+};
+
+#if CS01_ENABLE_PROFILING
+#define CS01_PROFILE_CONTEXT(profiler) \
+    const DspProfiler::ScopedContext JUCE_JOIN_MACRO(cs01ProfileContext_, __LINE__)(profiler)
+#define CS01_PROFILE_SCOPE(stage, numSamples)                                        \
+    const DspProfiler::ScopedMeasurement JUCE_JOIN_MACRO(cs01ProfileScope_, __LINE__)( \
+        stage, numSamples)
+#else
+#define CS01_PROFILE_CONTEXT(profiler)
+#define CS01_PROFILE_SCOPE(stage, numSamples)
+#endif
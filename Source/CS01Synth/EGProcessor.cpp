@@ -1,4 +1,5 @@
 #include "EGProcessor.h"
+#include "DspProfiler.h"
 
 //==============================================================================
 EGProcessor::EGProcessor(juce::AudioProcessorValueTreeState& apvts)
@@ -11,6 +12,10 @@ EGProcessor::~EGProcessor() {}
 void EGProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
     adsr.setSampleRate(sampleRate);
     updateADSR();
+
+    // Start idle, as a new node would
+    adsr.reset();
+    prevSample = 0.0f;
 }
 
 void EGProcessor::releaseResources() {}
@@ -26,6 +31,7 @@ bool EGProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
 }
 
 void EGProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
+    CS01_PROFILE_SCOPE(DspStage::EG, buffer.getNumSamples());
     juce::ScopedNoDenormals noDenormals;
     updateADSR();
 
@@ -52,8 +52,9 @@ class EGProcessor : public juce::AudioProcessor {
     bool isMidiEffect() const override {
         return false;
     }
+    // The envelope ends with its release stage
     double getTailLengthSeconds() const override {
-        return 0.0;
+        return apvts.getRawParameterValue(ParameterIds::release)->load();
     }
 
     //==============================================================================
@@ -0,0 +1,82 @@
+#include "FilterCharacter.h"
+
+namespace {
+// More accurate tanh approximation
+float accurateTanh(float x) {
+    // Use Padé approximation for small values (high accuracy)
+    if (std::abs(x) < 1.0f) {
+        const float x2 = x * x;
+        return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+    } else {
+        // Use improved rational approximation for larger values
+        const float absX = std::abs(x);
+        const float sign = x > 0.0f ? 1.0f : -1.0f;
+        return sign * (1.0f - 1.0f / (1.0f + absX + 0.25f * absX * absX));
+    }
+}
+}  // namespace
+
+namespace FilterCharacter {
+
+float getNotchAmount(float cutoff, float resonance) {
+    // Highpass mix ratio, growing from 0 at 500 Hz to 0.1 as the cutoff decreases
+    if (cutoff < 500.0f && resonance > 0.5f)
+        return (500.0f - cutoff) / 500.0f * 0.1f;
+    return 0.0f;
+}
+
+float saturate(float y, float cutoff, float resonance) {
+    // Stage 1: Subtle even harmonics for low resonance (OTA input stage)
+    float lightDistortion = 0.0f;
+    if (resonance <= 0.4f) {
+        const float lightAmount = resonance / 0.4f;     // 0.0 to 1.0
+        const float evenHarmonics = y * y * y * 0.05f;  // Cubic for even harmonics
+        lightDistortion = evenHarmonics * lightAmount * 0.3f;
+    }
+
+    // Stage 2: Balanced distortion for medium resonance
+    float mediumDistortion = 0.0f;
+    if (resonance > 0.4f && resonance <= 0.7f) {
+        const float medAmount = (resonance - 0.4f) / 0.3f;  // 0.0 to 1.0
+
+        // Frequency-dependent drive (low frequencies get more distortion)
+        const float freqFactor = cutoff < 1000.0f ? 1.2f - (cutoff / 1000.0f) * 0.4f : 0.8f;
+
+        const float drivenSignal = y * (1.0f + medAmount * 0.15f * freqFactor);
+        const float balancedSat = accurateTanh(drivenSignal * 0.4f);
+        mediumDistortion = balancedSat * medAmount * 0.4f;
+    }
+
+    // Stage 3: Strong distortion for high resonance (enhanced from original)
+    float strongDistortion = 0.0f;
+    if (resonance > 0.7f) {
+        const float strongAmount = (resonance - 0.7f) / 0.1f;  // 0.0 to 1.0
+
+        // Input level dependent drive (larger signals get more distortion)
+        const float inputLevel = std::abs(y);
+        const float levelFactor = 1.0f + inputLevel * 0.5f;
+
+        // Frequency-dependent saturation characteristics
+        const float freqSaturation = cutoff < 500.0f ? 1.3f : (cutoff > 5000.0f ? 0.7f : 1.0f);
+
+        const float heavilyDriven = y * levelFactor * (1.0f + strongAmount * 0.25f);
+        const float primarySat = accurateTanh(heavilyDriven * 0.5f * freqSaturation);
+
+        // Add asymmetric clipping for OTA-like behavior
+        const float asymmetric = y > 0.0f ? accurateTanh(y * 1.2f) : accurateTanh(y * 0.8f);
+
+        strongDistortion = (primarySat * 0.7f + asymmetric * 0.3f) * strongAmount * 0.5f;
+    }
+
+    // Combine all distortion stages
+    const float totalDistortion = lightDistortion + mediumDistortion + strongDistortion;
+
+    // Apply distortion with smooth blending
+    const float distortionAmount = resonance * 0.6f;  // Overall distortion scaling
+    y = y * (1.0f - distortionAmount) + totalDistortion * distortionAmount;
+
+    // Final gentle limiting to prevent extreme values
+    return juce::jlimit(-1.5f, 1.5f, y);
+}
+
+}  // namespace FilterCharacter
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// Circuit character shared by the Original filter models, around whichever linear
+// core they use: the coupling capacitors at the input and output, the OTA's
+// level-dependent cutoff, the notch mix at low cutoffs and the resonance-dependent
+// saturation.
+namespace FilterCharacter {
+
+// Input coupling (0.022uF / 22k), a clean DC blocker at 20 Hz
+struct InputStage {
+    juce::dsp::IIR::Filter<float> dcBlocker;
+
+    void prepare(double sampleRate) {
+        dcBlocker.reset();
+        dcBlocker.coefficients =
+            juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, 20.0f);
+    }
+
+    void reset() {
+        dcBlocker.reset();
+    }
+
+    float process(float sample) {
+        return dcBlocker.processSample(sample);
+    }
+};
+
+// Output coupling (0.02uF / 10k), a one-pole DC blocker at about 8 Hz
+struct OutputStage {
+    static constexpr float CUTOFF_HZ = 8.0f;
+
+    float prevInput = 0.0f;
+    float prevOutput = 0.0f;
+    float alpha = 0.99886f;  // 44.1 kHz until prepared
+
+    void prepare(double sampleRate) {
+        alpha = 1.0f / (1.0f + juce::MathConstants<float>::twoPi * CUTOFF_HZ /
+                                   static_cast<float>(sampleRate));
+    }
+
+    // Time for a step to settle to -60 dB
+    static double getDecaySeconds() {
+        return std::log(1000.0) / (juce::MathConstants<double>::twoPi * CUTOFF_HZ);
+    }
+
+    void reset() {
+        prevInput = 0.0f;
+        prevOutput = 0.0f;
+    }
+
+    float process(float sample) {
+        prevOutput = alpha * (prevOutput + sample - prevInput);
+        prevInput = sample;
+        return prevOutput;
+    }
+};
+
+// Envelope follower on the input level. Large signals make the OTA's cutoff slightly
+// higher (brighter), small signals make it lower (darker): returns the relative change
+struct LevelFollower {
+    static constexpr float INPUT_LEVEL_INFLUENCE = 0.02f;  // ±2% cutoff modulation
+    static constexpr float LEVEL_SMOOTHING = 0.99f;        // Envelope follower coefficient
+
+    float levelSmoothed = 0.0f;
+
+    void reset() {
+        levelSmoothed = 0.0f;
+    }
+
+    float process(float sample) {
+        levelSmoothed = levelSmoothed * LEVEL_SMOOTHING + std::abs(sample) * (1.0f - LEVEL_SMOOTHING);
+        return (levelSmoothed - 0.5f) * INPUT_LEVEL_INFLUENCE;
+    }
+};
+
+// Highpass mix ratio for the subtle notch at low cutoffs with high resonance
+float getNotchAmount(float cutoff, float resonance);
+
+// OTA-like distortion across the resonance range, blended into the filter output
+float saturate(float y, float cutoff, float resonance);
+
+}  // namespace FilterCharacter
@@ -18,6 +18,12 @@ class IFilter {
     // Pure virtual function to get resonance mode
     virtual ResonanceMode getResonanceMode() const = 0;
 
+    // Theoretical small-signal gain at the given frequency for the cutoff and
+    // resonance used in the most recent block. Safe to call from the UI thread.
+    virtual float getMagnitudeResponse(double frequencyHz) const {
+        return 1.0f;
+    }
+
     // Other filter-related methods that can be extended in the future
     // virtual FilterType getFilterType() const = 0;
     // virtual int getFilterOrder() const = 0;
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "FilterCharacter.h"
 
 //==============================================================================
-// IG02610 2-pole lowpass filter implementation
+// IG02610 2-pole lowpass filter implementation. An RBJ biquad that is redesigned for
+// every cutoff change.
 class IG02610LPF {
    public:
     IG02610LPF();                   // Default constructor (safe initial values)
@@ -28,67 +30,28 @@ class IG02610LPF {
     void processBlock(float* samples, int numSamples, const float* cutoffModulation,
                       float baseResonance);
 
-   private:
-    float cutoff, resonance, sampleRate;
-    float a1, a2, b0, b1, b2;
-    float z1, z2;
-
-    // Input level tracking for OTA input level dependency characteristic
-    float inputLevelSmoothed = 0.0f;
+    // Linear response of the filter core and notch mix (waveshaping and DC blockers omitted)
+    static float getMagnitudeResponse(float cutoff, float resonance, double sampleRate,
+                                      double frequencyHz);
 
-    // WaveShaper parameters - defined as static constants
-    static constexpr float RESONANCE_DRIVE = 1.2f;
-    static constexpr float RESONANCE_SHAPE = 0.8f;
-    static constexpr float OUTPUT_DRIVE = 1.1f;
+    // Time for the ringing at the cutoff to fall by 60 dB
+    static double getDecaySeconds(float cutoff, float resonance);
 
-    // OTA input level dependency parameters
-    static constexpr float INPUT_LEVEL_INFLUENCE = 0.02f;  // ±2% cutoff modulation
-    static constexpr float LEVEL_SMOOTHING = 0.99f;        // Envelope follower coefficient
-
-    // Input stage model
-    struct InputStage {
-        float prevSample = 0.0f;
-        juce::dsp::IIR::Filter<float> dcBlocker;
-
-        void prepare(double sampleRate) {
-            dcBlocker.reset();
-            dcBlocker.coefficients =
-                juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, 20.0f);
-        }
-
-        void reset() {
-            prevSample = 0.0f;
-            dcBlocker.reset();
-        }
-    };
-
-    // Output stage model
-    struct OutputStage {
-        float prevInput = 0.0f;
-        float prevOutput = 0.0f;
-        double sampleRate = 44100.0;
-
-        void prepare(double newSampleRate) {
-            sampleRate = newSampleRate;
-        }
-
-        void reset() {
-            prevInput = 0.0f;
-            prevOutput = 0.0f;
-        }
+   private:
+    struct Coefficients {
+        float b0, b1, b2, a1, a2;
     };
 
-    InputStage inputStage;
-    OutputStage outputStage;
+    static float getQ(float resonance);
+    static Coefficients calculateCoefficients(float cutoff, float resonance, float sampleRate);
 
-    // More accurate tanh approximation
-    float accurateTanh(float x);
-
-    // Input stage processing
-    float processInputStage(float sample);
+    float cutoff, resonance, sampleRate;
+    float a1, a2, b0, b1, b2;
+    float z1, z2;
 
-    // Output stage processing
-    float processOutputStage(float sample);
+    FilterCharacter::InputStage inputStage;
+    FilterCharacter::OutputStage outputStage;
+    FilterCharacter::LevelFollower levelFollower;
 
     void updateCoefficients();
 };
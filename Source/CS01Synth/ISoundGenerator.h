@@ -27,4 +27,8 @@ class ISoundGenerator {
 
     // LFO modulation - with default implementation
     virtual void setLfoValue(float value) {}
+
+    // Per-sample LFO modulation, lined up with the buffer of the next renderNextBlock call;
+    // nullptr goes back to the value from setLfoValue
+    virtual void setLfoBuffer(const float* values, int numSamples) {}
 };
@@ -1,18 +1,13 @@
 #include "LFOProcessor.h"
+#include "DspProfiler.h"
 
 //==============================================================================
 LFOProcessor::LFOProcessor(juce::AudioProcessorValueTreeState& apvts)
     : AudioProcessor(BusesProperties().withOutput("Output", juce::AudioChannelSet::mono(), true)),
       apvts(apvts),
       lfo() {
-    // Initialize triangle wave (standard implementation based on JUCE tutorial)
-    lfo.initialise(
-        [](float x) -> float {
-            // x is in [0, 1), normalized by the Oscillator class
-            // Standard triangle wave implementation
-            return 1.0f - 4.0f * std::abs(std::round(x - 0.25f) - (x - 0.25f));
-        },
-        128);
+    // Triangle wave from the shared table (standard implementation based on JUCE tutorial)
+    lfo.initialise([&table = sharedTables->lfoTriangle](float x) { return table(x); });
 }
 
 LFOProcessor::~LFOProcessor() {}
@@ -37,6 +32,7 @@ bool LFOProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
 }
 
 void LFOProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
+    CS01_PROFILE_SCOPE(DspStage::LFO, buffer.getNumSamples());
     juce::ScopedNoDenormals noDenormals;
     updateParameters();
 
@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "../Parameters.h"
+#include "SharedTables.h"
 
 //==============================================================================
 class LFOProcessor : public juce::AudioProcessor {
@@ -66,6 +67,7 @@ class LFOProcessor : public juce::AudioProcessor {
     void updateParameters();
 
     juce::AudioProcessorValueTreeState& apvts;
+    juce::SharedResourcePointer<SharedTables> sharedTables;
     juce::dsp::Oscillator<float> lfo;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LFOProcessor)
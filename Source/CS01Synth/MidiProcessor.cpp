@@ -1,4 +1,5 @@
 #include "MidiProcessor.h"
+#include "DspProfiler.h"
 #include "../Parameters.h"
 
 MidiProcessor::MidiProcessor(juce::AudioProcessorValueTreeState& apvts)
@@ -7,10 +8,21 @@ MidiProcessor::MidiProcessor(juce::AudioProcessorValueTreeState& apvts)
 
 MidiProcessor::~MidiProcessor() = default;
 
-void MidiProcessor::prepareToPlay(double, int) {}
+// The node is kept across prepareToPlay calls, so held notes and controller values start over
+void MidiProcessor::prepareToPlay(double, int) {
+    activeNotes.clearQuick();
+    lastPitchWheelValue = 8192;
+
+    modulationMSB = modulationLSB = 0;
+    breathMSB = breathLSB = 0;
+    volumeMSB = volumeLSB = 0;
+    glissandoMSB = glissandoLSB = 0;
+    bankSelectMSB = bankSelectLSB = 0;
+}
 void MidiProcessor::releaseResources() {}
 
 void MidiProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
+    CS01_PROFILE_SCOPE(DspStage::Midi, buffer.getNumSamples());
     // This processor does not process audio, so we must clear the buffer
     // to prevent any leftover data from passing through.
     buffer.clear();
@@ -34,10 +46,21 @@ void MidiProcessor::handleMidiEvent(const juce::MidiMessage& midiMessage, juce::
         handlePitchWheel(midiMessage);
     } else if (midiMessage.isController()) {
         handleControllerMessage(midiMessage);
+    } else if (midiMessage.isProgramChange()) {
+        handleProgramChange(midiMessage);
     }
     // Ignore other MIDI messages
 }
 
+void MidiProcessor::handleProgramChange(const juce::MidiMessage& midiMessage) {
+    // Bank Select (CC #0/#32) extends the program range in steps of 128
+    const int bank = (bankSelectMSB << 7) | bankSelectLSB;
+    const int program = bank * 128 + midiMessage.getProgramChangeNumber();
+
+    if (onProgramChange != nullptr)
+        onProgramChange(program);
+}
+
 void MidiProcessor::handleNoteOn(const juce::MidiMessage& midiMessage) {
     bool wasEmpty = activeNotes.isEmpty();
     activeNotes.addIfNotAlreadyThere(midiMessage.getNoteNumber());
@@ -126,8 +149,15 @@ void MidiProcessor::handleControllerMessage(const juce::MidiMessage& midiMessage
     const int controller = midiMessage.getControllerNumber();
     const int value = midiMessage.getControllerValue();
 
+    // Bank Select is latched until the next Program Change
+    if (controller == 0) {          // CC #0: Bank Select MSB
+        bankSelectMSB = value;
+    }
+    else if (controller == 32) {    // CC #32: Bank Select LSB
+        bankSelectLSB = value;
+    }
     // 14bit CC MSB processing
-    if (controller == 1) {          // CC #1: Modulation MSB
+    else if (controller == 1) {     // CC #1: Modulation MSB
         modulationMSB = value;
         updateModulationParameter();
     }
@@ -74,6 +74,9 @@ class MidiProcessor : public juce::AudioProcessor {
         return activeNotes;
     }
 
+    // Called on the audio thread with the flat program index (bank * 128 + program)
+    std::function<void(int)> onProgramChange;
+
    private:
     // MIDI processing methods
     void handleMidiEvent(const juce::MidiMessage& midiMessage, juce::MidiBuffer&);
@@ -81,6 +84,7 @@ class MidiProcessor : public juce::AudioProcessor {
     void handleNoteOff(const juce::MidiMessage& midiMessage);
     void handlePitchWheel(const juce::MidiMessage& midiMessage);
     void handleControllerMessage(const juce::MidiMessage& midiMessage);
+    void handleProgramChange(const juce::MidiMessage& midiMessage);
 
     // 14bit CC parameter update methods
     void updateModulationParameter();
@@ -101,6 +105,7 @@ class MidiProcessor : public juce::AudioProcessor {
     int breathMSB = 0, breathLSB = 0;             // CC #2/#34  
     int volumeMSB = 0, volumeLSB = 0;             // CC #7/#39
     int glissandoMSB = 0, glissandoLSB = 0;       // CC #35/#37
+    int bankSelectMSB = 0, bankSelectLSB = 0;     // CC #0/#32
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiProcessor)
 };
@@ -1,4 +1,6 @@
 #include "ModernVCFProcessor.h"
+#include "DspProfiler.h"
+#include "../ModulatableParameter.h"
 #include <cmath>
 
 //==============================================================================
@@ -18,6 +20,7 @@ void ModernVCFProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
     filter.reset();
     filter.setType(juce::dsp::StateVariableTPTFilter<float>::Type::lowpass);
     filter.prepare({sampleRate, static_cast<uint32>(samplesPerBlock), 1});  // Always 1 channel (mono)
+    lastSampleRate.store(sampleRate);
 
     // Pre-allocate temporary buffer to avoid reallocations per block
     if (samplesPerBlock > processingBufferCapacity) {
@@ -53,6 +56,7 @@ bool ModernVCFProcessor::isBusesLayoutSupported(const BusesLayout& layouts) cons
 
 void ModernVCFProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                       juce::MidiBuffer& midiMessages) {
+    CS01_PROFILE_SCOPE(DspStage::ModernVCF, buffer.getNumSamples());
     juce::ScopedNoDenormals noDenormals;
 
     auto audioInput = getBusBuffer(buffer, true, 0);
@@ -60,7 +64,7 @@ void ModernVCFProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     auto lfoInput = getBusBuffer(buffer, true, 2);
 
     // Get parameters
-    auto cutoffParam = apvts.getRawParameterValue(ParameterIds::cutoff)->load();
+    auto cutoffParam = ModulatableParameter::getModulatedValue(apvts, ParameterIds::cutoff);
     auto resonanceParam = apvts.getRawParameterValue(ParameterIds::resonance)->load();
     auto egDepth = apvts.getRawParameterValue(ParameterIds::vcfEgDepth)->load();
     auto modDepth = apvts.getRawParameterValue(ParameterIds::modDepth)->load();
@@ -123,6 +127,8 @@ void ModernVCFProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     // Apply averaged filter parameters (per-block)
     filter.setCutoffFrequency(blockCutoffHz);
     filter.setResonance(resonance);
+    lastCutoff.store(blockCutoffHz, std::memory_order_relaxed);
+    lastResonance.store(resonance, std::memory_order_relaxed);
 
     // Process the whole block using JUCE DSP block API (SIMD-friendly)
     {
@@ -135,3 +141,37 @@ void ModernVCFProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     // Copy processed samples back to output efficiently
     buffer.copyFrom(0, 0, processingBuffer, 0, 0, numSamples);
 }
+
+// Once the EG has finished, the filter rings down at the cutoff set by the knob. The
+// envelope follows the slowest pole: omega0 / 2Q when underdamped, and real below Q = 0.5
+double ModernVCFProcessor::getTailLengthSeconds() const {
+    const auto cutoffParam = ModulatableParameter::getModulatedValue(apvts, ParameterIds::cutoff);
+    const auto resonanceParam = apvts.getRawParameterValue(ParameterIds::resonance)->load();
+    const double cutoff = calculateCutoffFrequency(cutoffParam);
+    const double damping = 1.0 / calculateResonance(resonanceParam);
+
+    const double decayRate = damping < 2.0
+                                 ? 0.5 * damping
+                                 : 0.5 * damping - std::sqrt(0.25 * damping * damping - 1.0);
+    return std::log(1000.0) / (juce::MathConstants<double>::twoPi * cutoff * decayRate);
+}
+
+float ModernVCFProcessor::getMagnitudeResponse(double frequencyHz) const {
+    const double sampleRate = lastSampleRate.load();
+    if (sampleRate <= 0.0)
+        return 1.0f;
+
+    // TPT state variable lowpass: the bilinear transform (with prewarping) of
+    // H(s) = 1 / (s^2 + s / resonance + 1), evaluated at the warped frequency
+    const double nyquistLimit = sampleRate * 0.4999;
+    const double cutoff = juce::jmin(static_cast<double>(lastCutoff.load(std::memory_order_relaxed)),
+                                     nyquistLimit);
+    const double frequency = juce::jmin(frequencyHz, nyquistLimit);
+    const double pi = juce::MathConstants<double>::pi;
+    const double w = std::tan(pi * frequency / sampleRate) / std::tan(pi * cutoff / sampleRate);
+    const double damping = 1.0 / lastResonance.load(std::memory_order_relaxed);
+
+    const double real = 1.0 - w * w;
+    const double imaginary = damping * w;
+    return static_cast<float>(1.0 / std::sqrt(real * real + imaginary * imaginary));
+}
@@ -42,9 +42,7 @@ class ModernVCFProcessor : public juce::AudioProcessor, public IFilter {
     bool isMidiEffect() const override {
         return false;
     }
-    double getTailLengthSeconds() const override {
-        return 0.0;
-    }
+    double getTailLengthSeconds() const override;
 
     //==============================================================================
     int getNumPrograms() override {
@@ -67,6 +65,7 @@ class ModernVCFProcessor : public juce::AudioProcessor, public IFilter {
     ResonanceMode getResonanceMode() const override {
         return ResonanceMode::Continuous;
     }
+    float getMagnitudeResponse(double frequencyHz) const override;
 
    private:
     //==============================================================================
@@ -75,8 +74,13 @@ class ModernVCFProcessor : public juce::AudioProcessor, public IFilter {
     juce::AudioBuffer<float> processingBuffer;  // Reusable temporary buffer for audio processing
     int processingBufferCapacity = 0; // Capacity (in samples) of processingBuffer
 
+    // Settings of the last processed block, read by the UI for the response display
+    std::atomic<float> lastCutoff{1000.0f};
+    std::atomic<float> lastResonance{0.1f};
+    std::atomic<double> lastSampleRate{0.0};
+
     // Cutoff frequency calculation function
-    float calculateCutoffFrequency(float cutoffParam) {
+    float calculateCutoffFrequency(float cutoffParam) const {
         // Range covering the entire audible spectrum
         const float minFreq = 20.0f;     // Minimum cutoff frequency
         const float maxFreq = 20000.0f;  // Maximum cutoff frequency
@@ -88,7 +92,7 @@ class ModernVCFProcessor : public juce::AudioProcessor, public IFilter {
     }
 
     // Resonance calculation function
-    float calculateResonance(float resonanceParam) {
+    float calculateResonance(float resonanceParam) const {
         // Map normalized input (0.0 - 1.0) to useful resonance range
         // Resonance for StateVariableTPTFilter is effective in the range of 0.1 to 0.9
         return 0.1f + (resonanceParam * 0.8f);  // Map to range 0.1 to 0.9
@@ -1,4 +1,5 @@
 #include "NoiseGenerator.h"
+#include "DspProfiler.h"
 
 NoiseGenerator::NoiseGenerator(juce::AudioProcessorValueTreeState& apvts) : apvts(apvts) {}
 
@@ -11,10 +12,20 @@ void NoiseGenerator::prepare(const juce::dsp::ProcessSpec& spec) {
 
     *noiseFilter.coefficients =
         *juce::dsp::IIR::Coefficients<float>::makeFirstOrderLowPass(spec.sampleRate, cutoffFreq);
+
+    // Note state
+    noteOn = false;
+    tailOff = false;
+    tailOffCounter = 0;
+    tailOffDuration = 0;
+    currentlyPlayingNote = 0;
+    pitchWheelValue = 8192;
 }
 
 void NoiseGenerator::renderNextBlock(juce::AudioBuffer<float>& buffer, int startSample,
                                      int numSamples) {
+    CS01_PROFILE_SCOPE(DspStage::Noise, numSamples);
+
     // Only generate noise if note is on
     if (isActive()) {
         // Process tail off if needed
@@ -84,3 +95,8 @@ bool NoiseGenerator::isActive() const {
 int NoiseGenerator::getCurrentlyPlayingNote() const {
     return currentlyPlayingNote;
 }
+
+void NoiseGenerator::setSeed(juce::int64 seed) {
+    random.setSeed(seed);
+    noiseFilter.reset();
+}
@@ -28,6 +28,9 @@ class NoiseGenerator : public ISoundGenerator {
     bool isActive() const override;
     int getCurrentlyPlayingNote() const override;
 
+    // Restarts the noise sequence from a fixed seed (deterministic rendering)
+    void setSeed(juce::int64 seed);
+
    private:
     juce::AudioProcessorValueTreeState& apvts;
     juce::Random random;
@@ -1,4 +1,6 @@
 #include "OriginalVCFProcessor.h"
+#include "DspProfiler.h"
+#include "../ModulatableParameter.h"
 #include <cmath>
 
 //==============================================================================
@@ -17,6 +19,7 @@ void OriginalVCFProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
     // Initialize filter
     filter.reset();
     filter.prepare(sampleRate);
+    lastSampleRate.store(sampleRate);
 
     // Pre-allocate buffer for modulation values to avoid reallocations per block
     if (samplesPerBlock > modulationBufferCapacity) {
@@ -54,6 +57,7 @@ bool OriginalVCFProcessor::isBusesLayoutSupported(const BusesLayout& layouts) co
 
 void OriginalVCFProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                         juce::MidiBuffer& midiMessages) {
+    CS01_PROFILE_SCOPE(DspStage::OriginalVCF, buffer.getNumSamples());
     juce::ScopedNoDenormals noDenormals;
 
     // Original filter is completely mono, so only process channel 0
@@ -62,7 +66,7 @@ void OriginalVCFProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     auto lfoInput = getBusBuffer(buffer, true, 2);
 
     // Get parameters
-    auto cutoffParam = apvts.getRawParameterValue(ParameterIds::cutoff)->load();
+    auto cutoffParam = ModulatableParameter::getModulatedValue(apvts, ParameterIds::cutoff);
     auto resonanceParam = apvts.getRawParameterValue(ParameterIds::resonance)->load();
     auto egDepth = apvts.getRawParameterValue(ParameterIds::vcfEgDepth)->load();
     auto modDepth = apvts.getRawParameterValue(ParameterIds::modDepth)->load();
@@ -91,37 +95,22 @@ void OriginalVCFProcessor::processBlock(juce::AudioBuffer<float>& buffer,
         modulationBuffer.clear(numSamples);
     }
 
-    // Prepare modulation constants (move invariants out of per-sample loop)
-    const float egModRangeSemitones = 36.0f;      // 3 octaves
-    const float lfoModRangeSemitones = 24.0f;     // 2 octaves
-    const float breathModRangeSemitones = 24.0f;  // 2 octaves
+    // Control voltages are summed in octaves and converted once per sample; breath
+    // control is constant over the block
+    const float egOctaves = egDepth * EG_RANGE_OCTAVES;
+    const float lfoOctaves = modDepth * LFO_RANGE_OCTAVES;
+    const float breathOctaves = breathInput * breathVcfDepth * BREATH_RANGE_OCTAVES;
 
     // Calculate cutoff frequency for each sample
     for (int sample = 0; sample < numSamples; ++sample) {
-        float egValue = egData[sample];
-        float lfoValue = (lfoData != nullptr) ? lfoData[sample] : 0.0f;
-        // Base cutoff frequency
-        float baseCutoff = cutoff;
+        const float lfoValue = (lfoData != nullptr) ? lfoData[sample] : 0.0f;
+        const float octaves = egData[sample] * egOctaves + lfoValue * lfoOctaves + breathOctaves;
 
-        // EG modulation
-        float egMod = egValue * egDepth * egModRangeSemitones;
-        float egModFreqRatio = static_cast<float>(std::exp2(static_cast<double>(egMod / 12.0f)));
-
-        // LFO modulation
-        float lfoMod = lfoValue * modDepth * lfoModRangeSemitones;
-        float lfoModFreqRatio = static_cast<float>(std::exp2(static_cast<double>(lfoMod / 12.0f)));
-
-        // Breath modulation
-        float breathMod = breathInput * breathVcfDepth * breathModRangeSemitones;
-        float breathModFreqRatio = static_cast<float>(std::exp2(static_cast<double>(breathMod / 12.0f)));
-
-        // Apply all modulations
-        float modulatedCutoffHz =
-            baseCutoff * egModFreqRatio * lfoModFreqRatio * breathModFreqRatio;
+        float modulatedCutoffHz = cutoff * std::exp2(octaves);
 
         // Check for NaN or Infinity
         if (std::isnan(modulatedCutoffHz) || std::isinf(modulatedCutoffHz)) {
-            modulatedCutoffHz = baseCutoff;
+            modulatedCutoffHz = cutoff;
         }
 
         modulatedCutoffHz = juce::jlimit(20.0f, 20000.0f, modulatedCutoffHz);
@@ -135,4 +124,23 @@ void OriginalVCFProcessor::processBlock(juce::AudioBuffer<float>& buffer,
 
     // Process using filter
     filter.processBlock(outputData, buffer.getNumSamples(), modulationBuffer, resonance);
+
+    if (numSamples > 0) {
+        lastCutoff.store(modulationBuffer[numSamples - 1], std::memory_order_relaxed);
+        lastResonance.store(resonance, std::memory_order_relaxed);
+    }
+}
+
+// Once the EG has finished, the filter rings down at the cutoff set by the knob
+double OriginalVCFProcessor::getTailLengthSeconds() const {
+    const auto cutoffParam = ModulatableParameter::getModulatedValue(apvts, ParameterIds::cutoff);
+    const auto resonanceParam = apvts.getRawParameterValue(ParameterIds::resonance)->load();
+    return IG02610LPF::getDecaySeconds(calculateCutoffFrequency(cutoffParam),
+                                       calculateResonance(resonanceParam));
+}
+
+float OriginalVCFProcessor::getMagnitudeResponse(double frequencyHz) const {
+    return IG02610LPF::getMagnitudeResponse(lastCutoff.load(std::memory_order_relaxed),
+                                            lastResonance.load(std::memory_order_relaxed),
+                                            lastSampleRate.load(), frequencyHz);
 }
@@ -42,9 +42,7 @@ class OriginalVCFProcessor : public juce::AudioProcessor, public IFilter {
     bool isMidiEffect() const override {
         return false;
     }
-    double getTailLengthSeconds() const override {
-        return 0.0;
-    }
+    double getTailLengthSeconds() const override;
 
     //==============================================================================
     int getNumPrograms() override {
@@ -67,6 +65,7 @@ class OriginalVCFProcessor : public juce::AudioProcessor, public IFilter {
     ResonanceMode getResonanceMode() const override {
         return ResonanceMode::Toggle;
     }
+    float getMagnitudeResponse(double frequencyHz) const override;
 
    private:
     //==============================================================================
@@ -75,8 +74,18 @@ class OriginalVCFProcessor : public juce::AudioProcessor, public IFilter {
     juce::HeapBlock<float> modulationBuffer;  //  Buffer preallocated for reuse
     int modulationBufferCapacity = 0;         // Capacity (in samples) of allocated modulationBuffer
 
+    // Settings of the last processed block, read by the UI for the response display
+    std::atomic<float> lastCutoff{1000.0f};
+    std::atomic<float> lastResonance{0.2f};
+    std::atomic<double> lastSampleRate{0.0};
+
+    // Modulation ranges at full depth
+    static constexpr float EG_RANGE_OCTAVES = 3.0f;
+    static constexpr float LFO_RANGE_OCTAVES = 2.0f;
+    static constexpr float BREATH_RANGE_OCTAVES = 2.0f;
+
     // Cutoff frequency calculation function
-    float calculateCutoffFrequency(float cutoffParam) {
+    float calculateCutoffFrequency(float cutoffParam) const {
         // Range covering the entire audible spectrum
         const float minFreq = 20.0f;     // Minimum cutoff frequency
         const float maxFreq = 20000.0f;  // Maximum cutoff frequency
@@ -88,7 +97,7 @@ class OriginalVCFProcessor : public juce::AudioProcessor, public IFilter {
     }
 
     // Resonance calculation function
-    float calculateResonance(float resonanceParam) {
+    float calculateResonance(float resonanceParam) const {
         // For original filter, use threshold to binarize the value
         // Treat as High Resonance if value is 0.5 or higher
         if (resonanceParam >= 0.5f) {
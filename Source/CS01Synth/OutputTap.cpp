@@ -0,0 +1,36 @@
+#include "OutputTap.h"
+
+void OutputTap::push(const float* samples, int numSamples) noexcept {
+    if (!enabled.load(std::memory_order_relaxed))
+        return;
+
+    const auto scope = fifo.write(juce::jmin(numSamples, fifo.getFreeSpace()));
+
+    if (scope.blockSize1 > 0)
+        std::copy(samples, samples + scope.blockSize1, buffer.data() + scope.startIndex1);
+    if (scope.blockSize2 > 0)
+        std::copy(samples + scope.blockSize1, samples + scope.blockSize1 + scope.blockSize2,
+                  buffer.data() + scope.startIndex2);
+}
+
+void OutputTap::setEnabled(bool shouldBeEnabled) noexcept {
+    // Whatever was left from an earlier reader is stale; consuming is the reader's job
+    if (shouldBeEnabled && !isEnabled())
+        fifo.read(fifo.getNumReady());
+
+    enabled.store(shouldBeEnabled);
+}
+
+int OutputTap::pull(float* destination, int maxSamples) noexcept {
+    const auto scope = fifo.read(juce::jmin(maxSamples, fifo.getNumReady()));
+
+    if (scope.blockSize1 > 0)
+        std::copy(buffer.data() + scope.startIndex1,
+                  buffer.data() + scope.startIndex1 + scope.blockSize1, destination);
+    if (scope.blockSize2 > 0)
+        std::copy(buffer.data() + scope.startIndex2,
+                  buffer.data() + scope.startIndex2 + scope.blockSize2,
+                  destination + scope.blockSize1);
+
+    return scope.blockSize1 + scope.blockSize2;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+//==============================================================================
+// Copy of the mono output for displays that want the raw signal. The audio
+// thread writes into a preallocated lock-free FIFO, and only while a reader
+// is attached; what does not fit is dropped rather than waited for.
+class OutputTap {
+   public:
+    static constexpr int CAPACITY = 8192;
+
+    OutputTap() = default;
+    ~OutputTap() = default;
+
+    // Audio thread
+    void push(const float* samples, int numSamples) noexcept;
+
+    // Reader thread (one at a time)
+    void setEnabled(bool shouldBeEnabled) noexcept;
+    bool isEnabled() const noexcept {
+        return enabled.load(std::memory_order_relaxed);
+    }
+    int pull(float* destination, int maxSamples) noexcept;
+
+   private:
+    juce::AbstractFifo fifo{CAPACITY};
+    std::array<float, CAPACITY> buffer{};
+    std::atomic<bool> enabled{false};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OutputTap)
+};
@@ -0,0 +1,88 @@
+#include "ParameterRamp.h"
+
+void ParameterRamp::prepare(ParameterSync& parameterSync, double sampleRate, double rampSeconds,
+                            const std::vector<juce::RangedAudioParameter*>& parametersToRamp,
+                            const std::vector<bool>& excludedMask) {
+    jassert(parametersToRamp.size() == excludedMask.size());
+
+    sync = &parameterSync;
+    parameters = parametersToRamp;
+    excluded = excludedMask;
+    continuous.assign(parameters.size(), false);
+    startValues.assign(parameters.size(), 0.0f);
+    targetValues.assign(parameters.size(), 0.0f);
+    changed.assign(parameters.size(), false);
+
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        if (parameters[i] == nullptr) {
+            excluded[i] = true;
+            continue;
+        }
+
+        continuous[i] = !parameters[i]->isDiscrete() && !parameters[i]->isBoolean();
+    }
+
+    rampLength = juce::jmax(1, static_cast<int>(std::round(sampleRate * rampSeconds)));
+    elapsed = 0;
+    active = false;
+}
+
+void ParameterRamp::start(const float* newTargetValues) noexcept {
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        if (excluded[i])
+            continue;
+
+        startValues[i] = parameters[i]->getValue();
+        targetValues[i] = newTargetValues[i];
+
+        // Changes of an interrupted ramp are still published
+        changed[i] = changed[i] || startValues[i] != targetValues[i];
+
+        // Switches cannot be interpolated; change them at the event position
+        if (!continuous[i])
+            sync->setValue(*parameters[i], targetValues[i], ParameterSync::Notify::None);
+    }
+
+    elapsed = 0;
+    active = true;
+}
+
+void ParameterRamp::advance(int numSamples) noexcept {
+    if (!active)
+        return;
+
+    elapsed = juce::jmin(rampLength, elapsed + numSamples);
+    const float progress = static_cast<float>(elapsed) / static_cast<float>(rampLength);
+
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        if (excluded[i] || !continuous[i])
+            continue;
+
+        const float value = startValues[i] + (targetValues[i] - startValues[i]) * progress;
+
+        sync->setValue(*parameters[i], value, ParameterSync::Notify::None);
+    }
+
+    if (elapsed >= rampLength)
+        stop();
+}
+
+void ParameterRamp::stop() noexcept {
+    if (!active)
+        return;
+
+    active = false;
+    publishChanges();
+}
+
+// One notification per changed parameter, with the value it ended on
+void ParameterRamp::publishChanges() noexcept {
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        if (!changed[i])
+            continue;
+
+        sync->setValue(*parameters[i], parameters[i]->getValue(),
+                       ParameterSync::Notify::EditorAndHost);
+        changed[i] = false;
+    }
+}
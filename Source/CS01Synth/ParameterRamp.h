@@ -0,0 +1,52 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include "ParameterSync.h"
+
+//==============================================================================
+// Moves a set of parameters to new normalised values from the audio thread.
+// Discrete parameters (choices, ints, bools) jump immediately; continuous ones
+// are interpolated linearly over the ramp time to avoid clicks. All storage is
+// allocated in prepare(), so start() and advance() never allocate.
+// Values are written through ParameterSync, and each changed parameter is published
+// once, when the ramp ends.
+class ParameterRamp {
+   public:
+    ParameterRamp() = default;
+    ~ParameterRamp() = default;
+
+    // Parameters flagged in excludedMask are never touched
+    void prepare(ParameterSync& parameterSync, double sampleRate, double rampSeconds,
+                 const std::vector<juce::RangedAudioParameter*>& parametersToRamp,
+                 const std::vector<bool>& excludedMask);
+
+    // targetValues must hold one normalised value per parameter
+    void start(const float* targetValues) noexcept;
+    void advance(int numSamples) noexcept;
+    void stop() noexcept;
+
+    bool isActive() const noexcept {
+        return active;
+    }
+    int getRampLengthInSamples() const noexcept {
+        return rampLength;
+    }
+
+   private:
+    void publishChanges() noexcept;
+
+    ParameterSync* sync = nullptr;
+    std::vector<juce::RangedAudioParameter*> parameters;
+    std::vector<bool> excluded;
+    std::vector<bool> continuous;
+    std::vector<float> startValues;
+    std::vector<float> targetValues;
+    std::vector<bool> changed;
+
+    int rampLength = 1;
+    int elapsed = 0;
+    bool active = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterRamp)
+};
@@ -0,0 +1,84 @@
+#include "ParameterSync.h"
+
+ParameterSync::ParameterSync(juce::AudioProcessorValueTreeState& vts)
+    : apvts(vts), entries(static_cast<size_t>(vts.processor.getParameters().size())) {
+    const auto& parameters = apvts.processor.getParameters();
+
+    for (int i = 0; i < parameters.size(); ++i) {
+        auto& entry = entries[static_cast<size_t>(i)];
+        entry.parameter = dynamic_cast<juce::RangedAudioParameter*>(parameters[i]);
+
+        if (entry.parameter != nullptr) {
+            entry.parameterID = entry.parameter->getParameterID();
+            entry.rawValue = apvts.getRawParameterValue(entry.parameterID);
+        }
+    }
+}
+
+void ParameterSync::addListener(const juce::String& parameterID,
+                                juce::AudioProcessorValueTreeState::Listener* listener) {
+    if (auto* parameter = apvts.getParameter(parameterID))
+        if (auto* entry = findEntry(*parameter))
+            entry->listeners.push_back(listener);
+}
+
+ParameterSync::Entry* ParameterSync::findEntry(juce::RangedAudioParameter& parameter) noexcept {
+    const auto index = static_cast<size_t>(parameter.getParameterIndex());
+    if (index >= entries.size() || entries[index].parameter != &parameter)
+        return nullptr;
+
+    return &entries[index];
+}
+
+void ParameterSync::setValue(juce::RangedAudioParameter& parameter, float normalisedValue,
+                             Notify notify) noexcept {
+    auto* entry = findEntry(parameter);
+    if (entry == nullptr)
+        return;
+
+    if (parameter.getValue() != normalisedValue) {
+        parameter.setValue(normalisedValue);
+
+        // What the APVTS would store after a notified change
+        const float value = parameter.convertFrom0to1(parameter.getValue());
+        if (entry->rawValue != nullptr)
+            entry->rawValue->store(value);
+
+        for (auto* listener : entry->listeners)
+            listener->parameterChanged(entry->parameterID, value);
+    }
+
+    if (notify == Notify::None)
+        return;
+
+    entry->pending.fetch_or(static_cast<int>(notify));
+    anyPending.store(true, std::memory_order_release);
+}
+
+bool ParameterSync::publish() {
+    if (!anyPending.exchange(false, std::memory_order_acquire))
+        return false;
+
+    bool editorNeedsUpdate = false;
+
+    for (auto& entry : entries) {
+        const int pending = entry.pending.exchange(0);
+        if (pending == 0)
+            continue;
+
+        // The APVTS only writes its state for changes it was notified of. The raw value is
+        // already current, so the APVTS takes this write without notifying anyone
+        if (entry.rawValue != nullptr)
+            apvts.state.getChildWithProperty("id", entry.parameterID)
+                .setProperty("value", entry.rawValue->load(), nullptr);
+
+        // Notifying reaches the host, the editor's controls and every other listener, so a
+        // value the host sent is only shown
+        if (pending == static_cast<int>(Notify::EditorAndHost))
+            entry.parameter->sendValueChangedMessageToListeners(entry.parameter->getValue());
+        else
+            editorNeedsUpdate = true;
+    }
+
+    return editorNeedsUpdate;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+// Parameter changes made on the audio thread (program change ramps).
+// setValue() updates the parameter and the APVTS value the DSP reads without calling the
+// parameter's listeners, so the host is not flooded with notifications and no listener
+// work runs on the audio thread. Only the listeners added here, which must react before
+// the next block (graph and generator switches), are called at once.
+//
+// publish() runs on the message thread: it writes the changes into the APVTS state and
+// notifies each changed parameter once, which reaches the host and the editor. Values that
+// came from the host are not sent back to it; the editor re-reads those instead.
+class ParameterSync {
+   public:
+    // Who hears about a change when it is published
+    enum class Notify {
+        None = 0,          // Intermediate values, such as the steps of a ramp
+        Editor = 1,        // Values the host sent, such as automation
+        EditorAndHost = 3  // Changes the plugin made, such as a program change
+    };
+
+    explicit ParameterSync(juce::AudioProcessorValueTreeState& apvts);
+
+    // Called on the audio thread for every change setValue() makes to the parameter. Add
+    // before processing starts
+    void addListener(const juce::String& parameterID,
+                     juce::AudioProcessorValueTreeState::Listener* listener);
+
+    // Audio thread: applies a normalised value. An unchanged value is only marked for
+    // publishing
+    void setValue(juce::RangedAudioParameter& parameter, float normalisedValue,
+                  Notify notify) noexcept;
+
+    // Message thread. Returns true when the editor has to re-read its controls, because a
+    // published value was not sent to the parameter's listeners
+    bool publish();
+
+   private:
+    struct Entry {
+        juce::RangedAudioParameter* parameter = nullptr;
+        std::atomic<float>* rawValue = nullptr;
+        juce::String parameterID;
+        std::vector<juce::AudioProcessorValueTreeState::Listener*> listeners;
+        std::atomic<int> pending{0};  // Notify flags
+    };
+
+    Entry* findEntry(juce::RangedAudioParameter& parameter) noexcept;
+
+    juce::AudioProcessorValueTreeState& apvts;
+    std::vector<Entry> entries;  // By parameter index
+    std::atomic<bool> anyPending{false};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterSync)
+};
@@ -0,0 +1,147 @@
+#include "PolyphaseResampler.h"
+
+namespace {
+// Zeroth-order modified Bessel function of the first kind (Kaiser window)
+double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double halfX = x * 0.5;
+
+    for (int k = 1; k < 50; ++k) {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+
+        if (term < sum * 1.0e-12)
+            break;
+    }
+
+    return sum;
+}
+}  // namespace
+
+//==============================================================================
+void PolyphaseResampler::prepare(double inputSampleRate, double outputSampleRate,
+                                 int maximumOutputBlockSize) {
+    jassert(inputSampleRate > 0.0 && outputSampleRate > 0.0);
+
+    inputRate = inputSampleRate;
+    outputRate = outputSampleRate;
+    increment = static_cast<int64_t>(
+        std::llround(inputRate / outputRate * static_cast<double>(int64_t(1) << FRACTION_BITS)));
+
+    maximumInputBlockSize =
+        static_cast<int>(std::ceil(juce::jmax(1, maximumOutputBlockSize) * inputRate / outputRate)) +
+        NUM_TAPS + 2;
+    history.assign(static_cast<size_t>(maximumInputBlockSize + NUM_TAPS * 2), 0.0f);
+
+    buildKernel();
+    reset();
+}
+
+void PolyphaseResampler::reset() {
+    std::fill(history.begin(), history.end(), 0.0f);
+
+    // Half a kernel of silence in front of the first input sample keeps the
+    // output centred on the input timeline; the lookahead becomes our latency
+    numBuffered = HALF_TAPS;
+    position = int64_t(HALF_TAPS) << FRACTION_BITS;
+}
+
+int PolyphaseResampler::getNumInputSamplesRequired(int numOutputSamples) const noexcept {
+    if (numOutputSamples <= 0)
+        return 0;
+
+    const auto lastIndex =
+        static_cast<int>((position + int64_t(numOutputSamples - 1) * increment) >> FRACTION_BITS);
+
+    return juce::jmax(0, lastIndex + HALF_TAPS + 1 - numBuffered);
+}
+
+int PolyphaseResampler::getLatencyInOutputSamples() const noexcept {
+    return static_cast<int>(std::lround(HALF_TAPS * outputRate / inputRate));
+}
+
+void PolyphaseResampler::process(const float* input, int numInputSamples, float* output,
+                                 int numOutputSamples) noexcept {
+    jassert(numInputSamples == getNumInputSamplesRequired(numOutputSamples));
+    jassert(numBuffered + numInputSamples <= static_cast<int>(history.size()));
+
+    if (numInputSamples > 0) {
+        std::copy(input, input + numInputSamples, history.begin() + numBuffered);
+        numBuffered += numInputSamples;
+    }
+
+    constexpr int phaseShift = FRACTION_BITS - 8;  // NUM_PHASES == 2^8
+    constexpr uint32_t alphaMask = (1u << phaseShift) - 1u;
+    constexpr float alphaScale = 1.0f / static_cast<float>(1u << phaseShift);
+    static_assert(NUM_PHASES == (1 << 8), "phaseShift assumes 256 phases");
+
+    const float* historyData = history.data();
+    const float* kernelData = kernel.data();
+
+    for (int i = 0; i < numOutputSamples; ++i) {
+        const auto index = static_cast<int>(position >> FRACTION_BITS);
+        const auto fraction = static_cast<uint32_t>(position & 0xffffffff);
+        const auto phase = static_cast<int>(fraction >> phaseShift);
+        const float alpha = static_cast<float>(fraction & alphaMask) * alphaScale;
+
+        const float* x = historyData + index - HALF_TAPS + 1;
+        const float* c0 = kernelData + phase * NUM_TAPS;
+        const float* c1 = c0 + NUM_TAPS;
+
+        float sums[2];
+        dspKernels.dotProductPair(x, c0, c1, NUM_TAPS, sums);
+
+        output[i] = sums[0] + alpha * (sums[1] - sums[0]);
+        position += increment;
+    }
+
+    // Drop input samples that no future output can reach
+    const int firstNeeded = juce::jmin(
+        numBuffered, static_cast<int>(position >> FRACTION_BITS) - HALF_TAPS + 1);
+
+    if (firstNeeded > 0) {
+        std::copy(history.begin() + firstNeeded, history.begin() + numBuffered, history.begin());
+        numBuffered -= firstNeeded;
+        position -= int64_t(firstNeeded) << FRACTION_BITS;
+    }
+}
+
+void PolyphaseResampler::buildKernel() {
+    kernel.assign(static_cast<size_t>((NUM_PHASES + 1) * NUM_TAPS), 0.0f);
+
+    // Lowpass at the lower of the two Nyquist frequencies to avoid aliasing when decimating
+    const double cutoff = CUTOFF_RATIO * juce::jmin(1.0, outputRate / inputRate);
+    const double windowNorm = besselI0(KAISER_BETA);
+
+    for (int phase = 0; phase <= NUM_PHASES; ++phase) {
+        const double fraction = static_cast<double>(phase) / NUM_PHASES;
+        float* taps = kernel.data() + phase * NUM_TAPS;
+        double sum = 0.0;
+
+        for (int k = 0; k < NUM_TAPS; ++k) {
+            // Distance from the output instant to the input sample read by this tap
+            const double distance = fraction + (HALF_TAPS - 1 - k);
+            const double ratio = distance / HALF_TAPS;
+
+            double value = 0.0;
+
+            if (std::abs(ratio) < 1.0) {
+                const double x = juce::MathConstants<double>::pi * cutoff * distance;
+                const double sinc = std::abs(x) < 1.0e-9 ? 1.0 : std::sin(x) / x;
+                const double window = besselI0(KAISER_BETA * std::sqrt(1.0 - ratio * ratio)) /
+                                      windowNorm;
+                value = cutoff * sinc * window;
+            }
+
+            taps[k] = static_cast<float>(value);
+            sum += value;
+        }
+
+        // Unity gain at DC for every branch
+        if (sum > 0.0) {
+            for (int k = 0; k < NUM_TAPS; ++k)
+                taps[k] = static_cast<float>(taps[k] / sum);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DspKernels.h"
+#include <cstdint>
+#include <vector>
+
+//==============================================================================
+// Mono windowed-sinc polyphase resampler used to run the synth engine at a fixed
+// internal rate. The engine is pulled on demand: ask how many input samples are
+// needed for the next output block, render exactly that many and pass them in.
+class PolyphaseResampler {
+   public:
+    PolyphaseResampler() = default;
+    ~PolyphaseResampler() = default;
+
+    void prepare(double inputSampleRate, double outputSampleRate, int maximumOutputBlockSize);
+    void reset();
+
+    // Number of input samples process() expects for the next numOutputSamples
+    int getNumInputSamplesRequired(int numOutputSamples) const noexcept;
+
+    // Upper bound of getNumInputSamplesRequired() for the prepared block size
+    int getMaximumInputSamplesRequired() const noexcept {
+        return maximumInputBlockSize;
+    }
+
+    // Delay introduced by the filter lookahead, in output samples
+    int getLatencyInOutputSamples() const noexcept;
+
+    void process(const float* input, int numInputSamples, float* output,
+                 int numOutputSamples) noexcept;
+
+    static constexpr int NUM_TAPS = 32;     // Taps per polyphase branch
+    static constexpr int NUM_PHASES = 256;  // Branches, linearly interpolated
+
+   private:
+    static constexpr int HALF_TAPS = NUM_TAPS / 2;
+    static constexpr int FRACTION_BITS = 32;
+    static constexpr float KAISER_BETA = 8.0f;
+    static constexpr float CUTOFF_RATIO = 0.92f;  // Passband edge relative to the lower Nyquist
+
+    void buildKernel();
+
+    // Dot products for this CPU (not to be confused with the filter kernel below)
+    const DspKernels& dspKernels = DspKernels::get();
+
+    // (NUM_PHASES + 1) branches of NUM_TAPS coefficients each
+    std::vector<float> kernel;
+    std::vector<float> history;
+
+    int numBuffered = 0;
+    int maximumInputBlockSize = 0;
+
+    // Read position in 32.32 fixed point so the required input count is exact
+    int64_t position = 0;
+    int64_t increment = int64_t(1) << FRACTION_BITS;
+
+    double inputRate = 48000.0;
+    double outputRate = 48000.0;
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Marks code that has to be real-time safe. The marker is only compiled in when
+// CS01_REALTIME_CHECKS is set, which the Tests target does: its harness
+// (Tests/RealtimeSafety.cpp) defines the functions below and fails a test when
+// a marked scope allocates, frees or waits on a contended mutex.
+#ifndef CS01_REALTIME_CHECKS
+#define CS01_REALTIME_CHECKS 0
+#endif
+
+namespace RealtimeScope {
+// Scopes nest; name must be a string literal (it is stored, not copied)
+void enter(const char* name) noexcept;
+void exit() noexcept;
+
+class Scoped {
+   public:
+    explicit Scoped(const char* name) noexcept {
+        enter(name);
+    }
+    ~Scoped() noexcept {
+        exit();
+    }
+
+   private:
+    JUCE_DECLARE_NON_COPYABLE(Scoped)
+};
+}  // namespace RealtimeScope
+
+#if CS01_REALTIME_CHECKS
+#define CS01_REALTIME_SCOPE(name) \
+    const RealtimeScope::Scoped JUCE_JOIN_MACRO(cs01RealtimeScope_, __LINE__)(name)
+#else
+#define CS01_REALTIME_SCOPE(name)
+#endif
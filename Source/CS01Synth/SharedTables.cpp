@@ -0,0 +1,15 @@
+#include "SharedTables.h"
+
+SharedTables::SharedTables()
+    : lfoTriangle(
+          [](float x) { return 1.0f - 4.0f * std::abs(std::round(x - 0.25f) - (x - 0.25f)); },
+          -juce::MathConstants<float>::pi, juce::MathConstants<float>::pi, OSCILLATOR_TABLE_SIZE),
+      pwmTriangle(
+          [](float x) { return std::asin(std::sin(x)) * (2.0f / juce::MathConstants<float>::pi); },
+          -juce::MathConstants<float>::pi, juce::MathConstants<float>::pi, OSCILLATOR_TABLE_SIZE) {
+    // The last entry (pi/2) is never interpolated towards, as frequencies stop below 0.5
+    for (int i = 0; i < INTEGRATOR_GAIN_TABLE_SIZE; ++i)
+        integratorGains[static_cast<size_t>(i)] = static_cast<float>(
+            std::tan(juce::MathConstants<double>::pi * 0.5 * i / INTEGRATOR_GAIN_TABLE_SIZE));
+    integratorGains[INTEGRATOR_GAIN_TABLE_SIZE] = integratorGains[INTEGRATOR_GAIN_TABLE_SIZE - 1];
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+//==============================================================================
+// Read-only lookup tables for the DSP classes. Plugin instances share one set
+// through juce::SharedResourcePointer: it is built on first use and freed with
+// the last holder, so a session with many instances keeps a single copy in memory
+// and in cache, and constructing an instance builds no tables.
+class SharedTables {
+   public:
+    SharedTables();
+    ~SharedTables() = default;
+
+    // One period over -pi..pi, in the form juce::dsp::Oscillator generators take
+    static constexpr size_t OSCILLATOR_TABLE_SIZE = 128;
+
+    // LFO triangle, starting at -1
+    const juce::dsp::LookupTableTransform<float> lfoTriangle;
+
+    // PWM LFO triangle, asin(sin(x)) scaled to -1..1
+    const juce::dsp::LookupTableTransform<float> pwmTriangle;
+
+    // tan(pi * normalisedFrequency), the integrator gain of a trapezoidal SVF
+    float getIntegratorGain(float normalisedFrequency) const noexcept {
+        const float position =
+            juce::jlimit(0.0f, MAX_NORMALISED_FREQUENCY, normalisedFrequency) *
+            (2.0f * INTEGRATOR_GAIN_TABLE_SIZE);
+        const auto index = static_cast<size_t>(position);
+        const float fraction = position - static_cast<float>(index);
+        const float lower = integratorGains[index];
+        return lower + fraction * (integratorGains[index + 1] - lower);
+    }
+
+    // Frequencies above this (relative to the sample rate) are clamped
+    static constexpr float MAX_NORMALISED_FREQUENCY = 0.49f;
+
+   private:
+    // Over normalised frequencies 0..0.5, linearly interpolated
+    static constexpr int INTEGRATOR_GAIN_TABLE_SIZE = 2048;
+    std::array<float, INTEGRATOR_GAIN_TABLE_SIZE + 1> integratorGains;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedTables)
+};
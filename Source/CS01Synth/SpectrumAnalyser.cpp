@@ -0,0 +1,133 @@
+#include "SpectrumAnalyser.h"
+
+SpectrumAnalyser::SpectrumAnalyser() : juce::Thread("CS01 Spectrum Analyser") {
+    fifoBuffer.resize(FIFO_SIZE, 0.0f);
+}
+
+SpectrumAnalyser::~SpectrumAnalyser() {
+    enabled.store(false);
+    stopThread(1000);
+}
+
+void SpectrumAnalyser::prepare(double sampleRate) {
+    currentSampleRate.store(sampleRate);
+}
+
+void SpectrumAnalyser::pushSamples(const float* samples, int numSamples) noexcept {
+    if (!enabled.load(std::memory_order_relaxed))
+        return;
+
+    // Drop what does not fit; the analysis thread has fallen behind anyway
+    const auto scope = fifo.write(juce::jmin(numSamples, fifo.getFreeSpace()));
+
+    if (scope.blockSize1 > 0)
+        std::copy(samples, samples + scope.blockSize1, fifoBuffer.data() + scope.startIndex1);
+    if (scope.blockSize2 > 0)
+        std::copy(samples + scope.blockSize1, samples + scope.blockSize1 + scope.blockSize2,
+                  fifoBuffer.data() + scope.startIndex2);
+}
+
+void SpectrumAnalyser::setEnabled(bool shouldBeEnabled) {
+    if (shouldBeEnabled == isEnabled())
+        return;
+
+    if (shouldBeEnabled) {
+        enabled.store(true);
+        startThread(juce::Thread::Priority::low);
+    } else {
+        enabled.store(false);
+        stopThread(1000);
+    }
+}
+
+bool SpectrumAnalyser::getLatestSpectrum(std::vector<float>& magnitudes, double& binWidthHz,
+                                         int& lastVersion) {
+    if (resultVersion.load() == lastVersion)
+        return false;
+
+    const juce::SpinLock::ScopedLockType lock(resultLock);
+    magnitudes = result;
+    binWidthHz = resultBinWidth;
+    lastVersion = resultVersion.load();
+    return true;
+}
+
+void SpectrumAnalyser::run() {
+    // Discard anything left over from a previous run
+    fifo.read(fifo.getNumReady());
+
+    while (!threadShouldExit()) {
+        const int order = fftOrder.load();
+        if (order != configuredOrder)
+            configure(order);
+
+        const int numReady = fifo.getNumReady();
+        if (numReady == 0) {
+            wait(5);
+            continue;
+        }
+
+        const auto scope = fifo.read(juce::jmin(numReady, samplesUntilNextFrame));
+        const int numRead = scope.blockSize1 + scope.blockSize2;
+
+        // Slide the frame and append the new samples
+        std::move(frame.begin() + numRead, frame.end(), frame.begin());
+        auto* destination = frame.data() + frame.size() - static_cast<size_t>(numRead);
+        std::copy_n(fifoBuffer.data() + scope.startIndex1, scope.blockSize1, destination);
+        std::copy_n(fifoBuffer.data() + scope.startIndex2, scope.blockSize2,
+                    destination + scope.blockSize1);
+
+        samplesUntilNextFrame -= numRead;
+        if (samplesUntilNextFrame <= 0) {
+            analyseFrame();
+            samplesUntilNextFrame = static_cast<int>(frame.size()) / OVERLAP;
+        }
+    }
+}
+
+void SpectrumAnalyser::configure(int order) {
+    const size_t fftSize = static_cast<size_t>(1) << order;
+
+    fft = std::make_unique<juce::dsp::FFT>(order);
+    window.assign(fftSize, 0.0f);
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(
+        window.data(), fftSize, juce::dsp::WindowingFunction<float>::hann, false);
+
+    frame.assign(fftSize, 0.0f);
+    fftData.assign(fftSize * 2, 0.0f);
+    averaged.assign(fftSize / 2 + 1, 0.0f);
+
+    configuredOrder = order;
+    samplesUntilNextFrame = static_cast<int>(fftSize);
+}
+
+void SpectrumAnalyser::analyseFrame() {
+    const size_t fftSize = frame.size();
+    const size_t numBins = averaged.size();
+
+    float windowSum = 0.0f;
+    for (size_t i = 0; i < fftSize; ++i) {
+        fftData[i] = frame[i] * window[i];
+        windowSum += window[i];
+    }
+    std::fill(fftData.begin() + static_cast<std::ptrdiff_t>(fftSize), fftData.end(), 0.0f);
+
+    fft->performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    // Normalise so that a full-scale sine reads 0 dB
+    const float gain = 2.0f / windowSum;
+    const float weight = averaging.load(std::memory_order_relaxed);
+
+    std::vector<float> decibels(numBins);
+    for (size_t i = 0; i < numBins; ++i) {
+        averaged[i] = weight * averaged[i] + (1.0f - weight) * fftData[i] * gain;
+        decibels[i] = juce::Decibels::gainToDecibels(averaged[i], MIN_DECIBELS);
+    }
+
+    const double binWidth = currentSampleRate.load() / static_cast<double>(fftSize);
+
+    const juce::SpinLock::ScopedLockType lock(resultLock);
+    result.swap(decibels);
+    resultBinWidth = binWidth;
+    ++resultVersion;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+// FFT spectrum of the synth output. The audio thread only copies samples into
+// a preallocated lock-free FIFO (and does nothing while the analyser is
+// disabled); windowing, the FFT, averaging and the conversion to decibels run
+// on a background thread. The UI reads the newest averaged spectrum.
+class SpectrumAnalyser : private juce::Thread {
+   public:
+    static constexpr int MIN_FFT_ORDER = 9;   // 512 points
+    static constexpr int MAX_FFT_ORDER = 14;  // 16384 points
+    static constexpr int DEFAULT_FFT_ORDER = 11;
+    static constexpr float MIN_DECIBELS = -120.0f;
+
+    SpectrumAnalyser();
+    ~SpectrumAnalyser() override;
+
+    void prepare(double sampleRate);
+
+    // Audio thread
+    void pushSamples(const float* samples, int numSamples) noexcept;
+
+    // Message thread: starts or stops the analysis thread
+    void setEnabled(bool shouldBeEnabled);
+    bool isEnabled() const noexcept {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    // Any thread
+    void setFftOrder(int newOrder) noexcept {
+        fftOrder.store(juce::jlimit(MIN_FFT_ORDER, MAX_FFT_ORDER, newOrder));
+    }
+    int getFftOrder() const noexcept {
+        return fftOrder.load();
+    }
+    // Weight of the previous spectrum in the exponential average (0 = no averaging)
+    void setAveraging(float newAveraging) noexcept {
+        averaging.store(juce::jlimit(0.0f, 0.95f, newAveraging));
+    }
+    float getAveraging() const noexcept {
+        return averaging.load();
+    }
+
+    // Copies the newest spectrum (in dB, one value per bin up to Nyquist) if it is newer
+    // than lastVersion. Returns false if nothing new is available.
+    bool getLatestSpectrum(std::vector<float>& magnitudes, double& binWidthHz, int& lastVersion);
+
+   private:
+    void run() override;
+    void configure(int order);
+    void analyseFrame();
+
+    static constexpr int FIFO_SIZE = 32768;
+    static constexpr int OVERLAP = 4;  // Hop of a quarter frame
+
+    juce::AbstractFifo fifo{FIFO_SIZE};
+    std::vector<float> fifoBuffer;
+    std::atomic<bool> enabled{false};
+    std::atomic<double> currentSampleRate{44100.0};
+
+    std::atomic<int> fftOrder{DEFAULT_FFT_ORDER};
+    std::atomic<float> averaging{0.7f};
+
+    // Analysis thread
+    int configuredOrder = 0;
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> window;
+    std::vector<float> frame;     // Sliding input frame of fftSize samples
+    std::vector<float> fftData;   // 2 * fftSize working buffer
+    std::vector<float> averaged;  // Linear magnitudes
+    int samplesUntilNextFrame = 0;
+
+    // Published result (analysis thread -> UI)
+    juce::SpinLock resultLock;
+    std::vector<float> result;
+    double resultBinWidth = 0.0;
+    std::atomic<int> resultVersion{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyser)
+};
@@ -0,0 +1,30 @@
+#include "TaskDispatcher.h"
+
+void TaskDispatcher::add(TaskFunction function, void* context) noexcept {
+    if (numTasks == MAX_TASKS) {
+        function(context);
+        return;
+    }
+
+    tasks[static_cast<size_t>(numTasks++)] = {function, context};
+}
+
+void TaskDispatcher::run() noexcept {
+    // A single task is not worth waking a worker for
+    auto* currentExecutor = executor.load();
+    const bool parallel =
+        currentExecutor != nullptr && numTasks > 1 && currentExecutor->execute(*this, numTasks);
+
+    if (!parallel) {
+        for (int i = 0; i < numTasks; ++i)
+            runTask(i);
+    }
+
+    numTasks = 0;
+}
+
+void TaskDispatcher::runTask(int index) noexcept {
+    jassert(juce::isPositiveAndBelow(index, numTasks));
+    const auto& task = tasks[static_cast<size_t>(index)];
+    task.function(task.context);
+}
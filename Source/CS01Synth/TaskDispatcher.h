@@ -0,0 +1,61 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+//==============================================================================
+// Runs a batch of independent tasks from the audio thread. When an executor for
+// the host's worker threads is installed (such as the CLAP thread-pool extension),
+// the batch is spread over those workers; otherwise, or when the executor declines,
+// the tasks run one after another on the calling thread. Tasks are plain function
+// pointers with a context, so queuing them never allocates.
+class TaskDispatcher {
+   public:
+    static constexpr int MAX_TASKS = 16;
+
+    using TaskFunction = void (*)(void* context) noexcept;
+
+    // Implemented on top of a host thread pool. execute() must call runTask(i) once
+    // for every i in [0, numTasks), from any threads, and return only when all calls
+    // have finished. Returning false makes the dispatcher run the batch serially.
+    class Executor {
+       public:
+        virtual ~Executor() = default;
+        virtual bool execute(TaskDispatcher& dispatcher, int numTasks) noexcept = 0;
+    };
+
+    TaskDispatcher() = default;
+    ~TaskDispatcher() = default;
+
+    // Any thread; the executor must outlive its use here
+    void setExecutor(Executor* newExecutor) noexcept {
+        executor.store(newExecutor);
+    }
+    bool hasExecutor() const noexcept {
+        return executor.load() != nullptr;
+    }
+
+    // Audio thread. Tasks beyond MAX_TASKS run immediately instead of being queued
+    void add(TaskFunction function, void* context) noexcept;
+    void run() noexcept;
+
+    // Called by the executor's workers
+    void runTask(int index) noexcept;
+
+    int getNumTasks() const noexcept {
+        return numTasks;
+    }
+
+   private:
+    struct Task {
+        TaskFunction function = nullptr;
+        void* context = nullptr;
+    };
+
+    std::array<Task, MAX_TASKS> tasks{};
+    int numTasks = 0;
+    std::atomic<Executor*> executor{nullptr};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TaskDispatcher)
+};
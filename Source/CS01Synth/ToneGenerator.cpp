@@ -1,19 +1,28 @@
 #include "ToneGenerator.h"
+#include "DspProfiler.h"
+#include "../ModulatableParameter.h"
 #include "WaveformStrategies.h"
 #include <cmath>
 
 ToneGenerator::ToneGenerator(juce::AudioProcessorValueTreeState& apvts) : apvts(apvts) {
+    pwmLfo.initialise([&table = sharedTables->pwmTriangle](float x) { return table(x); });
     initializeWaveformStrategies();
+    // Render in fixed chunks even before prepare() sizes the buffer to the host block
+    phaseIncrements.assign(MIN_CHUNK_SIZE, 0.0f);
 }
 
 void ToneGenerator::prepare(const juce::dsp::ProcessSpec& spec) {
     sampleRate = spec.sampleRate;
+    phaseIncrements.assign(juce::jmax<size_t>(MIN_CHUNK_SIZE, spec.maximumBlockSize), 0.0f);
     pwmLfo.prepare(spec);
-    pwmLfo.initialise(
-        [](float x) { return std::asin(std::sin(x)) * (2.0f / juce::MathConstants<float>::pi); },
-        128);
 
     reset();
+
+    // Unlike reset() (a switch back from noise), prepare starts over like a new generator
+    pitchBend = 0.0f;
+    lfoValue = 0.0f;
+    for (auto& [waveform, strategy] : waveformStrategies)
+        strategy->reset();
 }
 
 // INoteHandler interface implementation
@@ -74,15 +83,29 @@ void ToneGenerator::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int
     if (!isActive())
         return;
 
+    CS01_PROFILE_SCOPE(DspStage::ToneGenerator, numSamples);
+
     updateBlockRateParameters();
 
     const int numChannels = outputBuffer.getNumChannels();
 
-    // Fill channel 0 (mono) directly to avoid per-sample per-channel inner loop.
+    jassert(lfoBuffer == nullptr || startSample + numSamples <= lfoBufferSize);
+    const float* lfo = lfoBuffer != nullptr ? lfoBuffer + startSample : nullptr;
+
+    // Fill channel 0 (mono) directly to avoid per-sample per-channel inner loop. Pitch is
+    // worked out for a whole chunk first, so the LFO moves it on every sample
     float* ch0 = outputBuffer.getWritePointer(0, startSample);
-    for (int i = 0; i < numSamples; ++i) {
-        float currentSample = getNextSample();
-        ch0[i] += currentSample; // preserve additive behavior
+    const int chunkSize = static_cast<int>(phaseIncrements.size());
+    jassert(chunkSize > 0);
+    if (chunkSize <= 0) return;
+    for (int offset = 0; offset < numSamples; offset += chunkSize) {
+        const int numChunkSamples = juce::jmin(chunkSize, numSamples - offset);
+        float* increments = phaseIncrements.data();
+        calculatePhaseIncrements(increments, lfo != nullptr ? lfo + offset : nullptr,
+                                 numChunkSamples);
+
+        for (int i = 0; i < numChunkSamples; ++i)
+            ch0[offset + i] += renderSample(increments[i]);  // preserve additive behavior
     }
 
     // Duplicate channel 0 into other channels efficiently
@@ -136,7 +159,22 @@ void ToneGenerator::updateBlockRateParameters() {
 
     // Cache pitch-related parameters to avoid per-sample parameter access
     pitchBendOffset = apvts.getRawParameterValue(ParameterIds::pitchBend)->load();
-    pitchOffset = apvts.getRawParameterValue(ParameterIds::pitch)->load();
+    pitchOffset = ModulatableParameter::getModulatedValue(apvts, ParameterIds::pitch);
+
+    switch (currentFeet) {
+        case Feet::Feet32:
+            octaveOffset = -24.0f;
+            break;
+        case Feet::Feet16:
+            octaveOffset = -12.0f;
+            break;
+        case Feet::Feet4:
+            octaveOffset = 12.0f;
+            break;
+        default:
+            octaveOffset = 0.0f;
+            break;
+    }
 
     // Update waveform strategy based on current waveform
     updateWaveformStrategy();
@@ -202,6 +240,10 @@ void ToneGenerator::calculateSlideParameters(int targetNote) {
 }
 
 float ToneGenerator::getNextSample() {
+    return renderSample(DspKernels::getPhaseIncrement(advancePitch() + lfoValue, 440.0f / sampleRate));
+}
+
+float ToneGenerator::advancePitch() {
     // Handle glissando (discrete semitone steps - remains unchanged)
     if (isSliding) {
         stepCounter++;
@@ -219,40 +261,35 @@ float ToneGenerator::getNextSample() {
         }
     }
 
-    // Calculate final pitch with continuous modulations
-    float finalPitch = currentPitch;  // Base pitch (discrete for glissando)
-
-    // Add continuous pitch modulations (smooth, continuous changes)
-    finalPitch += pitchBend;        // Pitch bend wheel (continuous)
-    finalPitch += pitchBendOffset;  // Pitch bend offset (continuous)
-    finalPitch += pitchOffset;      // Fine pitch adjustment (continuous)
-    finalPitch += lfoValue;         // LFO pitch modulation (continuous)
+    // Base pitch (discrete for glissando) plus pitch bend wheel, pitch bend offset, fine
+    // pitch and octave
+    return currentPitch + pitchBend + pitchBendOffset + pitchOffset + octaveOffset;
+}
 
-    // Add octave offset (discrete, but doesn't affect continuity)
-    int octaveOffset = 0;
-    switch (currentFeet) {
-        case Feet::Feet32:
-            octaveOffset = -24;
-            break;
-        case Feet::Feet16:
-            octaveOffset = -12;
-            break;
-        case Feet::Feet8:
-            octaveOffset = 0;
-            break;
-        case Feet::Feet4:
-            octaveOffset = 12;
-            break;
-        default:
-            break;
+void ToneGenerator::calculatePhaseIncrements(float* increments, const float* lfo,
+                                             int numSamples) {
+    // Pitch in semitones; only the glissando has to be stepped sample by sample
+    if (isSliding) {
+        for (int i = 0; i < numSamples; ++i)
+            increments[i] = advancePitch();
+    } else {
+        juce::FloatVectorOperations::fill(increments, advancePitch(), numSamples);
     }
-    finalPitch += octaveOffset;
 
-    // Generate master square wave with continuous pitch calculation
-    float masterSquare = generateMasterSquareWave(finalPitch);
+    if (lfo != nullptr)
+        juce::FloatVectorOperations::add(increments, lfo, numSamples);
+    else
+        juce::FloatVectorOperations::add(increments, lfoValue, numSamples);
 
-    // Convert to desired waveform
-    return generateVcoSampleFromMaster(masterSquare);
+    // Pitch to phase increment, in place
+    kernels.pitchToPhaseIncrement(increments, numSamples, 440.0f / sampleRate);
+}
+
+float ToneGenerator::renderSample(float increment) {
+    phaseIncrement = increment;
+
+    // Generate master square wave, then convert to desired waveform
+    return generateVcoSampleFromMaster(generateMasterSquareWave());
 }
 
 void ToneGenerator::initializeWaveformStrategies() {
@@ -284,16 +321,16 @@ void ToneGenerator::setLfoValue(float newLfoValue) {
     lfoValue = newLfoValue;
 }
 
+void ToneGenerator::setLfoBuffer(const float* semitones, int numSamples) {
+    lfoBuffer = semitones;
+    lfoBufferSize = semitones != nullptr ? numSamples : 0;
+}
+
 void ToneGenerator::setPitchBend(float bendInSemitones) {
     pitchBend = bendInSemitones;
 }
 
-float ToneGenerator::generateMasterSquareWave(float finalPitch) {
-    // Calculate frequency directly from finalPitch using continuous calculation
-    // This ensures smooth pitch bend and pitch slider operation
-    float frequency = 440.0f * static_cast<float>(std::exp2(static_cast<double>((finalPitch - 69.0f) / 12.0f)));
-    phaseIncrement = frequency / sampleRate;  // Update global phaseIncrement!
-
+float ToneGenerator::generateMasterSquareWave() {
     // Generate master clock square wave (50% duty cycle)
     float t = phase;
     float baseSquare = (t < 0.5f) ? 1.0f : -1.0f;
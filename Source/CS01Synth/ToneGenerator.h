@@ -5,6 +5,8 @@
 #include "SynthConstants.h"
 #include "ISoundGenerator.h"
 #include "IWaveformStrategy.h"
+#include "SharedTables.h"
+#include "DspKernels.h"
 
 /**
  * ToneGenerator - Responsible for sound generation and MIDI note handling
@@ -35,6 +37,7 @@ class ToneGenerator : public ISoundGenerator {
     // Sound generation methods
     float getNextSample();
     void setLfoValue(float lfoValue) override;
+    void setLfoBuffer(const float* semitones, int numSamples) override;
     void setNote(int midiNoteNumber, bool isLegato);
     void setPitchBend(float bendInSemitones);
 
@@ -42,8 +45,13 @@ class ToneGenerator : public ISoundGenerator {
     float generateVcoSampleFromMaster(float masterSquare);
     void calculateSlideParameters(int targetNote);
 
+    // Pitch stage: glissando step plus the offsets that are constant within a block (no LFO)
+    float advancePitch();
+    void calculatePhaseIncrements(float* increments, const float* lfo, int numSamples);
+    float renderSample(float increment);
+
     // Base waveform generation methods
-    float generateMasterSquareWave(float finalPitch);
+    float generateMasterSquareWave();
 
     juce::AudioProcessorValueTreeState& apvts;
 
@@ -76,12 +84,23 @@ class ToneGenerator : public ISoundGenerator {
     float currentModDepth = 0.0f;
     float pitchBendOffset = 0.0f;
     float pitchOffset = 0.0f;
+    float octaveOffset = 0.0f;
     Waveform currentWaveform = Waveform::Sawtooth;
     Feet currentFeet = Feet::Feet8;
 
-    // LFOs
+    // Vector routines for this CPU, chosen on construction
+    const DspKernels& kernels = DspKernels::get();
+
+    // LFOs; the PWM LFO reads its waveform from the shared table
+    juce::SharedResourcePointer<SharedTables> sharedTables;
     juce::dsp::Oscillator<float> pwmLfo;
     float lfoValue = 0.0f;
+    const float* lfoBuffer = nullptr;
+    int lfoBufferSize = 0;
+
+    // Per-sample phase increments for the block being rendered
+    static constexpr size_t MIN_CHUNK_SIZE = 64;
+    std::vector<float> phaseIncrements;
 
     // Waveform Strategy Pattern - simplified with direct mapping
     std::map<Waveform, std::unique_ptr<IWaveformStrategy>> waveformStrategies;
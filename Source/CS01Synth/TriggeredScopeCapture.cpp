@@ -0,0 +1,115 @@
+#include "TriggeredScopeCapture.h"
+
+void TriggeredScopeCapture::prepare(double sampleRate) {
+    // Publish at most ~60 snapshots per second; the display cannot show more
+    holdoffSamples = static_cast<int>(sampleRate / 60.0);
+    autoTimeoutSamples = static_cast<int>(sampleRate / 10.0);
+    reset();
+}
+
+void TriggeredScopeCapture::reset() noexcept {
+    previousSample = 0.0f;
+    armed = false;
+    hasCrossing = false;
+    samplesSinceCrossing = 0.0;
+    lastPeriod = 0.0;
+    holdoffRemaining = 0;
+    samplesWithoutCapture = 0;
+    capturing = false;
+    writePosition = 0;
+}
+
+void TriggeredScopeCapture::process(const float* samples, int numSamples) noexcept {
+    for (int i = 0; i < numSamples; ++i) {
+        const float sample = samples[i];
+
+        if (capturing) {
+            auto& snapshot = slots[static_cast<size_t>(back)];
+            snapshot.samples[static_cast<size_t>(writePosition++)] = sample;
+
+            if (writePosition >= captureLength)
+                publish();
+        }
+
+        samplesSinceCrossing += 1.0;
+
+        if (sample < -HYSTERESIS) {
+            armed = true;
+        } else if (armed && previousSample < 0.0f && sample >= 0.0f) {
+            armed = false;
+
+            // Sub-sample crossing position between the previous sample and this one
+            const float fraction = -previousSample / (sample - previousSample);
+            const double crossingAge = 1.0 - static_cast<double>(fraction);
+
+            if (hasCrossing)
+                lastPeriod = samplesSinceCrossing - crossingAge;
+
+            hasCrossing = true;
+            samplesSinceCrossing = crossingAge;
+
+            if (!capturing && holdoffRemaining <= 0 && lastPeriod > 1.0)
+                startTriggeredCapture(fraction, sample);
+        }
+
+        previousSample = sample;
+
+        if (!capturing) {
+            --holdoffRemaining;
+
+            // Free-run when nothing triggers for a while
+            if (++samplesWithoutCapture >= autoTimeoutSamples)
+                startCapture(UNTRIGGERED_SIZE, 0.0f, 0.0f, 0);
+        }
+    }
+}
+
+void TriggeredScopeCapture::startTriggeredCapture(float fraction, float sample) noexcept {
+    // Whole periods, enough of them to give the display some resolution
+    const int minimumPeriods = static_cast<int>(std::ceil(MIN_CAPTURE_SIZE / lastPeriod));
+    const int maximumPeriods = juce::jmax(1, static_cast<int>(MAX_CAPTURE_SIZE / lastPeriod));
+    const int periods = juce::jmin(
+        juce::jmax(numPeriodsToCapture.load(std::memory_order_relaxed), minimumPeriods),
+        maximumPeriods);
+
+    // Two extra samples: the one before the crossing and one to interpolate the end
+    const int length =
+        juce::jmin(MAX_CAPTURE_SIZE, static_cast<int>(std::ceil(periods * lastPeriod)) + 2);
+
+    startCapture(length, fraction, static_cast<float>(lastPeriod), periods);
+
+    // The crossing lies between the previous sample and this one
+    auto& snapshot = slots[static_cast<size_t>(back)];
+    snapshot.samples[0] = previousSample;
+    snapshot.samples[1] = sample;
+    writePosition = 2;
+}
+
+void TriggeredScopeCapture::startCapture(int length, float offset, float measuredPeriod,
+                                         int periods) noexcept {
+    auto& snapshot = slots[static_cast<size_t>(back)];
+    snapshot.numSamples = length;
+    snapshot.startOffset = offset;
+    snapshot.period = measuredPeriod;
+    snapshot.numPeriods = periods;
+    snapshot.triggered = periods > 0;
+
+    captureLength = length;
+    writePosition = 0;
+    capturing = true;
+    samplesWithoutCapture = 0;
+}
+
+void TriggeredScopeCapture::publish() noexcept {
+    back = middle.exchange(back | FRESH_FLAG, std::memory_order_acq_rel) & INDEX_MASK;
+    capturing = false;
+    holdoffRemaining = holdoffSamples;
+}
+
+const TriggeredScopeCapture::Snapshot* TriggeredScopeCapture::acquireLatest() noexcept {
+    if ((middle.load(std::memory_order_acquire) & FRESH_FLAG) == 0)
+        return nullptr;
+
+    front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+    return &slots[static_cast<size_t>(front)];
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+//==============================================================================
+// Audio-side trigger for the oscilloscope. Rising zero crossings (with
+// hysteresis) are detected on the output, the period is measured between
+// them, and whole periods starting at a crossing are captured into a small
+// snapshot. Snapshots are handed to the message thread through a lock-free
+// triple buffer, so the display is stable and only the captured periods
+// cross threads. Without a trigger (silence, noise) an untriggered snapshot
+// is published after a timeout so the display keeps moving.
+class TriggeredScopeCapture {
+   public:
+    static constexpr int MAX_CAPTURE_SIZE = 4096;
+
+    struct Snapshot {
+        std::array<float, MAX_CAPTURE_SIZE> samples{};
+        int numSamples = 0;
+        float startOffset = 0.0f;  // Fractional position of the crossing within samples[0..1]
+        float period = 0.0f;       // Measured period in samples (0 when untriggered)
+        int numPeriods = 0;
+        bool triggered = false;
+    };
+
+    TriggeredScopeCapture() = default;
+    ~TriggeredScopeCapture() = default;
+
+    void prepare(double sampleRate);
+    void reset() noexcept;
+
+    // Audio thread
+    void process(const float* samples, int numSamples) noexcept;
+
+    // Any thread
+    void setNumPeriods(int newNumPeriods) noexcept {
+        numPeriodsToCapture.store(juce::jlimit(1, 16, newNumPeriods));
+    }
+
+    // Message thread: returns the newest snapshot, or nullptr if nothing new arrived
+    // since the last call. The snapshot stays valid until the next call.
+    const Snapshot* acquireLatest() noexcept;
+
+   private:
+    void startTriggeredCapture(float fraction, float sample) noexcept;
+    void startCapture(int length, float offset, float measuredPeriod, int periods) noexcept;
+    void publish() noexcept;
+
+    static constexpr float HYSTERESIS = 0.01f;
+    static constexpr int MIN_CAPTURE_SIZE = 256;  // Capture more periods for high notes
+    static constexpr int UNTRIGGERED_SIZE = 1024;
+
+    // Triple buffer: producer owns back, consumer owns front, middle is exchanged
+    static constexpr int FRESH_FLAG = 4;
+    static constexpr int INDEX_MASK = 3;
+    std::array<Snapshot, 3> slots;
+    std::atomic<int> middle{1};
+    int back = 0;
+    int front = 2;
+
+    std::atomic<int> numPeriodsToCapture{2};
+
+    // Trigger state (audio thread)
+    float previousSample = 0.0f;
+    bool armed = false;
+    bool hasCrossing = false;
+    double samplesSinceCrossing = 0.0;
+    double lastPeriod = 0.0;
+    int holdoffSamples = 0;
+    int holdoffRemaining = 0;
+    int autoTimeoutSamples = 4800;
+    int samplesWithoutCapture = 0;
+
+    // Capture state (audio thread)
+    bool capturing = false;
+    int captureLength = 0;
+    int writePosition = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TriggeredScopeCapture)
+};
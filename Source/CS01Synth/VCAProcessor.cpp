@@ -1,4 +1,6 @@
 #include "VCAProcessor.h"
+#include "DspProfiler.h"
+#include "../ModulatableParameter.h"
 #include <cmath>
 
 //==============================================================================
@@ -43,6 +45,12 @@ void VCAProcessor::releaseResources() {
     highFreqRolloff.reset();
 }
 
+// The output coupling capacitor is the slowest stage to settle once the input stops
+double VCAProcessor::getTailLengthSeconds() const {
+    const double sampleRate = getSampleRate() > 0.0 ? getSampleRate() : 44100.0;
+    return std::log(1000.0) / (-std::log(static_cast<double>(OUTPUT_COUPLING_POLE)) * sampleRate);
+}
+
 bool VCAProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
     const auto& mainIn = layouts.getChannelSet(true, 0);
     const auto& egIn = layouts.getChannelSet(true, 1);
@@ -59,6 +67,7 @@ bool VCAProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
 }
 
 void VCAProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
+    CS01_PROFILE_SCOPE(DspStage::VCA, buffer.getNumSamples());
     juce::ScopedNoDenormals noDenormals;
 
     // CS01 is a mono synth, so only process mono buffers (channel 0)
@@ -69,7 +78,7 @@ void VCAProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuff
     auto egDepth = apvts.getRawParameterValue(ParameterIds::vcaEgDepth)->load();
     auto breathInput = apvts.getRawParameterValue(ParameterIds::breathInput)->load();
     auto breathVcaDepth = apvts.getRawParameterValue(ParameterIds::breathVca)->load();
-    auto volume = apvts.getRawParameterValue(ParameterIds::volume)->load();
+    auto volume = ModulatableParameter::getModulatedValue(apvts, ParameterIds::volume);
     // Precompute nonlinear volume curve once per block
     float volumeGain = std::pow(volume, 2.5f);
 
@@ -78,8 +87,11 @@ void VCAProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuff
     const auto* egData = egInput.getReadPointer(0);
     auto* outputData = buffer.getWritePointer(0);
 
-    // Process each sample
-    for (int sample = 0; sample < buffer.getNumSamples(); ++sample) {
+    const int numSamples = buffer.getNumSamples();
+
+    // The stateless VCA stage runs on whole blocks between the filter stages, in place
+    // (the audio input and the output share channel 0)
+    for (int sample = 0; sample < numSamples; ++sample) {
         // TP3: Get input sample
         float inputSample = audioData[sample];
 
@@ -87,20 +99,16 @@ void VCAProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuff
         inputSample = inputHighPass.processSample(inputSample);
 
         // Apply DC blocking (additional safety)
-        inputSample = dcBlocker.processSample(inputSample);
-
-        // Get EG value
-        float egValue = egData[sample];
-
-        // Calculate control voltage for VCA
-        float controlVoltage = (1.0f - egDepth) + (egValue * egDepth);
-        controlVoltage *= (1.0f - breathVcaDepth) + (breathInput * breathVcaDepth);
+        outputData[sample] = dcBlocker.processSample(inputSample);
+    }
 
-        // Process through IG02600 VCA chip emulation
-        float outputSample = processVCA(inputSample, controlVoltage, volumeGain);
+    // Control voltage from the EG and breath, then the IG02600 VCA chip emulation
+    const float breathGain = (1.0f - breathVcaDepth) + (breathInput * breathVcaDepth);
+    kernels.applyVCAGain(outputData, egData, numSamples, egDepth, breathGain, volumeGain);
 
+    for (int sample = 0; sample < numSamples; ++sample) {
         // Process through Tr7 transistor buffer emulation
-        outputSample = processTr7Buffer(outputSample);
+        float outputSample = processTr7Buffer(outputData[sample]);
 
         // Process through output coupling capacitor (4.7/25)
         outputSample = processOutputCoupling(outputSample);
@@ -113,26 +121,6 @@ void VCAProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuff
     }
 }
 
-// IG02600 VCA chip emulation
-float VCAProcessor::processVCA(float input, float controlVoltage, float volumeGain) {
-    // volumeGain is precomputed nonlinear volume curve (PVR5)
-    // Calculate gain based on control voltage and volume
-    float gain = controlVoltage * volumeGain;
-
-    // Apply gain
-    float output = input * gain;
-
-    // Emulate IG02600 VCA non-linear response
-    if (std::abs(output) > 0.7f) {
-        // Soft saturation for higher levels
-        float sign = (output > 0.0f) ? 1.0f : -1.0f;
-        float excess = std::abs(output) - 0.7f;
-        output = sign * (0.7f + excess / (1.0f + excess * 0.5f));
-    }
-
-    return output;
-}
-
 // Tr7 transistor buffer emulation
 float VCAProcessor::processTr7Buffer(float input) {
     // Output coupling capacitor (1/50) - high-pass characteristic
@@ -161,7 +149,7 @@ float VCAProcessor::processTr7Buffer(float input) {
 // Output coupling capacitor emulation (4.7/25)
 float VCAProcessor::processOutputCoupling(float input) {
     // Output coupling capacitor - high-pass characteristic (~7Hz)
-    const float rc3 = 0.9995f;  // Time constant based on component values
+    const float rc3 = OUTPUT_COUPLING_POLE;  // Time constant based on component values
     outCapacitorState = outCapacitorState * rc3 + input * (1.0f - rc3);
 
     return input - outCapacitorState;
@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "../Parameters.h"
+#include "DspKernels.h"
 
 //==============================================================================
 class VCAProcessor : public juce::AudioProcessor {
@@ -40,9 +41,7 @@ class VCAProcessor : public juce::AudioProcessor {
     bool isMidiEffect() const override {
         return false;
     }
-    double getTailLengthSeconds() const override {
-        return 0.0;
-    }
+    double getTailLengthSeconds() const override;
 
     //==============================================================================
     int getNumPrograms() override {
@@ -74,14 +73,15 @@ class VCAProcessor : public juce::AudioProcessor {
     // Simple high frequency rolloff filter
     juce::dsp::IIR::Filter<float> highFreqRolloff;
 
-    // IG02600 VCA chip emulation
-    float processVCA(float input, float controlVoltage, float volumeParam);
+    // IG02600 VCA chip emulation (DspKernels::applyVCAGain)
+    const DspKernels& kernels = DspKernels::get();
 
     // Tr7 transistor buffer emulation
     float processTr7Buffer(float input);
 
     // Output coupling capacitor emulation
     float processOutputCoupling(float input);
+    static constexpr float OUTPUT_COUPLING_POLE = 0.9995f;  // Per sample; ~7 Hz high-pass
 
     // State variables for analog circuit emulation
     float capacitorState = 0.0f;
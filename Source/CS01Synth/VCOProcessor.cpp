@@ -1,15 +1,18 @@
 #include "VCOProcessor.h"
+#include "DspProfiler.h"
 #include "SynthConstants.h"
 
-VCOProcessor::VCOProcessor(juce::AudioProcessorValueTreeState& vts, bool isNoiseMode)
+VCOProcessor::VCOProcessor(juce::AudioProcessorValueTreeState& vts, bool isNoiseMode,
+                           bool createNoiseOnDemand)
     : AudioProcessor(BusesProperties()
                          .withInput("LFOInput", juce::AudioChannelSet::mono(), true)
                          .withOutput("Output", juce::AudioChannelSet::mono(), true)),
       apvts(vts),
       toneGenerator(std::make_unique<ToneGenerator>(apvts)),
-      noiseGenerator(std::make_unique<NoiseGenerator>(apvts)),
-      currentGenerator(nullptr)  // Will be set in parameterChanged
-{
+      noiseOnDemand(createNoiseOnDemand) {
+    if (!noiseOnDemand || isNoiseMode)
+        createNoiseGenerator();
+
     // Register as listener for feet parameter
     apvts.addParameterListener(ParameterIds::feet, this);
 
@@ -40,50 +43,114 @@ void VCOProcessor::parameterChanged(const juce::String& parameterID, float newVa
             dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(ParameterIds::feet));
         if (feetParam != nullptr) {
             bool isNoiseMode = (feetParam->getIndex() == static_cast<int>(Feet::WhiteNoise));
-            ISoundGenerator* oldGenerator = currentGenerator;
-            ISoundGenerator* newGenerator = nullptr;
+
+            if (isNoiseMode && noise.load() == nullptr) {
+                // Creating it allocates; from the audio thread it waits for the message thread
+                if (isPrepared && !canCreateGenerators()) {
+                    noiseGeneratorRequested.store(true);
+                    return;
+                }
+                createNoiseGenerator();
+            } else if (!isNoiseMode) {
+                noiseGeneratorRequested.store(false);
+            }
 
             if (isNoiseMode)
-                newGenerator = static_cast<ISoundGenerator*>(noiseGenerator.get());
+                selectGenerator(noise.load());
             else
-                newGenerator = static_cast<ISoundGenerator*>(toneGenerator.get());
+                selectGenerator(toneGenerator.get());
+        }
+    }
+}
 
-            if (oldGenerator == newGenerator)
-                return;
+void VCOProcessor::selectGenerator(ISoundGenerator* generator) {
+    // Once prepared, processBlock may be rendering the current generator right now
+    if (isPrepared)
+        requestedGenerator.store(generator, std::memory_order_release);
+    else
+        switchGenerator(generator);
+}
 
-            // Save current state before switching
-            bool wasActive = false;
-            int currentNote = 0;
-            float velocity = 1.0f;
-            int pitchWheel = 8192;  // center position
+void VCOProcessor::switchGenerator(ISoundGenerator* newGenerator) {
+    ISoundGenerator* oldGenerator = currentGenerator.load(std::memory_order_relaxed);
+    if (oldGenerator == newGenerator)
+        return;
 
-            if (oldGenerator && oldGenerator->isActive()) {
-                wasActive = true;
-                currentNote = oldGenerator->getCurrentlyPlayingNote();
-            }
+    // Save current state before switching
+    bool wasActive = false;
+    int currentNote = 0;
+    float velocity = 1.0f;
+    int pitchWheel = 8192;  // center position
+
+    if (oldGenerator && oldGenerator->isActive()) {
+        wasActive = true;
+        currentNote = oldGenerator->getCurrentlyPlayingNote();
+    }
 
-            // Switch generator
-            currentGenerator = newGenerator;
+    // Both generators were prepared in prepareToPlay; preparing again here would
+    // allocate on the audio thread when the switch comes from automation
+    if (isPrepared && newGenerator == toneGenerator.get())
+        toneGenerator->reset();
 
-            // Initialize if already prepared
-            if (isPrepared && currentGenerator)
-                currentGenerator->prepare(lastSpec);
+    // Transfer state to new generator if needed
+    if (wasActive && newGenerator != nullptr)
+        newGenerator->startNote(currentNote, velocity, pitchWheel);
 
-            // Transfer state to new generator if needed
-            if (wasActive && currentGenerator != nullptr)
-                currentGenerator->startNote(currentNote, velocity, pitchWheel);
+    // Switch generator
+    currentGenerator.store(newGenerator, std::memory_order_release);
 
-            if (onGeneratorTypeChanged)
-                onGeneratorTypeChanged();
-        }
-    }
+    if (onGeneratorTypeChanged)
+        onGeneratorTypeChanged();
+}
+
+// Allocating is fine on the message thread, and in a headless render that has no
+// message thread; anywhere else this may be the audio thread
+bool VCOProcessor::canCreateGenerators() {
+    const auto* messageManager = juce::MessageManager::getInstanceWithoutCreating();
+    return messageManager == nullptr || messageManager->isThisTheMessageThread();
+}
+
+void VCOProcessor::createNoiseGenerator() {
+    noiseGenerator = std::make_unique<NoiseGenerator>(apvts);
+
+    if (isPrepared)
+        noiseGenerator->prepare(lastSpec);
+
+    if (noiseSeed.has_value())
+        noiseGenerator->setSeed(*noiseSeed);
+
+    // The audio thread only sees it complete
+    noise.store(noiseGenerator.get(), std::memory_order_release);
+}
+
+bool VCOProcessor::createPendingNoiseGenerator() {
+    if (!noiseGeneratorRequested.exchange(false) || noise.load() != nullptr)
+        return false;
+
+    createNoiseGenerator();
+
+    // Switch now if white noise is still selected
+    if (auto* feetParam =
+            dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(ParameterIds::feet)))
+        parameterChanged(ParameterIds::feet, static_cast<float>(feetParam->getIndex()));
+
+    return true;
+}
+
+void VCOProcessor::setNoiseSeed(juce::int64 seed) {
+    noiseSeed = seed;
+
+    if (noiseGenerator)
+        noiseGenerator->setSeed(seed);
 }
 
 void VCOProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
     lastSpec = {sampleRate, (juce::uint32)samplesPerBlock,
                 (juce::uint32)getTotalNumOutputChannels()};
 
-    // Prepare both generators
+    lfoPitch.assign(static_cast<size_t>(juce::jmax(1, samplesPerBlock)), 0.0f);
+
+    // Prepare both generators (the noise generator only if it exists yet)
     if (toneGenerator)
         toneGenerator->prepare(lastSpec);
 
@@ -91,6 +158,13 @@ void VCOProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
         noiseGenerator->prepare(lastSpec);
 
     isPrepared = true;
+
+    // Never called on the audio thread, so a switch to noise that is still waiting for its
+    // generator completes here, and so does a switch waiting for processBlock
+    createPendingNoiseGenerator();
+
+    if (auto* requested = requestedGenerator.exchange(nullptr, std::memory_order_acquire))
+        switchGenerator(requested);
 }
 
 bool VCOProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
@@ -109,35 +183,52 @@ bool VCOProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
 }
 
 void VCOProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi) {
-    if (!currentGenerator) {
+    CS01_PROFILE_SCOPE(DspStage::VCO, buffer.getNumSamples());
+
+    if (auto* requested = requestedGenerator.exchange(nullptr, std::memory_order_acquire))
+        switchGenerator(requested);
+
+    auto* generator = currentGenerator.load(std::memory_order_relaxed);
+    if (!generator) {
         return;
     }
 
     // Process audio block - CS01 is a mono synth, so processing is simplified
 
     // Process LFO input for Tone generator
-    if (currentGenerator == toneGenerator.get()) {
-        // LFO input is always mono (channel 0)
+    if (generator == toneGenerator.get()) {
+        // LFO input is always mono (channel 0). It shares the channel with the output, so
+        // it is scaled to semitones in a buffer of its own before the output is cleared
         auto lfoInput = getBusBuffer(buffer, true, 0);
-        lfoValue = lfoInput.getNumSamples() > 0 ? lfoInput.getSample(0, 0) : 0.0f;
+        const int numLfoSamples = lfoInput.getNumChannels() > 0 ? lfoInput.getNumSamples() : 0;
 
         auto modDepth = apvts.getRawParameterValue(ParameterIds::modDepth)->load();
         const float lfoModRangeSemitones = 1.0f;
-        float finalLfoValue = lfoValue * modDepth * lfoModRangeSemitones;
-
-        // Set LFO value directly to the tone generator
-        toneGenerator->setLfoValue(finalLfoValue);
+        const float lfoScale = modDepth * lfoModRangeSemitones;
+
+        if (numLfoSamples > 0 && numLfoSamples <= static_cast<int>(lfoPitch.size())) {
+            juce::FloatVectorOperations::copyWithMultiply(
+                lfoPitch.data(), lfoInput.getReadPointer(0), lfoScale, numLfoSamples);
+            toneGenerator->setLfoBuffer(lfoPitch.data(), numLfoSamples);
+        } else {
+            // Larger than prepared for: hold the first LFO sample for the block
+            toneGenerator->setLfoBuffer(nullptr, 0);
+            toneGenerator->setLfoValue(numLfoSamples > 0 ? lfoInput.getSample(0, 0) * lfoScale
+                                                         : 0.0f);
+        }
     }
 
     // Clear the buffer
     buffer.clear();
 
     // Sound generation using the current generator
-    if (currentGenerator->isActive()) {
+    if (generator->isActive()) {
         // Process mono output
-        currentGenerator->renderNextBlock(buffer, 0, buffer.getNumSamples());
+        generator->renderNextBlock(buffer, 0, buffer.getNumSamples());
     }
     // If not active, buffer remains cleared
 
+    toneGenerator->setLfoBuffer(nullptr, 0);
+
     // Pass MIDI buffer through (processing is done in MidiProcessor)
 }
@@ -1,5 +1,7 @@
 #pragma once
 #include <JuceHeader.h>
+#include <atomic>
+#include <optional>
 #include "ToneGenerator.h"
 #include "NoiseGenerator.h"
 #include "ISoundGenerator.h"
@@ -11,11 +13,20 @@
  * This class can hold different sound generators (ToneGenerator, NoiseGenerator)
  * and processes LFO input to generate sound.
  * MIDI processing is delegated to the MidiProcessor class.
+ *
+ * With createNoiseOnDemand, the NoiseGenerator only exists once white noise has
+ * been selected. A selection on the message thread creates it at once; one from the
+ * audio thread keeps the tone generator until createPendingNoiseGenerator() has run
+ * on the message thread (or the next prepareToPlay has created it).
+ *
+ * After prepareToPlay the generator switch itself is made at the start of the next
+ * processBlock, so the generators are only touched by the audio thread.
  */
 class VCOProcessor : public juce::AudioProcessor,
                      public juce::AudioProcessorValueTreeState::Listener {
    public:
-    VCOProcessor(juce::AudioProcessorValueTreeState& vts, bool isNoiseMode = false);
+    VCOProcessor(juce::AudioProcessorValueTreeState& vts, bool isNoiseMode = false,
+                 bool createNoiseOnDemand = false);
     ~VCOProcessor() override;
 
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
@@ -63,23 +74,47 @@ class VCOProcessor : public juce::AudioProcessor,
 
     // Accessor for sound generator interface
     ISoundGenerator* getSoundGenerator() {
-        return currentGenerator;
+        return currentGenerator.load(std::memory_order_acquire);
     }
 
     // Method to notify when generator type changes (for external use)
     std::function<void()> onGeneratorTypeChanged;
 
-    // Check if noise generator is active
+    // Seeds the noise generator so noise renders are reproducible (also one created later)
+    void setNoiseSeed(juce::int64 seed);
+
+    // Check if noise generator is selected (a switch waiting for processBlock counts)
     bool isNoiseMode() const {
-        return currentGenerator == noiseGenerator.get();
+        auto* selected = requestedGenerator.load(std::memory_order_acquire);
+        if (selected == nullptr)
+            selected = currentGenerator.load(std::memory_order_acquire);
+        return selected != nullptr && selected == noise.load(std::memory_order_acquire);
+    }
+
+    // Message thread: creates the noise generator a switch to white noise is waiting for.
+    // Returns true if it did
+    bool createPendingNoiseGenerator();
+
+    bool hasNoiseGenerator() const {
+        return noise.load(std::memory_order_acquire) != nullptr;
     }
 
    private:
+    void createNoiseGenerator();
+    void selectGenerator(ISoundGenerator* generator);
+    void switchGenerator(ISoundGenerator* newGenerator);
+    static bool canCreateGenerators();
+
     juce::AudioProcessorValueTreeState& apvts;
     std::unique_ptr<ToneGenerator> toneGenerator;
-    std::unique_ptr<NoiseGenerator> noiseGenerator;
-    ISoundGenerator* currentGenerator;  // Pointer to the currently selected generator
+    std::unique_ptr<NoiseGenerator> noiseGenerator;  // Owner, changed off the audio thread
+    std::atomic<NoiseGenerator*> noise{nullptr};     // Published once created
+    std::atomic<ISoundGenerator*> currentGenerator{nullptr};
+    std::atomic<ISoundGenerator*> requestedGenerator{nullptr};  // Switch for processBlock
+    const bool noiseOnDemand;
+    std::atomic<bool> noiseGeneratorRequested{false};
+    std::optional<juce::int64> noiseSeed;
     juce::dsp::ProcessSpec lastSpec;
     bool isPrepared = false;
-    float lfoValue = 0.0f;
+    std::vector<float> lfoPitch;  // LFO pitch modulation in semitones, per sample
 };
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+#if CS01_CLAP_DIRECT_PROCESS
+#include <clap-juce-extensions/clap-juce-extensions.h>
+#endif
+
+//==============================================================================
+// A float parameter that also takes non-destructive modulation (CLAP parameter
+// modulation). The modulation is an offset in normalised units that the DSP adds
+// when it reads the parameter; the value itself, and with it automation, presets
+// and the UI, is left alone.
+class ModulatableParameter : public juce::AudioParameterFloat
+#if CS01_CLAP_DIRECT_PROCESS
+    , public clap_juce_extensions::clap_juce_parameter_capabilities
+#endif
+{
+   public:
+    using juce::AudioParameterFloat::AudioParameterFloat;
+
+    void setModulation(float normalisedOffset) noexcept {
+        modulation.store(normalisedOffset, std::memory_order_relaxed);
+    }
+    float getModulation() const noexcept {
+        return modulation.load(std::memory_order_relaxed);
+    }
+
+    // Value with the modulation applied, in the parameter's own units
+    float getModulatedValue() const noexcept {
+        const float offset = getModulation();
+        if (offset == 0.0f)
+            return get();
+        return convertFrom0to1(juce::jlimit(0.0f, 1.0f, getValue() + offset));
+    }
+
+    // Reads a parameter including its modulation; plain parameters (as in tests that
+    // build their own layout) are read as they are
+    static float getModulatedValue(juce::AudioProcessorValueTreeState& apvts,
+                                   const juce::String& parameterID) {
+        if (auto* parameter = dynamic_cast<ModulatableParameter*>(apvts.getParameter(parameterID)))
+            return parameter->getModulatedValue();
+        return apvts.getRawParameterValue(parameterID)->load();
+    }
+
+#if CS01_CLAP_DIRECT_PROCESS
+    bool supportsMonophonicModulation() override {
+        return true;
+    }
+    void applyMonophonicModulation(double amount) override {
+        setModulation(static_cast<float>(amount));
+    }
+#endif
+
+   private:
+    std::atomic<float> modulation{0.0f};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModulatableParameter)
+};
@@ -0,0 +1,337 @@
+#include "MultisampleExporter.h"
+#include "Parameters.h"
+#include <algorithm>
+#include <set>
+
+namespace {
+bool isUpwardZeroCrossing(const float* samples, int index) {
+    return samples[index - 1] < 0.0f && samples[index] >= 0.0f;
+}
+
+float getParameter(const RenderCache::ParameterSnapshot& snapshot, const juce::String& id) {
+    const auto value = snapshot.find(id);
+    return value != snapshot.end() ? value->second : 0.0f;
+}
+}  // namespace
+
+struct MultisampleExporter::Program {
+    struct Sample {
+        Zone zone;
+        int lowVelocity = 1;
+        int highVelocity = 127;
+        RenderCache::RenderPtr render;
+    };
+
+    juce::String name;
+    juce::String fileName;
+    double releaseSeconds = 0.0;
+    int settleSample = 0;
+    int noteOffSample = 0;
+    std::vector<Sample> samples;
+};
+
+//==============================================================================
+MultisampleExporter::MultisampleExporter(const Settings& settingsToUse) : settings(settingsToUse) {}
+
+std::vector<MultisampleExporter::Zone> MultisampleExporter::createZones(int lowestNote,
+                                                                        int highestNote,
+                                                                        int noteStep) {
+    std::vector<int> roots;
+    for (int note = juce::jlimit(0, 127, lowestNote); note <= juce::jlimit(0, 127, highestNote);
+         note += juce::jmax(1, noteStep))
+        roots.push_back(note);
+
+    // Each root covers the keys up to half way to the next one
+    std::vector<Zone> zones;
+    for (size_t i = 0; i < roots.size(); ++i) {
+        const int lowKey = i == 0 ? 0 : zones.back().highKey + 1;
+        const int highKey =
+            i + 1 == roots.size() ? 127 : roots[i] + (roots[i + 1] - roots[i] - 1) / 2;
+        zones.push_back({roots[i], lowKey, highKey});
+    }
+    return zones;
+}
+
+MultisampleExporter::LoopPoints MultisampleExporter::findSustainLoop(const float* samples,
+                                                                     int settleSample,
+                                                                     int noteOffSample,
+                                                                     double sampleRate) {
+    const int minLoopLength = juce::roundToInt(MIN_LOOP_SECONDS * sampleRate);
+    const int lastCandidate = noteOffSample - LOOP_MATCH_WINDOW;
+    const int firstCandidate =
+        juce::jmax(settleSample + minLoopLength,
+                   lastCandidate - juce::roundToInt(LOOP_SEARCH_SECONDS * sampleRate));
+
+    if (settleSample < 1 || firstCandidate > lastCandidate)
+        return {};
+
+    // The sustain has to be audible, not the end of a decay
+    float peak = 0.0f;
+    for (int i = 0; i < noteOffSample; ++i)
+        peak = juce::jmax(peak, std::abs(samples[i]));
+
+    int start = settleSample;
+    while (start < firstCandidate && !isUpwardZeroCrossing(samples, start))
+        ++start;
+    if (start + minLoopLength > lastCandidate)
+        return {};
+
+    double startEnergy = 0.0;
+    for (int i = 0; i < LOOP_MATCH_WINDOW; ++i)
+        startEnergy += static_cast<double>(samples[start + i]) * samples[start + i];
+
+    const double minEnergy =
+        LOOP_MATCH_WINDOW * juce::square(peak * juce::Decibels::decibelsToGain(MIN_LOOP_LEVEL_DB));
+    if (peak <= 0.0f || startEnergy < minEnergy)
+        return {};
+
+    // Playback jumps from the end back to the start, so what follows the end should
+    // continue like what follows the start
+    int bestEnd = -1;
+    double bestError = MAX_LOOP_ERROR;
+    for (int end = firstCandidate; end <= lastCandidate; ++end) {
+        if (!isUpwardZeroCrossing(samples, end))
+            continue;
+
+        double difference = 0.0;
+        for (int i = 0; i < LOOP_MATCH_WINDOW; ++i)
+            difference += juce::square(static_cast<double>(samples[end + i]) - samples[start + i]);
+
+        const double error = difference / startEnergy;
+        if (error <= bestError) {
+            bestError = error;
+            bestEnd = end;
+        }
+    }
+
+    if (bestEnd < 0)
+        return {};
+    return {start, bestEnd - 1};
+}
+
+int MultisampleExporter::findTrimmedLength(const float* samples, int numSamples,
+                                           float thresholdDb) {
+    float peak = 0.0f;
+    for (int i = 0; i < numSamples; ++i)
+        peak = juce::jmax(peak, std::abs(samples[i]));
+
+    const float threshold = peak * juce::Decibels::decibelsToGain(thresholdDb);
+    int length = numSamples;
+    while (length > 1 && std::abs(samples[length - 1]) <= threshold)
+        --length;
+    return length;
+}
+
+//==============================================================================
+std::vector<MultisampleExporter::ProgramResult> MultisampleExporter::exportPrograms(
+    const juce::File& outputDirectory, std::vector<int> programIndices) {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    // ProgramManager turns each program into a parameter snapshot
+    OfflineRenderer programLoader(settings.sampleRate);
+    auto& processor = programLoader.getProcessor();
+
+    if (programIndices.empty()) {
+        for (int i = 0; i < processor.getNumPrograms(); ++i)
+            programIndices.push_back(i);
+    }
+
+    const auto zones = createZones(settings.lowestNote, settings.highestNote, settings.noteStep);
+    auto layers = settings.velocityLayers;
+    std::sort(layers.begin(), layers.end());
+    if (layers.empty())
+        layers.push_back(1.0f);
+
+    std::vector<Program> programs;
+    std::vector<RenderCache::Request> requests;
+    std::set<juce::String> usedFileNames;
+
+    for (int index : programIndices) {
+        programLoader.loadProgram(index);
+        const auto snapshot = programLoader.getParameterSnapshot();
+
+        Program program;
+        program.name = processor.getProgramName(index);
+        program.fileName = juce::File::createLegalFileName(program.name).replaceCharacter(' ', '_');
+        if (!usedFileNames.insert(program.fileName).second)
+            program.fileName << "_" << index;
+
+        // The tail is sized from the EG release; the loop may start once attack and decay
+        // are over
+        const double release = getParameter(snapshot, ParameterIds::release);
+        const double attackAndDecay = getParameter(snapshot, ParameterIds::attack) +
+                                      getParameter(snapshot, ParameterIds::decay);
+        program.releaseSeconds = juce::jlimit(0.0, settings.maxReleaseSeconds, release);
+        program.settleSample =
+            juce::roundToInt((attackAndDecay + LOOP_SETTLE_SECONDS) * settings.sampleRate);
+        program.noteOffSample = juce::roundToInt(settings.holdSeconds * settings.sampleRate);
+
+        for (const auto& zone : zones) {
+            int lowVelocity = 1;
+            for (size_t layer = 0; layer < layers.size(); ++layer) {
+                const int highVelocity =
+                    layer + 1 == layers.size()
+                        ? 127
+                        : juce::jlimit(lowVelocity, 127, juce::roundToInt(layers[layer] * 127.0f));
+
+                RenderCache::Request request;
+                request.parameters = snapshot;
+                request.note.noteNumber = zone.rootNote;
+                request.note.velocity = static_cast<float>(highVelocity) / 127.0f;
+                request.note.holdSeconds = settings.holdSeconds;
+                request.note.releaseSeconds = program.releaseSeconds + TAIL_MARGIN_SECONDS;
+                requests.push_back(std::move(request));
+
+                program.samples.push_back({zone, lowVelocity, highVelocity, nullptr});
+                lowVelocity = juce::jmin(127, highVelocity + 1);
+            }
+        }
+
+        programs.push_back(std::move(program));
+    }
+
+    // One batch for every program, so the renders run in parallel across programs
+    const auto cacheDirectory = settings.cacheDirectory != juce::File()
+                                    ? settings.cacheDirectory
+                                    : juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                          .getChildFile("CheapSynth01RenderCache");
+    RenderCache cache(cacheDirectory, settings.sampleRate, settings.numWorkers);
+    const auto renders = cache.get(requests);
+
+    size_t renderIndex = 0;
+    for (auto& program : programs) {
+        for (auto& sample : program.samples)
+            sample.render = renders[renderIndex++];
+    }
+
+    // Trimming, looping and writing need no processor; run them on a pool as well
+    outputDirectory.createDirectory();
+    std::vector<ProgramResult> results(programs.size());
+    std::atomic<int> numRemaining{static_cast<int>(programs.size())};
+    juce::WaitableEvent allFinished;
+    juce::ThreadPool pool(juce::jmax(1, settings.numWorkers));
+
+    for (size_t i = 0; i < programs.size(); ++i) {
+        pool.addJob([this, i, &programs, &results, &outputDirectory, &numRemaining, &allFinished] {
+            results[i] = writeProgram(programs[i], outputDirectory);
+            if (--numRemaining == 0)
+                allFinished.signal();
+        });
+    }
+
+    if (!programs.empty())
+        allFinished.wait();
+
+    return results;
+}
+
+MultisampleExporter::ProgramResult MultisampleExporter::writeProgram(
+    const Program& program, const juce::File& outputDirectory) const {
+    ProgramResult result;
+    result.name = program.name;
+    result.sfzFile = outputDirectory.getChildFile(program.fileName + ".sfz");
+
+    const auto sampleDirectory = outputDirectory.getChildFile(program.fileName);
+    if (!sampleDirectory.createDirectory()) {
+        result.error = "Cannot create " + sampleDirectory.getFullPathName();
+        return result;
+    }
+
+    const int fadeLength = juce::roundToInt(FADE_OUT_SECONDS * settings.sampleRate);
+    juce::String regions;
+
+    for (const auto& sample : program.samples) {
+        if (sample.render == nullptr) {
+            result.error = "Render failed for note " + juce::String(sample.zone.rootNote);
+            return result;
+        }
+
+        std::vector<float> audio(sample.render->getSamples(),
+                                 sample.render->getSamples() + sample.render->getNumSamples());
+
+        const auto loop =
+            findSustainLoop(audio.data(), program.settleSample,
+                            juce::jmin(program.noteOffSample, static_cast<int>(audio.size())),
+                            settings.sampleRate);
+
+        // Trim the silent end of the tail, then fade out what is left of it
+        int length = findTrimmedLength(audio.data(), static_cast<int>(audio.size()),
+                                       settings.trimThresholdDb);
+        if (loop.isValid())
+            length = juce::jmax(length, loop.end + 1);
+        audio.resize(static_cast<size_t>(length));
+
+        const int fadeStart = juce::jmax(loop.isValid() ? loop.end + 1 : 0, length - fadeLength);
+        for (int i = fadeStart; i < length; ++i)
+            audio[static_cast<size_t>(i)] *= static_cast<float>(length - i) / (length - fadeStart);
+
+        const auto noteName =
+            juce::MidiMessage::getMidiNoteName(sample.zone.rootNote, true, true, 3);
+        const auto wavName = program.fileName + "_" + noteName + "_v" +
+                             juce::String(sample.highVelocity) + ".wav";
+
+        if (!writeWav(sampleDirectory.getChildFile(wavName), audio.data(), length,
+                      sample.zone.rootNote, loop)) {
+            result.error = "Cannot write " + wavName;
+            return result;
+        }
+
+        regions << "<region> sample=" << wavName << " pitch_keycenter=" << sample.zone.rootNote
+                << " lokey=" << sample.zone.lowKey << " hikey=" << sample.zone.highKey
+                << " lovel=" << sample.lowVelocity << " hivel=" << sample.highVelocity;
+
+        if (loop.isValid()) {
+            regions << " loop_mode=loop_sustain loop_start=" << loop.start
+                    << " loop_end=" << loop.end;
+            ++result.numLooped;
+        } else {
+            regions << " loop_mode=no_loop";
+        }
+
+        regions << "\n";
+        ++result.numSamples;
+    }
+
+    juce::String sfz;
+    sfz << "// " << program.name << "\n"
+        << "// Sampled from CheapSynth01 at " << juce::roundToInt(settings.sampleRate) << " Hz\n\n"
+        << "<control>\n"
+        << "default_path=" << program.fileName << "/\n\n"
+        << "<global>\n"
+        << "ampeg_release=" << juce::String(program.releaseSeconds, 3) << "\n\n"
+        << regions;
+
+    if (!result.sfzFile.replaceWithText(sfz))
+        result.error = "Cannot write " + result.sfzFile.getFullPathName();
+
+    return result;
+}
+
+bool MultisampleExporter::writeWav(const juce::File& file, const float* samples, int numSamples,
+                                   int rootNote, const LoopPoints& loop) const {
+    // Root note and loop go into the smpl chunk for samplers that ignore the SFZ
+    juce::StringPairArray metadata;
+    metadata.set("MidiUnityNote", juce::String(rootNote));
+    metadata.set("NumSampleLoops", loop.isValid() ? "1" : "0");
+    if (loop.isValid()) {
+        metadata.set("Loop0Type", "0");  // Forward
+        metadata.set("Loop0Start", juce::String(loop.start));
+        metadata.set("Loop0End", juce::String(loop.end));
+    }
+
+    file.deleteFile();
+    auto stream = std::make_unique<juce::FileOutputStream>(file);
+    if (!stream->openedOk())
+        return false;
+
+    juce::WavAudioFormat format;
+    std::unique_ptr<juce::AudioFormatWriter> writer(format.createWriterFor(
+        stream.get(), settings.sampleRate, 1, settings.bitsPerSample, metadata, 0));
+    if (writer == nullptr)
+        return false;
+
+    stream.release();  // Owned by the writer now
+
+    const float* channels[] = {samples};
+    return writer->writeFromFloatArrays(channels, 1, numSamples);
+}
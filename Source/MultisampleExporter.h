@@ -0,0 +1,98 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include "RenderCache.h"
+
+//==============================================================================
+// Samples every program into a WAV + SFZ multisample set, for platforms that
+// cannot host the plugin.
+//
+// Each program is loaded through ProgramManager and rendered headless (via
+// RenderCache, so re-exports only render what changed) at every sampled note
+// and velocity layer. Renders of all programs go into one batch, so they run
+// in parallel across programs; trimming, looping and file writing are spread
+// over a thread pool per program.
+//
+// - Tails: the note is held, then rendered for the EG release time plus a
+//   margin, and trimmed at the point it falls below the trim threshold
+// - Loops: where the held part settles into a steady tone, a sustain loop is
+//   placed between matching upward zero crossings; noisy or strongly modulated
+//   programs stay one-shot
+// - Output: <directory>/<program>.sfz with its samples in <directory>/<program>/;
+//   loop points are also written to the WAV smpl chunk
+//
+// Call from the message thread.
+class MultisampleExporter {
+   public:
+    struct Settings {
+        double sampleRate = 48000.0;
+        int lowestNote = 24;   // C1
+        int highestNote = 96;  // C7
+        int noteStep = 3;      // Sample every minor third
+        std::vector<float> velocityLayers{1.0f};  // Upper velocity of each layer, ascending
+        double holdSeconds = 2.0;
+        double maxReleaseSeconds = 10.0;
+        float trimThresholdDb = -80.0f;  // Relative to the sample's peak
+        int bitsPerSample = 24;
+        int numWorkers = juce::SystemStats::getNumCpus();
+        juce::File cacheDirectory;  // Defaults to a folder in the temp directory
+    };
+
+    struct LoopPoints {
+        int start = 0;
+        int end = 0;  // Last sample of the loop (inclusive, as in SFZ)
+        bool isValid() const noexcept {
+            return end > start;
+        }
+    };
+
+    struct ProgramResult {
+        juce::String name;
+        juce::File sfzFile;
+        int numSamples = 0;
+        int numLooped = 0;
+        juce::String error;  // Empty on success
+    };
+
+    static constexpr double TAIL_MARGIN_SECONDS = 0.1;
+    static constexpr double LOOP_SETTLE_SECONDS = 0.05;   // After attack + decay
+    static constexpr double LOOP_SEARCH_SECONDS = 0.05;   // Loop end candidates
+    static constexpr double MIN_LOOP_SECONDS = 0.1;
+    static constexpr int LOOP_MATCH_WINDOW = 256;         // Also kept before the note-off
+    static constexpr float MAX_LOOP_ERROR = 0.02f;        // Relative squared difference
+    static constexpr float MIN_LOOP_LEVEL_DB = -40.0f;    // Below the sample's peak
+    static constexpr double FADE_OUT_SECONDS = 0.005;
+
+    explicit MultisampleExporter(const Settings& settings);
+
+    // Exports the given programs (all of them if empty) into outputDirectory
+    std::vector<ProgramResult> exportPrograms(const juce::File& outputDirectory,
+                                              std::vector<int> programIndices = {});
+
+    // Sampled root notes and the key range each one covers
+    struct Zone {
+        int rootNote;
+        int lowKey;
+        int highKey;
+    };
+    static std::vector<Zone> createZones(int lowestNote, int highestNote, int noteStep);
+
+    // Sustain loop in the held part, or an invalid one if the tone does not repeat
+    static LoopPoints findSustainLoop(const float* samples, int settleSample, int noteOffSample,
+                                      double sampleRate);
+
+    // Length after dropping the tail below thresholdDb (relative to the peak)
+    static int findTrimmedLength(const float* samples, int numSamples, float thresholdDb);
+
+   private:
+    struct Program;
+
+    ProgramResult writeProgram(const Program& program, const juce::File& outputDirectory) const;
+    bool writeWav(const juce::File& file, const float* samples, int numSamples, int rootNote,
+                  const LoopPoints& loop) const;
+
+    const Settings settings;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MultisampleExporter)
+};
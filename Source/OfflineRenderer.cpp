@@ -0,0 +1,152 @@
+#include "OfflineRenderer.h"
+#include <cstring>
+
+OfflineRenderer::OfflineRenderer(double sampleRateToUse, int blockSizeToUse)
+    : sampleRate(sampleRateToUse), blockSize(juce::jmax(1, blockSizeToUse)) {
+    processor.setNonRealtime(true);
+    processor.setDeterministic(true, NOISE_SEED);
+    blockBuffer.setSize(processor.getTotalNumOutputChannels(), blockSize);
+    blockMidi.ensureSize(2048);
+}
+
+void OfflineRenderer::loadProgram(int programIndex) {
+    processor.setCurrentProgram(programIndex);
+}
+
+void OfflineRenderer::setParameter(const juce::String& parameterId, float plainValue) {
+    if (auto* parameter = processor.getValueTreeState().getParameter(parameterId))
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(plainValue));
+    else
+        jassertfalse;  // Unknown parameter ID
+}
+
+std::map<juce::String, float> OfflineRenderer::getParameterSnapshot() {
+    std::map<juce::String, float> values;
+    for (auto* parameter : processor.getParameters()) {
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            values[ranged->getParameterID()] = ranged->convertFrom0to1(ranged->getValue());
+    }
+    return values;
+}
+
+void OfflineRenderer::applyParameterSnapshot(const std::map<juce::String, float>& values) {
+    // IDs this build does not know (e.g. from newer presets) are skipped
+    for (const auto& [id, value] : values) {
+        if (auto* parameter = processor.getValueTreeState().getParameter(id))
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+}
+
+void OfflineRenderer::resetParametersToDefaults() {
+    for (auto* parameter : processor.getParameters()) {
+        if (parameter->getValue() != parameter->getDefaultValue())
+            parameter->setValueNotifyingHost(parameter->getDefaultValue());
+    }
+}
+
+int OfflineRenderer::getNoteLengthInSamples(const Note& note) const {
+    return juce::roundToInt(note.holdSeconds * sampleRate) +
+           juce::roundToInt(note.releaseSeconds * sampleRate);
+}
+
+juce::MidiBuffer OfflineRenderer::createNoteSequence(const Note& note) const {
+    juce::MidiBuffer midi;
+    midi.addEvent(juce::MidiMessage::noteOn(1, note.noteNumber, note.velocity), 0);
+    midi.addEvent(juce::MidiMessage::noteOff(1, note.noteNumber),
+                  juce::roundToInt(note.holdSeconds * sampleRate));
+    return midi;
+}
+
+juce::AudioBuffer<float> OfflineRenderer::renderNote(const Note& note) {
+    juce::AudioBuffer<float> output(1, getNoteLengthInSamples(note));
+    render(createNoteSequence(note), output);
+    return output;
+}
+
+void OfflineRenderer::render(const juce::MidiBuffer& midi, juce::AudioBuffer<float>& destination) {
+    beginRender();
+    processRender(midi, destination);
+    endRender();
+}
+
+void OfflineRenderer::beginRender() {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    // MIDI controllers and pitch bend write to parameters; endRender restores them so
+    // the next render starts from the same state
+    parameterSnapshot.clear();
+    for (auto* parameter : processor.getParameters())
+        parameterSnapshot.push_back(parameter->getValue());
+
+    // A fresh prepare resets the whole graph
+    processor.prepareToPlay(sampleRate, blockSize);
+}
+
+void OfflineRenderer::processRender(const juce::MidiBuffer& midi,
+                                    juce::AudioBuffer<float>& destination) {
+    // The engine delays its output by the reported latency; render that much longer
+    // and drop the start so the output lines up with the events
+    const int latency = processor.getLatencySamples();
+    const int numOutputSamples = destination.getNumSamples();
+    const int numSamplesToRender = numOutputSamples + latency;
+
+    for (int start = 0; start < numSamplesToRender; start += blockSize) {
+        const int numSamples = juce::jmin(blockSize, numSamplesToRender - start);
+
+        juce::AudioBuffer<float> block(blockBuffer.getArrayOfWritePointers(),
+                                       blockBuffer.getNumChannels(), numSamples);
+        block.clear();
+        blockMidi.clear();
+        blockMidi.addEvents(midi, start, numSamples, -start);
+
+        processor.processBlock(block, blockMidi);
+
+        const int sourceStart = juce::jmax(0, latency - start);
+        const int destinationStart = start + sourceStart - latency;
+        const int numToCopy = juce::jmin(numSamples - sourceStart,
+                                         numOutputSamples - destinationStart);
+        if (numToCopy <= 0)
+            continue;
+
+        for (int channel = 0; channel < destination.getNumChannels(); ++channel)
+            destination.copyFrom(channel, destinationStart, block, 0, sourceStart, numToCopy);
+    }
+}
+
+void OfflineRenderer::endRender() {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    processor.releaseResources();
+
+    const auto& parameters = processor.getParameters();
+    for (int i = 0; i < parameters.size(); ++i) {
+        if (parameters[i]->getValue() != parameterSnapshot[static_cast<size_t>(i)])
+            parameters[i]->setValueNotifyingHost(parameterSnapshot[static_cast<size_t>(i)]);
+    }
+}
+
+juce::uint64 OfflineRenderer::calculateContentHash(const juce::AudioBuffer<float>& audio) {
+    juce::uint64 hash = 14695981039346656037ull;
+
+    const auto addBytes = [&hash](const void* data, size_t numBytes) {
+        const auto* bytes = static_cast<const juce::uint8*>(data);
+        for (size_t i = 0; i < numBytes; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+
+    const juce::int32 shape[] = {audio.getNumChannels(), audio.getNumSamples()};
+    addBytes(shape, sizeof(shape));
+
+    for (int channel = 0; channel < audio.getNumChannels(); ++channel) {
+        const float* samples = audio.getReadPointer(channel);
+        for (int i = 0; i < audio.getNumSamples(); ++i) {
+            juce::uint32 bits = 0;
+            std::memcpy(&bits, samples + i, sizeof(bits));
+            addBytes(&bits, sizeof(bits));
+        }
+    }
+
+    return hash;
+}
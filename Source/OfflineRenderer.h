@@ -0,0 +1,86 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <map>
+#include <vector>
+#include "CS01AudioProcessor.h"
+
+//==============================================================================
+// Headless rendering through a private CS01AudioProcessor, for regression tests
+// and offline jobs. Every render starts from a freshly prepared processor, so
+// voices, envelopes and oscillator phases do not carry over from the previous
+// one. Any latency the engine reports is removed from the output.
+//
+// The processor runs in deterministic mode: the same MIDI and parameters give a
+// bit-identical render for any block size, so renders can be compared and cached
+// by content hash. Hashes are only comparable between identical builds (compiler
+// and floating-point settings change the low bits).
+//
+// Renders must be started and finished on the message thread: the processing
+// graph only builds its render sequence there. render() does all of it; callers
+// spreading renders over worker threads call beginRender() and endRender() on
+// the message thread and processRender() on the worker. Use one renderer per
+// worker.
+class OfflineRenderer {
+   public:
+    struct Note {
+        int noteNumber = 60;
+        float velocity = 1.0f;
+        double holdSeconds = 0.5;     // Note-on to note-off
+        double releaseSeconds = 0.5;  // Rendered after the note-off
+    };
+
+    static constexpr juce::int64 NOISE_SEED = 0x43533031;  // "CS01"
+
+    explicit OfflineRenderer(double sampleRate = 48000.0, int blockSize = 512);
+    ~OfflineRenderer() = default;
+
+    double getSampleRate() const noexcept {
+        return sampleRate;
+    }
+    int getBlockSize() const noexcept {
+        return blockSize;
+    }
+
+    CS01AudioProcessor& getProcessor() noexcept {
+        return processor;
+    }
+
+    // Loads a program through the processor's ProgramManager
+    void loadProgram(int programIndex);
+
+    // Sets a parameter by its plain (unnormalised) value
+    void setParameter(const juce::String& parameterId, float plainValue);
+
+    // Plain values of all parameters by ID
+    std::map<juce::String, float> getParameterSnapshot();
+    void applyParameterSnapshot(const std::map<juce::String, float>& values);
+    void resetParametersToDefaults();
+
+    // Renders a single note into a mono buffer of hold + release length
+    juce::AudioBuffer<float> renderNote(const Note& note);
+    int getNoteLengthInSamples(const Note& note) const;
+    juce::MidiBuffer createNoteSequence(const Note& note) const;
+
+    // Renders the MIDI sequence into destination (all channels carry the mono output)
+    void render(const juce::MidiBuffer& midi, juce::AudioBuffer<float>& destination);
+
+    // render() in three steps, see above
+    void beginRender();
+    void processRender(const juce::MidiBuffer& midi, juce::AudioBuffer<float>& destination);
+    void endRender();
+
+    // FNV-1a over the sample bits, channel count and length
+    static juce::uint64 calculateContentHash(const juce::AudioBuffer<float>& audio);
+
+   private:
+    const double sampleRate;
+    const int blockSize;
+
+    CS01AudioProcessor processor;
+    juce::AudioBuffer<float> blockBuffer;
+    juce::MidiBuffer blockMidi;
+    std::vector<float> parameterSnapshot;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineRenderer)
+};
@@ -26,4 +26,5 @@ const juce::String breathInput{"BREATH_INPUT"};
 const juce::String pitchBendUpRange{"PITCH_BEND_UP_RANGE"};
 const juce::String pitchBendDownRange{"PITCH_BEND_DOWN_RANGE"};
 const juce::String filterType{"FILTER_TYPE"};  // Filter type (MODERN/CS01)
+const juce::String processingRate{"PROCESSING_RATE"};  // Engine rate (Host/48 kHz/96 kHz)
 }  // namespace ParameterIds
@@ -1,24 +1,141 @@
 #include "ProgramManager.h"
 #include "BinaryData.h"
 
-ProgramManager::ProgramManager(juce::AudioProcessorValueTreeState& apvts) : apvts(apvts) {
+namespace {
+std::vector<Program> getFactoryPrograms() {
+    return {{"Default", "Default.xml"},
+            {"Flute", "Flute.xml"},
+            {"Violin", "Violin.xml"},
+            {"Trumpet", "Trumpet.xml"},
+            {"Clavinet", "Clavinet.xml"},
+            {"Solo Synth Lead", "Solo_Synth_Lead.xml"},
+            {"Synth Bass", "Synth_Bass.xml"}};
+}
+
+std::unique_ptr<juce::XmlElement> parseFactoryPreset(const juce::String& filename) {
+    // Generate resource name (replace dot in filename extension with underscore)
+    auto resourceName = filename.replace(".", "_");
+
+    int dataSize = 0;
+    const char* data = BinaryData::getNamedResource(resourceName.toRawUTF8(), dataSize);
+
+    if (dataSize > 0) {
+        return juce::XmlDocument::parse(juce::String::fromUTF8(data, dataSize));
+    }
+
+    return nullptr;
+}
+
+// Raw values by parameter ID
+std::map<juce::String, float> getRawValues(const juce::XmlElement& xml) {
+    std::map<juce::String, float> rawValues;
+    for (auto* child : xml.getChildWithTagNameIterator("PARAM")) {
+        if (child->hasAttribute("id") && child->hasAttribute("value")) {
+            rawValues[child->getStringAttribute("id")] =
+                static_cast<float>(child->getDoubleAttribute("value"));
+        }
+    }
+    return rawValues;
+}
+}  // namespace
+
+FactoryPresetValues::FactoryPresetValues() {
+    for (const auto& preset : getFactoryPrograms()) {
+        if (auto xml = parseFactoryPreset(preset.filename)) {
+            byFilename[preset.filename] = getRawValues(*xml);
+        }
+    }
+}
+
+ProgramManager::ProgramManager(juce::AudioProcessorValueTreeState& apvts)
+    : apvts(apvts),
+      sharedUserPresetIndex(std::in_place),
+      userPresetIndex(sharedUserPresetIndex->get()) {
+    initialize();
+}
+
+ProgramManager::ProgramManager(juce::AudioProcessorValueTreeState& apvts, UserPresetIndex& index)
+    : apvts(apvts), userPresetIndex(index) {
+    initialize();
+}
+
+void ProgramManager::initialize() {
+    // Cache the parameter list once so snapshots can be applied by index
+    for (auto* param : apvts.processor.getParameters()) {
+        auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(param);
+        parameters.push_back(ranged);
+        presetExcludedMask.push_back(ranged == nullptr ||
+                                     isPresetExcludedParameter(ranged->getParameterID()));
+        sessionExcludedMask.push_back(ranged == nullptr ||
+                                      isSessionExcludedParameter(ranged->getParameterID()));
+
+        if (ranged != nullptr) {
+            parameterIdHashes.emplace_back(hashParameterId(ranged->getParameterID()),
+                                           parameters.size() - 1);
+        }
+    }
+
+    std::sort(parameterIdHashes.begin(), parameterIdHashes.end());
+
+    // Two IDs hashing to the same value would make the binary state ambiguous
+    jassert(std::adjacent_find(parameterIdHashes.begin(), parameterIdHashes.end(),
+                               [](const auto& a, const auto& b) { return a.first == b.first; }) ==
+            parameterIdHashes.end());
+
+    // User presets come from the shared index; nothing here touches the disk. If another
+    // instance already finished a scan the list is complete right away, otherwise it is
+    // filled in when the indexer reports a change.
     initializePresets();
-    createUserPresetsDirectory();
     refreshUserPresets();
     rebuildAllPresetsList();
+
+    userPresetIndex.addChangeListener(this);
+}
+
+ProgramManager::~ProgramManager() {
+    userPresetIndex.removeChangeListener(this);
 }
 
-ProgramManager::~ProgramManager() {}
+void ProgramManager::changeListenerCallback(juce::ChangeBroadcaster*) {
+    // Keep the selected preset selected even if its index moves
+    const int current = currentProgram.load();
+    const auto currentKey = current >= 0 && current < static_cast<int>(allPresets.size())
+                                ? getPresetKey(allPresets[current])
+                                : juce::String();
+
+    refreshUserPresets();
+    rebuildAllPresetsList();
+
+    // A program restored before the first scan was indexed against the factory presets only
+    if (userPresetsIndexed.load()) {
+        const int pending = pendingProgram.exchange(-1);
+        if (pending >= 0) {
+            currentProgram.store(clampProgramIndex(pending));
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < allPresets.size(); ++i) {
+        if (getPresetKey(allPresets[i]) == currentKey) {
+            currentProgram.store(static_cast<int>(i));
+            return;
+        }
+    }
+
+    if (currentProgram.load() >= static_cast<int>(allPresets.size()))
+        currentProgram.store(0);
+}
 
 void ProgramManager::initializePresets() {
-    factoryPresets.clear();
-    factoryPresets.emplace_back("Default", "Default.xml", PresetType::Factory);
-    factoryPresets.emplace_back("Flute", "Flute.xml", PresetType::Factory);
-    factoryPresets.emplace_back("Violin", "Violin.xml", PresetType::Factory);
-    factoryPresets.emplace_back("Trumpet", "Trumpet.xml", PresetType::Factory);
-    factoryPresets.emplace_back("Clavinet", "Clavinet.xml", PresetType::Factory);
-    factoryPresets.emplace_back("Solo Synth Lead", "Solo_Synth_Lead.xml", PresetType::Factory);
-    factoryPresets.emplace_back("Synth Bass", "Synth_Bass.xml", PresetType::Factory);
+    factoryPresets = getFactoryPrograms();
+
+    // Factory presets never change at runtime; their XML is parsed once per process
+    for (const auto& preset : factoryPresets) {
+        auto values = factoryPresetValues->byFilename.find(preset.filename);
+        if (values != factoryPresetValues->byFilename.end()) {
+            snapshotCache[getPresetKey(preset)] = createSnapshotFromValues(values->second);
+        }
+    }
 }
 
 int ProgramManager::getNumPrograms() const {
@@ -26,25 +143,31 @@ int ProgramManager::getNumPrograms() const {
 }
 
 int ProgramManager::getCurrentProgram() const {
-    return currentProgram;
+    return currentProgram.load();
 }
 
 void ProgramManager::setCurrentProgram(int index) {
     if (index >= 0 && index < static_cast<int>(allPresets.size())) {
+        // A program chosen since the session was restored wins over the restored one
+        pendingProgram = -1;
         currentProgram = index;
-        const auto& preset = allPresets[index];
-        
-        if (preset.type == PresetType::Factory) {
-            loadPresetFromBinaryData(preset.filename);
-        } else {
-            // Load user preset from file
-            auto userPresetsDir = getUserPresetsDirectory();
-            auto presetFile = userPresetsDir.getChildFile(preset.filename);
-            loadUserPresetFromFile(presetFile);
+        ++changeCount;
+
+        if (const auto* snapshot = getSnapshot(index)) {
+            applySnapshot(*snapshot);
         }
     }
 }
 
+const PresetSnapshot* ProgramManager::getSnapshot(int index) {
+    if (index < 0 || index >= static_cast<int>(allPresets.size()))
+        return nullptr;
+
+    // User snapshots are kept in sync with the index by refreshUserPresets()
+    auto cached = snapshotCache.find(getPresetKey(allPresets[index]));
+    return cached != snapshotCache.end() ? &cached->second : nullptr;
+}
+
 juce::String ProgramManager::getProgramName(int index) const {
     if (index >= 0 && index < static_cast<int>(allPresets.size()))
         return allPresets[index].name;
@@ -63,108 +186,180 @@ bool ProgramManager::isUserPreset(int index) const {
 
 void ProgramManager::loadFactoryPreset(int index) {
     if (index >= 0 && index < static_cast<int>(factoryPresets.size())) {
-        loadPresetFromBinaryData(factoryPresets[index].filename);
+        auto cached = snapshotCache.find(getPresetKey(factoryPresets[index]));
+        if (cached != snapshotCache.end()) {
+            applySnapshot(cached->second);
+        }
     }
 }
 
 void ProgramManager::getStateInformation(juce::MemoryBlock& destData) {
-    // Get current state as XML
-    std::unique_ptr<juce::XmlElement> xml = apvts.copyState().createXml();
+    // Binary layout (little endian):
+    //   uint32 magic, uint16 version, uint16 record count, int32 program,
+    //   then per parameter: uint32 FNV-1a hash of the ID, float32 plain value
+    int numRecords = 0;
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        if (!sessionExcludedMask[i])
+            ++numRecords;
+    }
 
-    // Get parameter elements from XML
-    if (xml != nullptr) {
-        // Add program number
-        xml->setAttribute("program", currentProgram);
+    destData.setSize(static_cast<size_t>(STATE_HEADER_SIZE + numRecords * STATE_RECORD_SIZE));
+    juce::MemoryOutputStream stream(destData, false);
 
-        // Get parameter elements
-        if (auto* params = xml->getChildByName("PARAMETERS")) {
-            // Remove excluded parameters (only realtime input parameters for DAW sessions)
-            for (int i = params->getNumChildElements() - 1; i >= 0; --i) {
-                auto* param = params->getChildElement(i);
-                if (param != nullptr) {
-                    // Get parameter ID
-                    if (param->hasAttribute("id")) {
-                        juce::String id = param->getStringAttribute("id");
-
-                        // Remove parameters excluded from DAW session state
-                        if (isSessionExcludedParameter(id)) {
-                            params->removeChildElement(param, true);
-                        }
-                    }
-                }
-            }
-        }
+    stream.writeInt(static_cast<int>(STATE_MAGIC));
+    stream.writeShort(static_cast<short>(STATE_VERSION));
+    stream.writeShort(static_cast<short>(numRecords));
+    stream.writeInt(currentProgram.load());
 
-        // Convert XML to binary
-        juce::AudioProcessor::copyXmlToBinary(*xml, destData);
+    // Realtime input parameters are not part of the DAW session
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        if (sessionExcludedMask[i])
+            continue;
+
+        auto* param = parameters[i];
+        stream.writeInt(static_cast<int>(hashParameterId(param->getParameterID())));
+        stream.writeFloat(param->convertFrom0to1(param->getValue()));
     }
 }
 
 void ProgramManager::setStateInformation(const void* data, int sizeInBytes) {
+    if (setStateFromBinary(data, sizeInBytes))
+        return;
+
+    // Sessions saved before the binary format stored the APVTS tree as XML
     std::unique_ptr<juce::XmlElement> xmlState(
         juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes));
-    if (xmlState.get() != nullptr) {
-        if (xmlState->hasTagName(apvts.state.getType())) {
-            // Save current values of parameters excluded from DAW session state
-            std::map<juce::String, float> persistentValues;
-            for (const auto& paramId : sessionExcludedParameters) {
-                if (auto* param = apvts.getParameter(paramId)) {
-                    persistentValues[paramId] = param->getValue();
-                }
-            }
+    if (xmlState != nullptr && xmlState->hasTagName(apvts.state.getType())) {
+        setStateFromXml(*xmlState);
+    }
+}
 
-            // Restore state
-            currentProgram = xmlState->getIntAttribute("program", 0);
-            apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
+bool ProgramManager::setStateFromBinary(const void* data, int sizeInBytes) {
+    if (data == nullptr || sizeInBytes < STATE_HEADER_SIZE)
+        return false;
 
-            // Restore values of parameters excluded from DAW session state
-            for (const auto& [paramId, value] : persistentValues) {
-                if (auto* param = apvts.getParameter(paramId)) {
-                    param->setValueNotifyingHost(value);
-                }
-            }
-        }
+    juce::MemoryInputStream stream(data, static_cast<size_t>(sizeInBytes), false);
+
+    if (static_cast<juce::uint32>(stream.readInt()) != STATE_MAGIC)
+        return false;
+
+    const int version = static_cast<juce::uint16>(stream.readShort());
+    const int numRecords = static_cast<juce::uint16>(stream.readShort());
+
+    if (version > STATE_VERSION) {
+        jassertfalse;  // Saved by a newer version of the plug-in
+        return true;
     }
+
+    if (sizeInBytes < STATE_HEADER_SIZE + numRecords * STATE_RECORD_SIZE) {
+        jassertfalse;  // Truncated state
+        return true;
+    }
+
+    restoreProgramIndex(stream.readInt());
+
+    for (int i = 0; i < numRecords; ++i) {
+        const auto hash = static_cast<juce::uint32>(stream.readInt());
+        const float value = stream.readFloat();
+
+        // Unknown IDs come from parameters removed in a later version
+        auto found = std::lower_bound(parameterIdHashes.begin(), parameterIdHashes.end(),
+                                      std::make_pair(hash, size_t{0}));
+        if (found == parameterIdHashes.end() || found->first != hash)
+            continue;
+
+        // Realtime inputs keep their current values
+        if (sessionExcludedMask[found->second])
+            continue;
+
+        auto* param = parameters[found->second];
+        param->setValueNotifyingHost(param->convertTo0to1(value));
+    }
+
+    return true;
 }
 
-void ProgramManager::loadPresetFromBinaryData(const juce::String& filename) {
-    // Generate resource name (replace dot in filename extension with underscore)
-    auto resourceName = filename.replace(".", "_");
+void ProgramManager::setStateFromXml(const juce::XmlElement& xmlState) {
+    // Save current values of parameters excluded from DAW session state
+    std::map<juce::String, float> persistentValues;
+    for (const auto& paramId : sessionExcludedParameters) {
+        if (auto* param = apvts.getParameter(paramId)) {
+            persistentValues[paramId] = param->getValue();
+        }
+    }
 
-    int dataSize = 0;
-    const char* data = BinaryData::getNamedResource(resourceName.toRawUTF8(), dataSize);
+    // Restore state
+    restoreProgramIndex(xmlState.getIntAttribute("program", 0));
+    apvts.replaceState(juce::ValueTree::fromXml(xmlState));
 
-    if (dataSize > 0) {
-        std::unique_ptr<juce::XmlElement> xmlState(juce::XmlDocument::parse(data));
-        if (xmlState != nullptr) {
-            loadPresetFromXml(xmlState.get());
+    // Restore values of parameters excluded from DAW session state
+    for (const auto& [paramId, value] : persistentValues) {
+        if (auto* param = apvts.getParameter(paramId)) {
+            param->setValueNotifyingHost(value);
         }
     }
 }
 
+juce::uint32 ProgramManager::hashParameterId(const juce::String& paramId) {
+    // 32-bit FNV-1a of the UTF-8 ID
+    juce::uint32 hash = 2166136261u;
+    for (auto* c = paramId.toRawUTF8(); *c != 0; ++c) {
+        hash ^= static_cast<juce::uint8>(*c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 void ProgramManager::loadPresetFromXml(const juce::XmlElement* xml) {
     if (xml != nullptr) {
-        // Save current values of parameters excluded from preset loading
-        std::map<juce::String, float> persistentValues;
-        for (const auto& paramId : presetExcludedParameters) {
-            if (auto* param = apvts.getParameter(paramId)) {
-                persistentValues[paramId] = param->getValue();
-            }
-        }
+        applySnapshot(createSnapshotFromXml(*xml));
+    }
+}
+
+PresetSnapshot ProgramManager::createSnapshotFromXml(const juce::XmlElement& xml) const {
+    // Collect raw values by ID first so each parameter is a single lookup
+    return createSnapshotFromValues(getRawValues(xml));
+}
 
-        // Replace ValueTree state
-        apvts.replaceState(juce::ValueTree::fromXml(*xml));
+PresetSnapshot ProgramManager::createSnapshotFromValues(
+    const std::map<juce::String, float>& rawValues) const {
+    PresetSnapshot snapshot;
+    snapshot.values.reserve(parameters.size());
 
-        // Restore values of parameters excluded from preset loading
-        for (const auto& [paramId, value] : persistentValues) {
-            if (auto* param = apvts.getParameter(paramId)) {
-                param->setValueNotifyingHost(value);
-            }
+    for (auto* param : parameters) {
+        float value = 0.0f;
+
+        if (param != nullptr) {
+            auto raw = rawValues.find(param->getParameterID());
+            value = raw != rawValues.end() ? param->convertTo0to1(raw->second)
+                                           : param->getDefaultValue();
         }
 
-        // Notify parameter changes
-        for (auto* param : apvts.processor.getParameters()) {
-            param->sendValueChangedMessageToListeners(param->getValue());
+        snapshot.values.push_back(value);
+    }
+
+    return snapshot;
+}
+
+PresetSnapshot ProgramManager::createSnapshotFromCurrentState() const {
+    PresetSnapshot snapshot;
+    snapshot.values.reserve(parameters.size());
+
+    for (auto* param : parameters) {
+        snapshot.values.push_back(param != nullptr ? param->getValue() : 0.0f);
+    }
+
+    return snapshot;
+}
+
+void ProgramManager::applySnapshot(const PresetSnapshot& snapshot) {
+    jassert(snapshot.values.size() == parameters.size());
+    const auto count = juce::jmin(snapshot.values.size(), parameters.size());
+
+    // Excluded parameters (volume, realtime inputs) keep their current values
+    for (size_t i = 0; i < count; ++i) {
+        if (!presetExcludedMask[i]) {
+            parameters[i]->setValueNotifyingHost(snapshot.values[i]);
         }
     }
 }
@@ -200,9 +395,24 @@ void ProgramManager::saveCurrentStateAsPreset(const juce::String& name) {
 
         // Save to file (will overwrite if exists)
         if (xml->writeTo(presetFile)) {
-            // Add to user presets list and rebuild
-            refreshUserPresets();
+            Program preset(name, filename, PresetType::User);
+
+            // The current state is already decoded; cache it without re-reading the file
+            auto snapshot = createSnapshotFromCurrentState();
+            snapshot.modificationTime = presetFile.getLastModificationTime();
+            snapshotCache[getPresetKey(preset)] = std::move(snapshot);
+
+            auto existing = std::find_if(userPresets.begin(), userPresets.end(),
+                                         [&filename](const Program& p) { return p.filename == filename; });
+            if (existing == userPresets.end()) {
+                userPresets.push_back(preset);
+                sortUserPresets();
+            }
+
             rebuildAllPresetsList();
+
+            // Let other instances pick up the new file
+            userPresetIndex.requestRescan();
         }
     }
 }
@@ -212,20 +422,26 @@ bool ProgramManager::deleteUserPreset(int index) {
         return false; // Cannot delete factory presets
     }
 
-    const auto& preset = allPresets[index];
+    const auto preset = allPresets[index];
     auto userPresetsDir = getUserPresetsDirectory();
     auto presetFile = userPresetsDir.getChildFile(preset.filename);
 
     if (presetFile.exists() && presetFile.deleteFile()) {
-        // Refresh presets and rebuild list
-        refreshUserPresets();
+        // Drop the entry and its cached snapshot without rescanning the directory
+        snapshotCache.erase(getPresetKey(preset));
+        userPresets.erase(std::remove_if(userPresets.begin(), userPresets.end(),
+                                         [&preset](const Program& p) {
+                                             return p.filename == preset.filename;
+                                         }),
+                          userPresets.end());
         rebuildAllPresetsList();
         
         // Adjust current program if necessary
-        if (currentProgram >= static_cast<int>(allPresets.size())) {
-            currentProgram = allPresets.empty() ? 0 : static_cast<int>(allPresets.size()) - 1;
+        if (currentProgram.load() >= static_cast<int>(allPresets.size())) {
+            currentProgram.store(allPresets.empty() ? 0 : static_cast<int>(allPresets.size()) - 1);
         }
-        
+
+        userPresetIndex.requestRescan();
         return true;
     }
     
@@ -237,10 +453,10 @@ bool ProgramManager::renameUserPreset(int index, const juce::String& newName) {
         return false;
     }
 
-    const auto& preset = allPresets[index];
+    const auto preset = allPresets[index];
     auto userPresetsDir = getUserPresetsDirectory();
     auto oldFile = userPresetsDir.getChildFile(preset.filename);
-    
+
     if (!oldFile.exists()) {
         return false;
     }
@@ -251,8 +467,26 @@ bool ProgramManager::renameUserPreset(int index, const juce::String& newName) {
     auto newFile = userPresetsDir.getChildFile(newFilename);
 
     if (oldFile.moveFileTo(newFile)) {
-        refreshUserPresets();
+        Program renamed(uniqueName, newFilename, PresetType::User);
+
+        // Moving keeps the file contents, so the cached snapshot stays valid
+        auto cached = snapshotCache.find(getPresetKey(preset));
+        if (cached != snapshotCache.end()) {
+            auto snapshot = std::move(cached->second);
+            snapshotCache.erase(cached);
+            snapshot.modificationTime = newFile.getLastModificationTime();
+            snapshotCache[getPresetKey(renamed)] = std::move(snapshot);
+        }
+
+        for (auto& p : userPresets) {
+            if (p.filename == preset.filename) {
+                p = renamed;
+            }
+        }
+
+        sortUserPresets();
         rebuildAllPresetsList();
+        userPresetIndex.requestRescan();
         return true;
     }
     
@@ -261,26 +495,48 @@ bool ProgramManager::renameUserPreset(int index, const juce::String& newName) {
 
 void ProgramManager::refreshUserPresets() {
     userPresets.clear();
-    auto userPresetsDir = getUserPresetsDirectory();
-    
-    if (userPresetsDir.exists()) {
-        for (const auto& file : userPresetsDir.findChildFiles(juce::File::findFiles, false, "*.xml")) {
-            auto nameWithoutExtension = file.getFileNameWithoutExtension();
-            userPresets.emplace_back(nameWithoutExtension, file.getFileName(), PresetType::User);
+
+    // Read before the entries, which are then at least this new
+    const bool indexed = userPresetIndex.getGeneration() > 0;
+
+    // Entries arrive already parsed and sorted; only changed files need a new snapshot
+    for (const auto& entry : userPresetIndex.getEntries()) {
+        Program preset(entry.name, entry.filename, PresetType::User);
+        auto& snapshot = snapshotCache[getPresetKey(preset)];
+
+        if (snapshot.values.empty() || snapshot.modificationTime != entry.modificationTime) {
+            snapshot = createSnapshotFromValues(*entry.values);
+            snapshot.modificationTime = entry.modificationTime;
         }
-        
-        // Sort user presets alphabetically
-        std::sort(userPresets.begin(), userPresets.end(), 
-                  [](const Program& a, const Program& b) {
-                      return a.name < b.name;
-                  });
+
+        userPresets.push_back(std::move(preset));
     }
+
+    // Forget snapshots of user presets that no longer exist
+    for (auto it = snapshotCache.begin(); it != snapshotCache.end();) {
+        const bool isStale =
+            it->first.startsWith("user:") &&
+            std::none_of(userPresets.begin(), userPresets.end(), [&it](const Program& p) {
+                return getPresetKey(p) == it->first;
+            });
+        it = isStale ? snapshotCache.erase(it) : std::next(it);
+    }
+
+    userPresetsIndexed = indexed;
+}
+
+void ProgramManager::sortUserPresets() {
+    // Sort user presets alphabetically
+    std::sort(userPresets.begin(), userPresets.end(),
+              [](const Program& a, const Program& b) { return a.name < b.name; });
+}
+
+juce::String ProgramManager::getPresetKey(const Program& preset) {
+    return (preset.type == PresetType::Factory ? "factory:" : "user:") + preset.filename;
 }
 
 juce::File ProgramManager::getUserPresetsDirectory() const {
-    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
-           .getChildFile("CheapSynth01")
-           .getChildFile("UserPresets");
+    return userPresetIndex.getDirectory();
 }
 
 bool ProgramManager::createUserPresetsDirectory() {
@@ -300,16 +556,68 @@ void ProgramManager::rebuildAllPresetsList() {
     for (const auto& preset : userPresets) {
         allPresets.push_back(preset);
     }
+
+    ++presetListVersion;
+    ++changeCount;
+    rebuildRealtimeSnapshots();
 }
 
-void ProgramManager::loadUserPresetFromFile(const juce::File& file) {
-    if (file.exists()) {
-        juce::XmlDocument xmlDoc(file.loadFileAsString());
-        std::unique_ptr<juce::XmlElement> xmlState(xmlDoc.getDocumentElement());
-        if (xmlState != nullptr) {
-            loadPresetFromXml(xmlState.get());
+void ProgramManager::rebuildRealtimeSnapshots() {
+    const auto numParameters = parameters.size();
+    std::vector<float> table(allPresets.size() * numParameters, 0.0f);
+    std::vector<bool> valid(allPresets.size(), false);
+
+    for (size_t i = 0; i < allPresets.size(); ++i) {
+        if (const auto* snapshot = getSnapshot(static_cast<int>(i))) {
+            std::copy(snapshot->values.begin(), snapshot->values.end(),
+                      table.begin() + static_cast<std::ptrdiff_t>(i * numParameters));
+            valid[i] = true;
         }
     }
+
+    {
+        const juce::SpinLock::ScopedLockType lock(realtimeSnapshotLock);
+        realtimeSnapshots.swap(table);
+        realtimeSnapshotValid.swap(valid);
+    }
+    // The previous table is released here, outside the lock
+}
+
+bool ProgramManager::copyRealtimeSnapshot(int index, float* destination,
+                                          size_t numValues) noexcept {
+    // Never wait on the message thread; a concurrent rebuild just drops this request
+    const juce::SpinLock::ScopedTryLockType lock(realtimeSnapshotLock);
+    if (!lock.isLocked())
+        return false;
+
+    const auto numParameters = parameters.size();
+    if (index < 0 || static_cast<size_t>(index) >= realtimeSnapshotValid.size() ||
+        !realtimeSnapshotValid[static_cast<size_t>(index)] || numValues != numParameters)
+        return false;
+
+    const float* source = realtimeSnapshots.data() + static_cast<size_t>(index) * numParameters;
+    std::copy(source, source + numParameters, destination);
+    return true;
+}
+
+int ProgramManager::clampProgramIndex(int index) const noexcept {
+    const int numPrograms = static_cast<int>(allPresets.size());
+    return numPrograms > 0 ? juce::jlimit(0, numPrograms - 1, index) : 0;
+}
+
+void ProgramManager::restoreProgramIndex(int index) {
+    // Session data is untrusted, and the user presets may have changed since it was saved.
+    // Until the first scan is in, an index past the factory presets may still name a user
+    // preset, so it is resolved again once the index reports.
+    pendingProgram = !userPresetsIndexed.load() && index >= getNumPrograms() ? index : -1;
+    currentProgram = clampProgramIndex(index);
+    ++changeCount;
+}
+
+void ProgramManager::setCurrentProgramIndex(int index) noexcept {
+    pendingProgram.store(-1);
+    currentProgram.store(index);
+    ++changeCount;
 }
 
 juce::String ProgramManager::generateUniquePresetName(const juce::String& baseName) const {
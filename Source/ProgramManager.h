@@ -1,7 +1,9 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <optional>
 #include "Parameters.h"
+#include "UserPresetIndex.h"
 
 //==============================================================================
 enum class PresetType {
@@ -18,14 +20,37 @@ struct Program {
         : name(n), filename(f), type(t) {}
 };
 
-class ProgramManager {
+// Decoded preset: one normalised value per APVTS parameter, in
+// AudioProcessor::getParameters() order. Parameters missing from the preset
+// file hold their default value, matching what replaceState() would do.
+struct PresetSnapshot {
+    std::vector<float> values;
+    juce::Time modificationTime;  // Source file time (user presets only)
+};
+
+// Raw values of the factory presets, parsed from BinaryData once per process and shared by
+// every ProgramManager through juce::SharedResourcePointer
+struct FactoryPresetValues {
+    FactoryPresetValues();
+
+    // Keyed by preset filename; presets whose resource is missing are absent
+    std::map<juce::String, std::map<juce::String, float>> byFilename;
+};
+
+class ProgramManager : private juce::ChangeListener {
    public:
     ProgramManager(juce::AudioProcessorValueTreeState& apvts);
-    ~ProgramManager();
+    // Uses the given index instead of the process-wide one (e.g. a temporary directory)
+    ProgramManager(juce::AudioProcessorValueTreeState& apvts, UserPresetIndex& index);
+    ~ProgramManager() override;
 
     // プリセット操作メソッド
     void loadFactoryPreset(int index);
     void loadPresetFromXml(const juce::XmlElement* xml);
+    void applySnapshot(const PresetSnapshot& snapshot);
+    PresetSnapshot createSnapshotFromXml(const juce::XmlElement& xml) const;
+    PresetSnapshot createSnapshotFromCurrentState() const;
+    const PresetSnapshot* getSnapshot(int index);
     void saveCurrentStateAsPreset(const juce::String& name);
     bool deleteUserPreset(int index);
     bool renameUserPreset(int index, const juce::String& newName);
@@ -37,27 +62,80 @@ class ProgramManager {
     juce::String getProgramName(int index) const;
     PresetType getPresetType(int index) const;
     bool isUserPreset(int index) const;
+    int getPresetListVersion() const {
+        return presetListVersion;
+    }
+    // プリセット一覧または選択中のプログラムが変わるたびに増える（どのスレッドからでも可）
+    int getChangeCount() const noexcept {
+        return changeCount.load(std::memory_order_acquire);
+    }
 
-    // ユーザープリセット管理  
+    // ユーザープリセット管理（ディスクの走査はUserPresetIndexのスレッドが行う）
     void refreshUserPresets();
+    UserPresetIndex& getUserPresetIndex() {
+        return userPresetIndex;
+    }
     juce::File getUserPresetsDirectory() const;
     bool createUserPresetsDirectory();
 
-    // 状態の保存と復元
+    // 状態の保存と復元（バイナリ形式、旧XML形式も読み込み可能）
     void getStateInformation(juce::MemoryBlock& destData);
     void setStateInformation(const void* data, int sizeInBytes);
+    static juce::uint32 hashParameterId(const juce::String& paramId);
+
+    // オーディオスレッドからのプログラムチェンジ（アロケーションなし）
+    bool copyRealtimeSnapshot(int index, float* destination, size_t numValues) noexcept;
+    void setCurrentProgramIndex(int index) noexcept;
+    const std::vector<juce::RangedAudioParameter*>& getParameterList() const {
+        return parameters;
+    }
+    const std::vector<bool>& getPresetExcludedMask() const {
+        return presetExcludedMask;
+    }
 
    private:
     juce::AudioProcessorValueTreeState& apvts;
+    std::optional<juce::SharedResourcePointer<UserPresetIndex>> sharedUserPresetIndex;
+    UserPresetIndex& userPresetIndex;
+    juce::SharedResourcePointer<FactoryPresetValues> factoryPresetValues;
+    int presetListVersion = 0;
     std::vector<Program> factoryPresets;
     std::vector<Program> userPresets;
     std::vector<Program> allPresets; // Combined list for easy access
-    int currentProgram = 0;
+    std::atomic<int> currentProgram{0};
+
+    // A session restored before the first user preset scan is in may select a user preset
+    // the list does not hold yet; its raw index waits here for changeListenerCallback
+    std::atomic<bool> userPresetsIndexed{false};
+    std::atomic<int> pendingProgram{-1};
+    std::atomic<int> changeCount{0};
+
+    // プリセットキャッシュ（キー: "factory:<file>" / "user:<file>"）
+    std::map<juce::String, PresetSnapshot> snapshotCache;
+    std::vector<juce::RangedAudioParameter*> parameters;
+    std::vector<bool> presetExcludedMask;
+    std::vector<bool> sessionExcludedMask;
+
+    // バイナリ状態形式（パラメータIDはFNV-1aハッシュで保存）
+    static constexpr juce::uint32 STATE_MAGIC = 0x53315343;  // "CS1S"
+    static constexpr int STATE_VERSION = 1;
+    static constexpr int STATE_HEADER_SIZE = 12;
+    static constexpr int STATE_RECORD_SIZE = 8;
+    std::vector<std::pair<juce::uint32, size_t>> parameterIdHashes;  // Sorted for lookup
+
+    // Flat table of every program's snapshot (numPrograms x numParameters) for the
+    // audio thread. Rebuilt on the message thread and swapped in under the lock.
+    juce::SpinLock realtimeSnapshotLock;
+    std::vector<float> realtimeSnapshots;
+    std::vector<bool> realtimeSnapshotValid;
 
     // プリセット読み込み時に除外するパラメータ（音量変化を防ぐため）
+    // Pitch bend ranges are a setting of the player, not of the sound (presets do not store them)
     const std::vector<juce::String> presetExcludedParameters = {
-        ParameterIds::breathInput, ParameterIds::volume, ParameterIds::modDepth,
-        ParameterIds::pitchBend};
+        ParameterIds::breathInput,      ParameterIds::volume,
+        ParameterIds::modDepth,         ParameterIds::pitchBend,
+        ParameterIds::pitchBendUpRange, ParameterIds::pitchBendDownRange,
+        ParameterIds::processingRate};
 
     // DAWセッション保存時に除外するパラメータ（リアルタイム入力系のみ）
     const std::vector<juce::String> sessionExcludedParameters = {
@@ -65,10 +143,19 @@ class ProgramManager {
 
     bool isSessionExcludedParameter(const juce::String& paramId) const;
     bool isPresetExcludedParameter(const juce::String& paramId) const;
+    bool setStateFromBinary(const void* data, int sizeInBytes);
+    void setStateFromXml(const juce::XmlElement& xmlState);
+    int clampProgramIndex(int index) const noexcept;
+    void restoreProgramIndex(int index);
+
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+    PresetSnapshot createSnapshotFromValues(const std::map<juce::String, float>& rawValues) const;
 
+    void initialize();
     void initializePresets();
-    void loadPresetFromBinaryData(const juce::String& filename);
     void rebuildAllPresetsList();
-    void loadUserPresetFromFile(const juce::File& file);
+    void rebuildRealtimeSnapshots();
+    void sortUserPresets();
+    static juce::String getPresetKey(const Program& preset);
     juce::String generateUniquePresetName(const juce::String& baseName) const;
 };
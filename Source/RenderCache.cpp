@@ -0,0 +1,280 @@
+#include "RenderCache.h"
+#include "UserPresetIndex.h"
+#include <cstring>
+
+namespace {
+// File layout: this header, then numSamples float32 samples in native byte order
+struct FileHeader {
+    char magic[4];
+    juce::uint32 version;
+    juce::uint64 key;
+    juce::uint64 parameterHash;
+    double sampleRate;
+    double holdSeconds;
+    double releaseSeconds;
+    float velocity;
+    juce::int32 noteNumber;
+    juce::int32 numSamples;
+    juce::int32 reserved;
+};
+static_assert(sizeof(FileHeader) == 64, "Samples must stay aligned behind the header");
+
+constexpr char MAGIC[4] = {'C', 'S', 'R', 'C'};
+
+FileHeader makeHeader(const RenderCache::Request& request, juce::uint64 key, double sampleRate,
+                      int numSamples) {
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = RenderCache::CACHE_VERSION;
+    header.key = key;
+    header.parameterHash = UserPresetIndex::calculateParameterHash(request.parameters);
+    header.sampleRate = sampleRate;
+    header.holdSeconds = request.note.holdSeconds;
+    header.releaseSeconds = request.note.releaseSeconds;
+    header.velocity = request.note.velocity;
+    header.noteNumber = request.note.noteNumber;
+    header.numSamples = numSamples;
+    return header;
+}
+
+// Everything but the length has to match; a different file under the same name is a
+// hash collision or a stale entry
+bool matches(const FileHeader& stored, const FileHeader& expected) {
+    return std::memcmp(stored.magic, expected.magic, sizeof(MAGIC)) == 0 &&
+           stored.version == expected.version && stored.key == expected.key &&
+           stored.parameterHash == expected.parameterHash &&
+           stored.sampleRate == expected.sampleRate &&
+           stored.holdSeconds == expected.holdSeconds &&
+           stored.releaseSeconds == expected.releaseSeconds &&
+           stored.velocity == expected.velocity && stored.noteNumber == expected.noteNumber &&
+           stored.numSamples >= 0;
+}
+}  // namespace
+
+// A miss being rendered on a worker
+struct RenderCache::Job {
+    OfflineRenderer* renderer = nullptr;
+    size_t requestIndex = 0;
+    juce::MidiBuffer midi;
+    juce::AudioBuffer<float> output;
+    bool running = false;
+    std::atomic<bool> finished{false};
+};
+
+//==============================================================================
+juce::AudioBuffer<float> RenderCache::Render::toBuffer(int numChannels) const {
+    juce::AudioBuffer<float> buffer(juce::jmax(1, numChannels), numSamples);
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        buffer.copyFrom(channel, 0, samples, numSamples);
+    return buffer;
+}
+
+//==============================================================================
+RenderCache::RenderCache(const juce::File& directoryToUse, double sampleRateToUse,
+                         int numWorkersToUse)
+    : directory(directoryToUse),
+      sampleRate(sampleRateToUse),
+      numWorkers(juce::jmax(1, numWorkersToUse)),
+      pool(juce::jmax(1, numWorkersToUse)) {
+    directory.createDirectory();
+}
+
+RenderCache::~RenderCache() {
+    pool.removeAllJobs(false, -1);
+}
+
+juce::uint64 RenderCache::calculateKey(const Request& request) const {
+    // FNV-1a over the cache version, parameter hash and the note fields
+    juce::uint64 hash = 14695981039346656037ull;
+
+    const auto addBytes = [&hash](const void* data, size_t numBytes) {
+        const auto* bytes = static_cast<const juce::uint8*>(data);
+        for (size_t i = 0; i < numBytes; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+
+    const auto header = makeHeader(request, 0, sampleRate, 0);
+    addBytes(&header.version, sizeof(header.version));
+    addBytes(&header.parameterHash, sizeof(header.parameterHash));
+    addBytes(&header.sampleRate, sizeof(header.sampleRate));
+    addBytes(&header.holdSeconds, sizeof(header.holdSeconds));
+    addBytes(&header.releaseSeconds, sizeof(header.releaseSeconds));
+    addBytes(&header.velocity, sizeof(header.velocity));
+    addBytes(&header.noteNumber, sizeof(header.noteNumber));
+    return hash;
+}
+
+juce::File RenderCache::getFile(juce::uint64 key) const {
+    return directory.getChildFile(juce::String::toHexString(static_cast<juce::int64>(key))
+                                      .paddedLeft('0', 16) +
+                                  ".cs01render");
+}
+
+RenderCache::RenderPtr RenderCache::get(const Request& request) {
+    return get(std::vector<Request>{request}).front();
+}
+
+std::vector<RenderCache::RenderPtr> RenderCache::get(const std::vector<Request>& requests) {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    std::vector<RenderPtr> results(requests.size());
+    std::vector<size_t> misses;
+    std::map<juce::uint64, size_t> firstMissByKey;
+
+    for (size_t i = 0; i < requests.size(); ++i) {
+        const auto key = calculateKey(requests[i]);
+
+        if (auto render = lookUp(requests[i], key)) {
+            results[i] = std::move(render);
+            ++statistics.hits;
+        } else if (firstMissByKey.emplace(key, i).second) {
+            misses.push_back(i);
+            ++statistics.misses;
+        }
+    }
+
+    renderMisses(requests, misses, results);
+
+    // Duplicates of a miss share its render
+    for (size_t i = 0; i < requests.size(); ++i) {
+        if (results[i] == nullptr) {
+            const auto first = firstMissByKey.find(calculateKey(requests[i]));
+            if (first != firstMissByKey.end())
+                results[i] = results[first->second];
+        }
+    }
+
+    return results;
+}
+
+RenderCache::RenderPtr RenderCache::lookUp(const Request& request, juce::uint64 key) {
+    const auto open = openRenders.find(key);
+    if (open != openRenders.end())
+        return open->second;
+
+    auto render = openFile(getFile(key), request, key);
+    if (render != nullptr)
+        openRenders[key] = render;
+    return render;
+}
+
+RenderCache::RenderPtr RenderCache::openFile(const juce::File& file, const Request& request,
+                                             juce::uint64 key) const {
+    if (!file.existsAsFile())
+        return nullptr;
+
+    auto mapped = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+    if (mapped->getData() == nullptr || mapped->getSize() < sizeof(FileHeader))
+        return nullptr;
+
+    FileHeader stored;
+    std::memcpy(&stored, mapped->getData(), sizeof(stored));
+
+    const auto expectedSize =
+        sizeof(FileHeader) + sizeof(float) * static_cast<size_t>(juce::jmax(0, stored.numSamples));
+    if (!matches(stored, makeHeader(request, key, sampleRate, stored.numSamples)) ||
+        mapped->getSize() != expectedSize)
+        return nullptr;
+
+    auto render = std::shared_ptr<Render>(new Render());
+    render->samples = reinterpret_cast<const float*>(static_cast<const char*>(mapped->getData()) +
+                                                     sizeof(FileHeader));
+    render->numSamples = stored.numSamples;
+    render->sampleRate = stored.sampleRate;
+    render->file = std::move(mapped);
+    return render;
+}
+
+RenderCache::RenderPtr RenderCache::store(const Request& request, juce::uint64 key,
+                                          const juce::AudioBuffer<float>& audio) {
+    const auto file = getFile(key);
+    const auto header = makeHeader(request, key, sampleRate, audio.getNumSamples());
+
+    // Write next to the target and swap it in, so readers never see a partial file
+    juce::TemporaryFile temporary(file);
+    {
+        juce::FileOutputStream stream(temporary.getFile());
+        if (!stream.openedOk())
+            return nullptr;
+
+        stream.write(&header, sizeof(header));
+        stream.write(audio.getReadPointer(0),
+                     sizeof(float) * static_cast<size_t>(audio.getNumSamples()));
+        stream.flush();
+
+        if (stream.getStatus().failed())
+            return nullptr;
+    }
+
+    openRenders.erase(key);
+    if (!temporary.overwriteTargetFileWithTemporary())
+        return nullptr;
+
+    return lookUp(request, key);
+}
+
+// Renderers are prepared and released on this (the message) thread; only the block
+// processing runs on the pool
+void RenderCache::renderMisses(const std::vector<Request>& requests,
+                               const std::vector<size_t>& misses,
+                               std::vector<RenderPtr>& results) {
+    if (misses.empty())
+        return;
+
+    const auto numJobs =
+        static_cast<size_t>(juce::jmin(numWorkers, static_cast<int>(misses.size())));
+    while (renderers.size() < numJobs)
+        renderers.push_back(std::make_unique<OfflineRenderer>(sampleRate, BLOCK_SIZE));
+
+    std::vector<std::unique_ptr<Job>> jobs;
+    for (size_t i = 0; i < numJobs; ++i) {
+        jobs.push_back(std::make_unique<Job>());
+        jobs.back()->renderer = renderers[i].get();
+    }
+
+    juce::WaitableEvent jobFinished;
+    size_t nextMiss = 0;
+    size_t numRunning = 0;
+
+    while (nextMiss < misses.size() || numRunning > 0) {
+        for (auto& job : jobs) {
+            if (job->running || nextMiss == misses.size())
+                continue;
+
+            auto& renderer = *job->renderer;
+            const auto& request = requests[misses[nextMiss]];
+            job->requestIndex = misses[nextMiss++];
+            job->midi = renderer.createNoteSequence(request.note);
+            job->output.setSize(1, renderer.getNoteLengthInSamples(request.note));
+            job->finished = false;
+            job->running = true;
+
+            renderer.resetParametersToDefaults();
+            renderer.applyParameterSnapshot(request.parameters);
+            renderer.beginRender();
+            ++numRunning;
+
+            pool.addJob([&job = *job, &jobFinished] {
+                job.renderer->processRender(job.midi, job.output);
+                job.finished = true;
+                jobFinished.signal();
+            });
+        }
+
+        jobFinished.wait();
+
+        for (auto& job : jobs) {
+            if (!job->running || !job->finished.load())
+                continue;
+
+            job->renderer->endRender();
+            const auto& request = requests[job->requestIndex];
+            results[job->requestIndex] = store(request, calculateKey(request), job->output);
+
+            job->running = false;
+            --numRunning;
+        }
+    }
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <map>
+#include <memory>
+#include <vector>
+#include "OfflineRenderer.h"
+
+//==============================================================================
+// On-disk cache of single-note renders for offline jobs such as sound-library
+// generation.
+//
+// A render is keyed by the hash of its parameter snapshot, the note, velocity,
+// hold and release time, and the sample rate. Each entry is one file in the
+// cache directory and hits are served memory-mapped, so they cost a file open
+// rather than a render. Misses are rendered in parallel, one OfflineRenderer
+// per worker.
+//
+// Use from the message thread only; renders are started and finished there
+// (see OfflineRenderer). Entries do not record the engine build: bump
+// CACHE_VERSION, or clear the directory, when the sound changes.
+class RenderCache {
+   public:
+    static constexpr juce::uint32 CACHE_VERSION = 1;
+    static constexpr int BLOCK_SIZE = 512;
+
+    using ParameterSnapshot = std::map<juce::String, float>;  // Plain values by ID
+
+    // Parameters missing from the snapshot render at their defaults
+    struct Request {
+        ParameterSnapshot parameters;
+        OfflineRenderer::Note note;
+    };
+
+    // A cached mono render, mapped read-only from its file
+    class Render {
+       public:
+        const float* getSamples() const noexcept {
+            return samples;
+        }
+        int getNumSamples() const noexcept {
+            return numSamples;
+        }
+        double getSampleRate() const noexcept {
+            return sampleRate;
+        }
+
+        // Copy into a buffer with the given number of channels
+        juce::AudioBuffer<float> toBuffer(int numChannels = 1) const;
+
+       private:
+        friend class RenderCache;
+        Render() = default;
+
+        std::unique_ptr<juce::MemoryMappedFile> file;
+        const float* samples = nullptr;
+        int numSamples = 0;
+        double sampleRate = 0.0;
+    };
+    using RenderPtr = std::shared_ptr<const Render>;
+
+    struct Statistics {
+        int hits = 0;
+        int misses = 0;  // Renders performed; duplicate requests count once
+    };
+
+    explicit RenderCache(const juce::File& directory, double sampleRate = 48000.0,
+                         int numWorkers = juce::SystemStats::getNumCpus());
+    ~RenderCache();
+
+    const juce::File& getDirectory() const {
+        return directory;
+    }
+    double getSampleRate() const {
+        return sampleRate;
+    }
+
+    // Returns one render per request, in order; all misses are rendered first.
+    // An entry is nullptr only if its file could not be written.
+    std::vector<RenderPtr> get(const std::vector<Request>& requests);
+    RenderPtr get(const Request& request);
+
+    Statistics getStatistics() const {
+        return statistics;
+    }
+
+    juce::uint64 calculateKey(const Request& request) const;
+
+   private:
+    struct Job;
+
+    RenderPtr lookUp(const Request& request, juce::uint64 key);
+    RenderPtr store(const Request& request, juce::uint64 key,
+                    const juce::AudioBuffer<float>& audio);
+    RenderPtr openFile(const juce::File& file, const Request& request, juce::uint64 key) const;
+    void renderMisses(const std::vector<Request>& requests, const std::vector<size_t>& misses,
+                      std::vector<RenderPtr>& results);
+    juce::File getFile(juce::uint64 key) const;
+
+    const juce::File directory;
+    const double sampleRate;
+    const int numWorkers;
+
+    std::map<juce::uint64, RenderPtr> openRenders;
+    std::vector<std::unique_ptr<OfflineRenderer>> renderers;
+    juce::ThreadPool pool;
+    Statistics statistics;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RenderCache)
+};
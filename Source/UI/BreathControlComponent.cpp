@@ -44,3 +44,8 @@ void BreathControlComponent::resized() {
 
     flexbox.performLayout(bounds);
 }
+
+void BreathControlComponent::updateFromParameters() {
+    breathVcfAttachment->sendInitialUpdate();
+    breathVcaAttachment->sendInitialUpdate();
+}
@@ -7,6 +7,7 @@ class BreathControlComponent : public juce::Component {
     ~BreathControlComponent() override;
     void paint(juce::Graphics& g) override;
     void resized() override;
+    void updateFromParameters();
 
    private:
     juce::AudioProcessorValueTreeState& valueTreeState;
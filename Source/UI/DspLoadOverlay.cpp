@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    DspLoadOverlay.cpp
+
+  ==============================================================================
+*/
+
+#include "DspLoadOverlay.h"
+
+//==============================================================================
+DspLoadOverlay::DspLoadOverlay(DspProfiler& profilerToShow) : profiler(profilerToShow) {
+    setInterceptsMouseClicks(false, false);
+    setOpaque(false);
+}
+
+void DspLoadOverlay::paint(juce::Graphics& g) {
+    g.setColour(juce::Colours::black.withAlpha(0.7f));
+    g.fillRoundedRectangle(getLocalBounds().toFloat(), 3.0f);
+
+    g.setColour(juce::Colours::yellow);
+    g.setFont(juce::FontOptions(juce::Font::getDefaultMonospacedFontName(), 10.0f,
+                                juce::Font::plain));
+
+    auto area = getLocalBounds().reduced(4, 2);
+    for (const auto& line : lines)
+        g.drawText(line, area.removeFromTop(LINE_HEIGHT), juce::Justification::centredLeft, false);
+}
+
+void DspLoadOverlay::refresh() {
+    if (--framesUntilUpdate > 0)
+        return;
+
+    framesUntilUpdate = FRAMES_PER_UPDATE;
+
+    juce::StringArray newLines;
+    newLines.add("DSP       load    p99 us");
+
+    for (int i = 0; i < DspProfiler::NUM_STAGES; ++i) {
+        const auto stage = static_cast<DspStage>(i);
+        const auto statistics = profiler.getStatistics(stage);
+        if (statistics.numBlocks == 0)
+            continue;
+
+        newLines.add(juce::String(DspProfiler::getStageName(stage)).paddedRight(' ', 9) +
+                     (juce::String(statistics.cpuLoad * 100.0, 1) + "%").paddedLeft(' ', 6) +
+                     juce::String(statistics.p99Microseconds, 1).paddedLeft(' ', 10));
+    }
+
+    if (newLines != lines) {
+        lines.swapWith(newLines);
+        markDirty(*this);
+    }
+}
+
+int DspLoadOverlay::getIdealHeight() const {
+    return (DspProfiler::NUM_STAGES + 1) * LINE_HEIGHT + 4;
+}
@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+    DspLoadOverlay.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "JuceHeader.h"
+#include "../CS01Synth/DspProfiler.h"
+#include "UIRefreshScheduler.h"
+
+//==============================================================================
+/**
+ * Debug overlay listing the DSP load per stage
+ *
+ * Shows the share of the real-time budget and the 99th percentile block time
+ * for every stage that has been measured. The text is rebuilt a few times per
+ * second. The overlay ignores the mouse so it can sit on top of other
+ * components.
+ */
+class DspLoadOverlay : public juce::Component, public UIRefreshScheduler::Client {
+   public:
+    explicit DspLoadOverlay(DspProfiler& profilerToShow);
+    ~DspLoadOverlay() override = default;
+
+    void paint(juce::Graphics& g) override;
+    void refresh() override;
+
+    // Height needed to show every stage
+    int getIdealHeight() const;
+
+   private:
+    static constexpr int FRAMES_PER_UPDATE = 15;
+    static constexpr int LINE_HEIGHT = 12;
+
+    DspProfiler& profiler;
+    juce::StringArray lines;
+    int framesUntilUpdate = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DspLoadOverlay)
+};
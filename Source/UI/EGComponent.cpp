@@ -59,3 +59,10 @@ void EGComponent::resized() {
 
     grid.performLayout(getLocalBounds().reduced(10).withTrimmedTop(20));
 }
+
+void EGComponent::updateFromParameters() {
+    attackAttachment->sendInitialUpdate();
+    decayAttachment->sendInitialUpdate();
+    sustainAttachment->sendInitialUpdate();
+    releaseAttachment->sendInitialUpdate();
+}
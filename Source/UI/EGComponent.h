@@ -7,6 +7,7 @@ class EGComponent : public juce::Component {
     ~EGComponent() override;
     void paint(juce::Graphics& g) override;
     void resized() override;
+    void updateFromParameters();
 
    private:
     juce::AudioProcessorValueTreeState& valueTreeState;
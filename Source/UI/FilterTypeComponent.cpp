@@ -7,8 +7,9 @@ FilterTypeComponent::FilterTypeComponent(juce::AudioProcessorValueTreeState& apv
     filterTypeComboBox.addItem("Modern", 2);
     addAndMakeVisible(filterTypeComboBox);
 
-    filterTypeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
-        valueTreeState, ParameterIds::filterType, filterTypeComboBox);
+    filterTypeAttachment = std::make_unique<juce::ComboBoxParameterAttachment>(
+        *valueTreeState.getParameter(ParameterIds::filterType), filterTypeComboBox,
+        valueTreeState.undoManager);
 }
 
 FilterTypeComponent::~FilterTypeComponent() {}
@@ -26,3 +27,7 @@ void FilterTypeComponent::resized() {
     // Adjust the position of the combo box to align its height with sliders in other components
     filterTypeComboBox.setBounds(bounds.withTrimmedTop(bounds.getHeight() * 0.6f).reduced(5, 5));
 }
+
+void FilterTypeComponent::updateFromParameters() {
+    filterTypeAttachment->sendInitialUpdate();
+}
@@ -7,9 +7,10 @@ class FilterTypeComponent : public juce::Component {
     ~FilterTypeComponent() override;
     void paint(juce::Graphics& g) override;
     void resized() override;
+    void updateFromParameters();
 
    private:
     juce::AudioProcessorValueTreeState& valueTreeState;
     juce::ComboBox filterTypeComboBox;
-    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> filterTypeAttachment;
+    std::unique_ptr<juce::ComboBoxParameterAttachment> filterTypeAttachment;
 };
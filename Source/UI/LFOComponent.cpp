@@ -35,3 +35,7 @@ void LFOComponent::resized() {
 
     grid.performLayout(getLocalBounds().reduced(10).withTrimmedTop(20));
 }
+
+void LFOComponent::updateFromParameters() {
+    lfoSpeedAttachment->sendInitialUpdate();
+}
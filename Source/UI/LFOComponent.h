@@ -7,6 +7,7 @@ class LFOComponent : public juce::Component {
     ~LFOComponent() override;
     void paint(juce::Graphics& g) override;
     void resized() override;
+    void updateFromParameters();
 
    private:
     juce::AudioProcessorValueTreeState& valueTreeState;
@@ -43,7 +43,7 @@ ModulationComponent::ModulationComponent(CS01AudioProcessor& p) : processor(p) {
     lfoTargetParam->addListener(this);
 
     // Initial update
-    parameterValueChanged(lfoTargetParam->getParameterIndex(), lfoTargetParam->getValue());
+    updateLfoTargetButtons();
 }
 
 ModulationComponent::~ModulationComponent() {
@@ -116,14 +116,27 @@ void ModulationComponent::resized() {
 }
 
 void ModulationComponent::parameterValueChanged(int parameterIndex, float newValue) {
-    if (parameterIndex == lfoTargetParam->getParameterIndex()) {
-        if (auto* choiceParam = dynamic_cast<juce::AudioParameterChoice*>(lfoTargetParam)) {
-            lfoTargetButtons[choiceParam->getIndex()]->setToggleState(true,
-                                                                      juce::dontSendNotification);
-        }
+    // May be called on the audio thread (automation, program changes)
+    if (parameterIndex == lfoTargetParam->getParameterIndex())
+        lfoTargetChanged.store(true);
+}
+
+void ModulationComponent::refresh() {
+    if (lfoTargetChanged.exchange(false))
+        updateLfoTargetButtons();
+}
+
+void ModulationComponent::updateLfoTargetButtons() {
+    if (auto* choiceParam = dynamic_cast<juce::AudioParameterChoice*>(lfoTargetParam)) {
+        lfoTargetButtons[choiceParam->getIndex()]->setToggleState(true,
+                                                                  juce::dontSendNotification);
     }
 }
 
 void ModulationComponent::parameterGestureChanged(int parameterIndex, bool gestureIsStarting) {
     // Not needed for this component
 }
+
+void ModulationComponent::updateFromParameters() {
+    lfoTargetChanged.store(true);
+}
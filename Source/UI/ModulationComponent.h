@@ -1,12 +1,14 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "UIRefreshScheduler.h"
 
 class CS01AudioProcessor;
 
 class ModulationComponent : public juce::Component,
                             public juce::AudioProcessorParameter::Listener,
-                            public juce::Slider::Listener {
+                            public juce::Slider::Listener,
+                            public UIRefreshScheduler::Client {
    public:
     ModulationComponent(CS01AudioProcessor& p);
     ~ModulationComponent() override;
@@ -17,8 +19,15 @@ class ModulationComponent : public juce::Component,
     void sliderValueChanged(juce::Slider* slider) override;
     void parameterValueChanged(int parameterIndex, float newValue) override;
     void parameterGestureChanged(int parameterIndex, bool gestureIsStarting) override;
+    void refresh() override;
+    void updateFromParameters();
 
    private:
+    void updateLfoTargetButtons();
+
+    // Set from any thread by parameter changes, applied on the next frame
+    std::atomic<bool> lfoTargetChanged{false};
+
     CS01AudioProcessor& processor;
 
     juce::Slider pitchBendSlider;
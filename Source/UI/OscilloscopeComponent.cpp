@@ -19,65 +19,69 @@ OscilloscopeComponent::OscilloscopeComponent(int initialNumChannels)
       backgroundColour(juce::Colours::black),
       gridColour(juce::Colours::darkgrey.withAlpha(0.5f)),
       waveformThickness(1.5f) {
-    // Initialize audio buffer
+    // Initialize audio buffers
+    fifoBuffer.setSize(numChannels, FIFO_SIZE);
+    fifoBuffer.clear();
     audioDataBuffer.setSize(numChannels, bufferSize);
     audioDataBuffer.clear();
 
-    // Initialize waveform paths
-    waveformPaths.resize(numChannels);
-
-    // Start timer for periodic updates
-    startTimer(50);  // Update every 50ms (20Hz)
+    // Initialize waveform geometry
+    waveformColumns.resize(numChannels);
 }
 
-OscilloscopeComponent::~OscilloscopeComponent() {
-    stopTimer();
-}
+OscilloscopeComponent::~OscilloscopeComponent() = default;
 
 void OscilloscopeComponent::paint(juce::Graphics& g) {
-    // Draw background
-    g.fillAll(backgroundColour);
+    // Draw cached background and grid
+    if (!gridImageValid)
+        renderGridImage();
 
-    // Draw grid lines
-    drawGrid(g);
+    g.drawImage(gridImage, getLocalBounds().toFloat());
 
     // Draw waveforms for all channels
     g.setColour(waveformColour);
-    for (int ch = 0; ch < numChannels; ++ch) {
-        g.strokePath(waveformPaths[ch], juce::PathStrokeType(waveformThickness));
+    for (const auto& columns : waveformColumns) {
+        g.fillRectList(columns);
     }
 }
 
 void OscilloscopeComponent::resized() {
-    // Update waveform path when component size changes
+    // Grid and waveform geometry depend on the component size
+    gridImageValid = false;
     updateWaveformPath();
 }
 
 void OscilloscopeComponent::setNumChannels(int newNumChannels) {
     if (numChannels != newNumChannels) {
-        const juce::ScopedLock lock(mutex);
         numChannels = newNumChannels;
+        fifo.reset();
+        fifoBuffer.setSize(numChannels, FIFO_SIZE, true, true, true);
         audioDataBuffer.setSize(numChannels, bufferSize, true, true, true);
-        waveformPaths.resize(numChannels);
+        waveformColumns.resize(numChannels);
+        gridImageValid = false;
+        updateWaveformPath();
+        repaint();
     }
 }
 
 void OscilloscopeComponent::pushBuffer(const juce::AudioBuffer<float>& buffer) {
-    const juce::ScopedLock lock(mutex);
+    // Triggered mode reads its own snapshots
+    if (triggerSource.load() != nullptr)
+        return;
 
     // Use the smaller of buffer channels and configured channels
     const int numChannelsToPush = juce::jmin(buffer.getNumChannels(), numChannels);
 
-    // Copy data from new buffer for channels to push
-    int numSamples = buffer.getNumSamples();
+    // If the display has fallen behind, drop what does not fit instead of blocking
+    const int numSamples = juce::jmin(buffer.getNumSamples(), fifo.getFreeSpace());
+    const auto scope = fifo.write(numSamples);
 
-    // Process all channels for each sample before moving to the next sample
-    for (int i = 0; i < numSamples; ++i) {
-        for (int ch = 0; ch < numChannelsToPush; ++ch) {
-            audioDataBuffer.setSample(ch, bufferIndex, buffer.getSample(ch, i));
-        }
-        // Increment buffer index after processing all channels for this sample
-        bufferIndex = (bufferIndex + 1) % bufferSize;
+    for (int ch = 0; ch < numChannelsToPush; ++ch) {
+        if (scope.blockSize1 > 0)
+            fifoBuffer.copyFrom(ch, scope.startIndex1, buffer, ch, 0, scope.blockSize1);
+        if (scope.blockSize2 > 0)
+            fifoBuffer.copyFrom(ch, scope.startIndex2, buffer, ch, scope.blockSize1,
+                                scope.blockSize2);
     }
 }
 
@@ -88,76 +92,187 @@ void OscilloscopeComponent::setWaveformColour(juce::Colour newColour) {
 
 void OscilloscopeComponent::setBackgroundColour(juce::Colour newColour) {
     backgroundColour = newColour;
+    gridImageValid = false;
     repaint();
 }
 
 void OscilloscopeComponent::setGridColour(juce::Colour newColour) {
     gridColour = newColour;
+    gridImageValid = false;
     repaint();
 }
 
 void OscilloscopeComponent::setWaveformThickness(float newThickness) {
     waveformThickness = newThickness;
+    updateWaveformPath();
     repaint();
 }
 
-void OscilloscopeComponent::setUpdateRate(int rateMs) {
-    stopTimer();
-    startTimer(rateMs);
-}
-
 void OscilloscopeComponent::setBufferSize(int newBufferSize) {
     if (bufferSize != newBufferSize) {
-        const juce::ScopedLock lock(mutex);
         bufferSize = newBufferSize;
-        audioDataBuffer.setSize(numChannels, bufferSize, true, true, true);
+        bufferIndex = 0;
+        audioDataBuffer.setSize(numChannels, bufferSize, false, true, true);
+        updateWaveformPath();
     }
 }
 
-void OscilloscopeComponent::timerCallback() {
-    updateWaveformPath();
-    repaint();
+void OscilloscopeComponent::setTriggerSource(TriggeredScopeCapture* source) {
+    triggerSource.store(source);
+    fifo.reset();
 }
 
-void OscilloscopeComponent::updateWaveformPath() {
-    const juce::ScopedLock lock(mutex);
+void OscilloscopeComponent::refresh() {
+    if (auto* source = triggerSource.load()) {
+        if (const auto* snapshot = source->acquireLatest()) {
+            loadSnapshot(*snapshot);
+            updateWaveformPath();
+            markDirty(*this);
+        }
+        return;
+    }
 
-    // Get component size
-    float width = static_cast<float>(getWidth());
-    float height = static_cast<float>(getHeight());
+    // Idle scopes do not repaint
+    if (drainFifo()) {
+        updateWaveformPath();
+        markDirty(*this);
+    }
+}
 
-    // Calculate height per channel
-    float channelHeight = height / static_cast<float>(numChannels);
+bool OscilloscopeComponent::drainFifo() {
+    const int numReady = fifo.getNumReady();
+    if (numReady == 0)
+        return false;
 
-    // Create waveform paths for each channel
-    for (int ch = 0; ch < numChannels; ++ch) {
-        // Clear this channel's waveform path
-        waveformPaths[ch].clear();
+    const auto scope = fifo.read(numReady);
 
-        // Calculate center Y position for this channel
-        float centerY = channelHeight * (ch + 0.5f);
+    // Copy one contiguous FIFO region into the circular history buffer
+    const auto copyToHistory = [this](int fifoStart, int numToCopy) {
+        while (numToCopy > 0) {
+            const int chunk = juce::jmin(numToCopy, bufferSize - bufferIndex);
 
-        // Waveform amplitude scale (40% of channel height)
-        float verticalScale = channelHeight * 0.4f;
+            for (int ch = 0; ch < numChannels; ++ch) {
+                audioDataBuffer.copyFrom(ch, bufferIndex, fifoBuffer, ch, fifoStart, chunk);
+            }
 
-        bool pathStarted = false;
+            bufferIndex = (bufferIndex + chunk) % bufferSize;
+            fifoStart += chunk;
+            numToCopy -= chunk;
+        }
+    };
 
-        for (int i = 0; i < bufferSize; ++i) {
-            // Draw sequentially from current position in buffer
-            int index = (bufferIndex + i) % bufferSize;
-            float x = (static_cast<float>(i) / static_cast<float>(bufferSize)) * width;
-            float y = centerY - (audioDataBuffer.getSample(ch, index) * verticalScale);
+    // Only the newest bufferSize samples can be visible
+    int skip = juce::jmax(0, numReady - bufferSize);
+    const int skip1 = juce::jmin(skip, scope.blockSize1);
+    copyToHistory(scope.startIndex1 + skip1, scope.blockSize1 - skip1);
+    skip -= skip1;
+    copyToHistory(scope.startIndex2 + skip, scope.blockSize2 - skip);
 
-            if (!pathStarted) {
-                waveformPaths[ch].startNewSubPath(x, y);
-                pathStarted = true;
-            } else {
-                waveformPaths[ch].lineTo(x, y);
+    return true;
+}
+
+void OscilloscopeComponent::loadSnapshot(const TriggeredScopeCapture::Snapshot& snapshot) {
+    if (snapshot.numSamples < 2)
+        return;
+
+    // Stretch the captured periods over the history buffer, starting exactly at the
+    // zero crossing so consecutive snapshots line up to a fraction of a sample
+    const float start = snapshot.startOffset;
+    const float span = snapshot.triggered
+                           ? snapshot.period * static_cast<float>(snapshot.numPeriods)
+                           : static_cast<float>(snapshot.numSamples - 1);
+    const float step = span / static_cast<float>(bufferSize);
+    float* destination = audioDataBuffer.getWritePointer(0);
+
+    for (int i = 0; i < bufferSize; ++i) {
+        const float position = start + step * static_cast<float>(i);
+        const int index = juce::jmin(static_cast<int>(position), snapshot.numSamples - 2);
+        const float fraction = position - static_cast<float>(index);
+        const float current = snapshot.samples[static_cast<size_t>(index)];
+        const float next = snapshot.samples[static_cast<size_t>(index + 1)];
+        destination[i] = current + (next - current) * fraction;
+    }
+
+    // The output is mono, so every channel shows the same capture
+    for (int ch = 1; ch < numChannels; ++ch) {
+        audioDataBuffer.copyFrom(ch, 0, audioDataBuffer, 0, 0, bufferSize);
+    }
+
+    bufferIndex = 0;
+}
+
+void OscilloscopeComponent::updateWaveformPath() {
+    // Get component size
+    const int width = getWidth();
+    const float height = static_cast<float>(getHeight());
+
+    // One min/max span per pixel column (fewer if there are fewer samples than pixels)
+    const int numColumns = juce::jmax(1, juce::jmin(width, bufferSize));
+    const float columnWidth = static_cast<float>(width) / static_cast<float>(numColumns);
+
+    // Calculate height per channel
+    const float channelHeight = height / static_cast<float>(numChannels);
+
+    for (int ch = 0; ch < numChannels; ++ch) {
+        auto& columns = waveformColumns[ch];
+        columns.clear();
+        columns.ensureStorageAllocated(numColumns);
+
+        // Calculate center Y position and amplitude scale (40% of channel height)
+        const float centerY = channelHeight * (ch + 0.5f);
+        const float verticalScale = channelHeight * 0.4f;
+
+        // Draw sequentially from the oldest sample in the buffer
+        const float* data = audioDataBuffer.getReadPointer(ch);
+        float previous = data[bufferIndex];
+        int sample = 0;
+
+        for (int column = 0; column < numColumns; ++column) {
+            const int end = static_cast<int>(static_cast<juce::int64>(column + 1) * bufferSize /
+                                             numColumns);
+
+            // Start from the previous column's last sample so neighbouring spans connect
+            float low = previous;
+            float high = previous;
+
+            for (; sample < end; ++sample) {
+                int index = bufferIndex + sample;
+                if (index >= bufferSize)
+                    index -= bufferSize;
+
+                previous = data[index];
+                low = juce::jmin(low, previous);
+                high = juce::jmax(high, previous);
             }
+
+            const float top = centerY - high * verticalScale;
+            const float bottom = centerY - low * verticalScale;
+            const float spanHeight = juce::jmax(waveformThickness, bottom - top);
+
+            columns.addWithoutMerging({columnWidth * static_cast<float>(column),
+                                       (top + bottom - spanHeight) * 0.5f, columnWidth,
+                                       spanHeight});
         }
     }
 }
 
+void OscilloscopeComponent::renderGridImage() {
+    gridImageValid = true;
+
+    // Render at the display scale so the cached grid stays sharp
+    const float scale = juce::Component::getApproximateScaleFactorForComponent(this);
+    const int imageWidth = juce::jmax(1, juce::roundToInt(static_cast<float>(getWidth()) * scale));
+    const int imageHeight =
+        juce::jmax(1, juce::roundToInt(static_cast<float>(getHeight()) * scale));
+
+    gridImage = juce::Image(juce::Image::ARGB, imageWidth, imageHeight, true);
+    juce::Graphics g(gridImage);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
+    g.fillAll(backgroundColour);
+    drawGrid(g);
+}
+
 void OscilloscopeComponent::drawGrid(juce::Graphics& g) {
     g.setColour(gridColour);
 
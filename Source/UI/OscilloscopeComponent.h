@@ -11,12 +11,20 @@
 #pragma once
 
 #include "JuceHeader.h"
+#include "../CS01Synth/TriggeredScopeCapture.h"
+#include "UIRefreshScheduler.h"
 
 //==============================================================================
 /**
  * Component for displaying waveforms in an oscilloscope style
+ *
+ * Incoming samples go through a lock-free FIFO. Each display frame drains it into a
+ * history buffer owned by the message thread and reduces the history to one
+ * min/max span per pixel column, so the geometry is at most one rectangle per
+ * column regardless of the buffer size. The background and grid are cached as
+ * an image that is only redrawn when the size or colours change.
  */
-class OscilloscopeComponent : public juce::Component, private juce::Timer {
+class OscilloscopeComponent : public juce::Component, public UIRefreshScheduler::Client {
    public:
     OscilloscopeComponent(int initialNumChannels = 1);
     ~OscilloscopeComponent() override;
@@ -25,11 +33,19 @@ class OscilloscopeComponent : public juce::Component, private juce::Timer {
     void resized() override;
 
     /**
-     * Add a new audio buffer
+     * Add a new audio buffer (lock-free, single producer)
      * @param buffer Audio buffer to display
      */
     void pushBuffer(const juce::AudioBuffer<float>& buffer);
 
+    /**
+     * Display snapshots from an audio-side trigger instead of free-running.
+     * Captured periods are aligned to their zero crossing, so the display is
+     * stable and pushBuffer() is ignored while a source is set.
+     * @param source Trigger capture to read from, or nullptr to free-run
+     */
+    void setTriggerSource(TriggeredScopeCapture* source);
+
     /**
      * Set the waveform color
      * @param newColour New waveform color
@@ -54,12 +70,6 @@ class OscilloscopeComponent : public juce::Component, private juce::Timer {
      */
     void setWaveformThickness(float newThickness);
 
-    /**
-     * Set the update rate (in milliseconds)
-     * @param rateMs Update rate (in milliseconds)
-     */
-    void setUpdateRate(int rateMs);
-
     /**
      * Set the buffer size
      * @param newBufferSize New buffer size
@@ -80,12 +90,27 @@ class OscilloscopeComponent : public juce::Component, private juce::Timer {
         return numChannels;
     }
 
+    /**
+     * Pull new data once per display frame; repaints only when data arrived
+     */
+    void refresh() override;
+
    private:
-    void timerCallback() override;
+    bool drainFifo();
+    void loadSnapshot(const TriggeredScopeCapture::Snapshot& snapshot);
     void updateWaveformPath();
+    void renderGridImage();
     void drawGrid(juce::Graphics& g);
 
-    // Circular buffer to hold waveform data
+    // Lock-free transfer from the producer to the message thread
+    static constexpr int FIFO_SIZE = 8192;
+    juce::AbstractFifo fifo{FIFO_SIZE};
+    juce::AudioBuffer<float> fifoBuffer;
+
+    // Triggered mode source (owned by the processor)
+    std::atomic<TriggeredScopeCapture*> triggerSource{nullptr};
+
+    // Circular buffer to hold waveform data (message thread only)
     juce::AudioBuffer<float> audioDataBuffer;
     int bufferSize;
     int bufferIndex;
@@ -97,11 +122,12 @@ class OscilloscopeComponent : public juce::Component, private juce::Timer {
     juce::Colour gridColour;
     float waveformThickness;
 
-    // Paths for waveform display (one per channel)
-    std::vector<juce::Path> waveformPaths;
+    // Min/max span per pixel column (one list per channel)
+    std::vector<juce::RectangleList<float>> waveformColumns;
 
-    // Synchronization object
-    juce::CriticalSection mutex;
+    // Background and grid, redrawn only on resize or colour changes
+    juce::Image gridImage;
+    bool gridImageValid = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OscilloscopeComponent)
 };
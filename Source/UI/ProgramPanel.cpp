@@ -35,12 +35,10 @@ ProgramPanel::ProgramPanel(juce::AudioProcessor& p) : audioProcessor(p) {
     presetTypeLabel.setFont(juce::Font(12.0f));
     presetTypeLabel.setJustificationType(juce::Justification::centred);
 
-    populateProgramMenu();
-    startTimerHz(10);  // Check for preset changes 10 times per second
+    refresh();
 }
 
 ProgramPanel::~ProgramPanel() {
-    stopTimer();
     programMenu.removeListener(this);
 }
 
@@ -81,7 +79,25 @@ void ProgramPanel::resized() {
     programMenu.setBounds(mainRow);
 }
 
-void ProgramPanel::timerCallback() {
+void ProgramPanel::refresh() {
+    auto* programManager = getProgramManager();
+    if (programManager == nullptr)
+        return;
+
+    // Program changes (host, MIDI) and the preset index bump the change count
+    const int changeCount = programManager->getChangeCount();
+    if (changeCount == lastChangeCount)
+        return;
+
+    lastChangeCount = changeCount;
+
+    if (programManager->getPresetListVersion() != presetListVersion)
+        populateProgramMenu();
+
+    updateProgramState();
+}
+
+void ProgramPanel::updateProgramState() {
     const int currentProgram = audioProcessor.getCurrentProgram();
     if (currentProgram + 1 != programMenu.getSelectedId()) {
         programMenu.setSelectedId(currentProgram + 1, juce::dontSendNotification);
@@ -110,7 +126,10 @@ void ProgramPanel::comboBoxChanged(juce::ComboBox* comboBoxThatHasChanged) {
 }
 
 void ProgramPanel::populateProgramMenu() {
-    programMenu.clear();
+    if (auto* programManager = getProgramManager())
+        presetListVersion = programManager->getPresetListVersion();
+
+    programMenu.clear(juce::dontSendNotification);
     for (int i = 0; i < audioProcessor.getNumPrograms(); ++i) {
         programMenu.addItem(audioProcessor.getProgramName(i), i + 1);  // 1-based ID
     }
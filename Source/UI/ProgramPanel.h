@@ -1,10 +1,13 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "UIRefreshScheduler.h"
 
 class ProgramManager; // Forward declaration
 
-class ProgramPanel : public juce::Component, private juce::ComboBox::Listener, private juce::Timer {
+class ProgramPanel : public juce::Component,
+                     public UIRefreshScheduler::Client,
+                     private juce::ComboBox::Listener {
    public:
     ProgramPanel(juce::AudioProcessor& p);
     ~ProgramPanel() override;
@@ -12,8 +15,11 @@ class ProgramPanel : public juce::Component, private juce::ComboBox::Listener, p
     void paint(juce::Graphics& g) override;
     void resized() override;
 
+    // Updates only when the program manager reports a change
+    void refresh() override;
+
    private:
-    void timerCallback() override;
+    void updateProgramState();
     void comboBoxChanged(juce::ComboBox* comboBoxThatHasChanged) override;
     void populateProgramMenu();
     void loadProgram(int programIndex);
@@ -39,4 +45,7 @@ class ProgramPanel : public juce::Component, private juce::ComboBox::Listener, p
     
     // Add a label to show preset type
     juce::Label presetTypeLabel;
+
+    int presetListVersion = -1;
+    int lastChangeCount = -1;
 };
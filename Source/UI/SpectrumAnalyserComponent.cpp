@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyserComponent.cpp
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyserComponent.h"
+#include "../CS01Synth/IFilter.h"
+
+//==============================================================================
+SpectrumAnalyserComponent::SpectrumAnalyserComponent(SpectrumAnalyser& analyserToShow,
+                                                     FilterProvider filterProvider)
+    : analyser(analyserToShow), getFilter(std::move(filterProvider)) {
+    analyser.setEnabled(true);
+}
+
+SpectrumAnalyserComponent::~SpectrumAnalyserComponent() {
+    analyser.setEnabled(false);
+}
+
+void SpectrumAnalyserComponent::paint(juce::Graphics& g) {
+    g.fillAll(juce::Colours::black);
+
+    // Decade lines and a line every 12 dB
+    g.setColour(juce::Colours::darkgrey.withAlpha(0.5f));
+    for (float frequency : {100.0f, 1000.0f, 10000.0f})
+        g.drawVerticalLine(juce::roundToInt(frequencyToX(frequency)), 0.0f,
+                           static_cast<float>(getHeight()));
+    for (float decibels = 0.0f; decibels > MIN_DECIBELS; decibels -= 12.0f)
+        g.drawHorizontalLine(juce::roundToInt(decibelsToY(decibels)), 0.0f,
+                             static_cast<float>(getWidth()));
+
+    g.setColour(juce::Colours::lime.withAlpha(0.35f));
+    g.fillPath(spectrumPath);
+    g.setColour(juce::Colours::lime);
+    g.strokePath(spectrumPath, juce::PathStrokeType(1.0f));
+
+    g.setColour(juce::Colours::orange);
+    g.strokePath(filterPath, juce::PathStrokeType(1.5f));
+}
+
+void SpectrumAnalyserComponent::resized() {
+    updateSpectrumPath();
+    updateFilterPath();
+}
+
+void SpectrumAnalyserComponent::mouseDown(const juce::MouseEvent& event) {
+    if (event.mods.isPopupMenu())
+        showSettingsMenu();
+}
+
+void SpectrumAnalyserComponent::refresh() {
+    bool changed = false;
+
+    if (analyser.getLatestSpectrum(spectrum, binWidth, spectrumVersion)) {
+        updateSpectrumPath();
+        changed = true;
+    }
+
+    // Cheap: one evaluation per few pixels
+    if (updateFilterPath())
+        changed = true;
+
+    if (changed)
+        markDirty(*this);
+}
+
+void SpectrumAnalyserComponent::updateSpectrumPath() {
+    spectrumPath.clear();
+
+    const float width = static_cast<float>(getWidth());
+    const float bottom = static_cast<float>(getHeight());
+    if (spectrum.size() < 2 || binWidth <= 0.0 || width <= 0.0f)
+        return;
+
+    spectrumPath.startNewSubPath(0.0f, bottom);
+
+    // One point per pixel column; several bins per column keep their maximum so
+    // narrow peaks stay visible in the upper octaves
+    for (float x = 0.0f; x <= width; x += 1.0f) {
+        const double lowBin = xToFrequency(x - 0.5f) / binWidth;
+        const double highBin = xToFrequency(x + 0.5f) / binWidth;
+        const int first = juce::jlimit(1, static_cast<int>(spectrum.size()) - 1,
+                                       static_cast<int>(std::floor(lowBin)));
+        const int last = juce::jlimit(first, static_cast<int>(spectrum.size()) - 1,
+                                      static_cast<int>(std::ceil(highBin)));
+
+        float decibels = spectrum[static_cast<size_t>(first)];
+        for (int bin = first + 1; bin <= last; ++bin)
+            decibels = juce::jmax(decibels, spectrum[static_cast<size_t>(bin)]);
+
+        spectrumPath.lineTo(x, decibelsToY(decibels));
+    }
+
+    spectrumPath.lineTo(width, bottom);
+    spectrumPath.closeSubPath();
+}
+
+bool SpectrumAnalyserComponent::updateFilterPath() {
+    juce::Path newPath;
+
+    auto* filter = getFilter ? getFilter() : nullptr;
+    const float width = static_cast<float>(getWidth());
+
+    if (filter != nullptr && width > 0.0f) {
+        for (float x = 0.0f; x <= width; x += 2.0f) {
+            const float gain = filter->getMagnitudeResponse(xToFrequency(x));
+            const float y = decibelsToY(juce::Decibels::gainToDecibels(gain, MIN_DECIBELS));
+
+            if (x == 0.0f)
+                newPath.startNewSubPath(x, y);
+            else
+                newPath.lineTo(x, y);
+        }
+    }
+
+    // Unchanged cutoff/resonance: nothing to repaint
+    if (newPath == filterPath)
+        return false;
+
+    filterPath.swapWithPath(newPath);
+    return true;
+}
+
+void SpectrumAnalyserComponent::showSettingsMenu() {
+    juce::PopupMenu sizeMenu;
+    for (int order = SpectrumAnalyser::MIN_FFT_ORDER; order <= SpectrumAnalyser::MAX_FFT_ORDER;
+         ++order) {
+        sizeMenu.addItem(juce::String(1 << order), true, analyser.getFftOrder() == order,
+                         [this, order] { analyser.setFftOrder(order); });
+    }
+
+    juce::PopupMenu averagingMenu;
+    const std::pair<const char*, float> averagingOptions[] = {
+        {"Off", 0.0f}, {"Low", 0.5f}, {"Medium", 0.7f}, {"High", 0.9f}};
+    for (const auto& [name, amount] : averagingOptions) {
+        averagingMenu.addItem(name, true, std::abs(analyser.getAveraging() - amount) < 0.01f,
+                              [this, amount = amount] { analyser.setAveraging(amount); });
+    }
+
+    juce::PopupMenu menu;
+    menu.addSubMenu("FFT Size", sizeMenu);
+    menu.addSubMenu("Averaging", averagingMenu);
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(this));
+}
+
+float SpectrumAnalyserComponent::frequencyToX(float frequency) const {
+    const float proportion = std::log(frequency / MIN_FREQUENCY) /
+                             std::log(MAX_FREQUENCY / MIN_FREQUENCY);
+    return proportion * static_cast<float>(getWidth());
+}
+
+float SpectrumAnalyserComponent::xToFrequency(float x) const {
+    const float proportion = x / juce::jmax(1.0f, static_cast<float>(getWidth()));
+    return MIN_FREQUENCY * std::pow(MAX_FREQUENCY / MIN_FREQUENCY, proportion);
+}
+
+float SpectrumAnalyserComponent::decibelsToY(float decibels) const {
+    return juce::jmap(juce::jlimit(MIN_DECIBELS, MAX_DECIBELS, decibels), MAX_DECIBELS,
+                      MIN_DECIBELS, 0.0f, static_cast<float>(getHeight()));
+}
@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyserComponent.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "JuceHeader.h"
+#include "../CS01Synth/SpectrumAnalyser.h"
+#include "UIRefreshScheduler.h"
+
+class IFilter;
+
+//==============================================================================
+/**
+ * Log-frequency spectrum display of the synth output
+ *
+ * The analyser runs only while this component exists. The averaged spectrum
+ * is drawn as a filled curve, and the small-signal response of the active
+ * filter (at its current cutoff and resonance) is overlaid as a line.
+ * Right-click to change the FFT size and the amount of averaging.
+ */
+class SpectrumAnalyserComponent : public juce::Component, public UIRefreshScheduler::Client {
+   public:
+    using FilterProvider = std::function<IFilter*()>;
+
+    /**
+     * @param analyserToShow Analyser owned by the processor
+     * @param filterProvider Returns the active filter (may return nullptr)
+     */
+    SpectrumAnalyserComponent(SpectrumAnalyser& analyserToShow, FilterProvider filterProvider);
+    ~SpectrumAnalyserComponent() override;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    void mouseDown(const juce::MouseEvent& event) override;
+
+    // Picks up new spectra and filter settings once per display frame
+    void refresh() override;
+
+    static constexpr float MIN_FREQUENCY = 20.0f;
+    static constexpr float MAX_FREQUENCY = 20000.0f;
+    static constexpr float MIN_DECIBELS = -90.0f;
+    static constexpr float MAX_DECIBELS = 6.0f;
+
+   private:
+    void updateSpectrumPath();
+    bool updateFilterPath();
+    void showSettingsMenu();
+
+    float frequencyToX(float frequency) const;
+    float xToFrequency(float x) const;
+    float decibelsToY(float decibels) const;
+
+    SpectrumAnalyser& analyser;
+    FilterProvider getFilter;
+
+    std::vector<float> spectrum;
+    double binWidth = 0.0;
+    int spectrumVersion = 0;
+
+    juce::Path spectrumPath;
+    juce::Path filterPath;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyserComponent)
+};
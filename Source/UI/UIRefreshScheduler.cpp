@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    UIRefreshScheduler.cpp
+
+  ==============================================================================
+*/
+
+#include "UIRefreshScheduler.h"
+
+//==============================================================================
+UIRefreshScheduler::Client::~Client() {
+    if (scheduler != nullptr)
+        scheduler->removeClient(*this);
+}
+
+void UIRefreshScheduler::Client::markDirty(juce::Component& component,
+                                           juce::Rectangle<int> area) {
+    if (scheduler != nullptr)
+        scheduler->markDirty(component, area);
+    else
+        component.repaint(area);
+}
+
+void UIRefreshScheduler::Client::markDirty(juce::Component& component) {
+    markDirty(component, component.getLocalBounds());
+}
+
+//==============================================================================
+UIRefreshScheduler::UIRefreshScheduler(juce::Component& hostComponent)
+    : vBlankAttachment(&hostComponent, [this] { dispatchFrame(); }) {}
+
+UIRefreshScheduler::~UIRefreshScheduler() {
+    for (auto* client : clients) {
+        if (client != nullptr)
+            client->scheduler = nullptr;
+    }
+}
+
+void UIRefreshScheduler::addClient(Client& client) {
+    JUCE_ASSERT_MESSAGE_THREAD
+    jassert(client.scheduler == nullptr || client.scheduler == this);
+
+    if (client.scheduler == this)
+        return;
+
+    client.scheduler = this;
+    clients.push_back(&client);
+}
+
+void UIRefreshScheduler::removeClient(Client& client) {
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    const auto found = std::find(clients.begin(), clients.end(), &client);
+    if (found == clients.end())
+        return;
+
+    client.scheduler = nullptr;
+
+    // Clients may unregister from their own refresh(); compact after the frame
+    if (dispatching)
+        *found = nullptr;
+    else
+        clients.erase(found);
+}
+
+void UIRefreshScheduler::markDirty(juce::Component& component, juce::Rectangle<int> area) {
+    area = area.getIntersection(component.getLocalBounds());
+    if (area.isEmpty())
+        return;
+
+    for (auto& region : dirtyRegions) {
+        if (region.component == &component) {
+            region.area.add(area);
+            return;
+        }
+    }
+
+    dirtyRegions.push_back({&component, juce::RectangleList<int>(area)});
+}
+
+void UIRefreshScheduler::dispatchFrame() {
+    dispatching = true;
+
+    // Clients added during the frame are refreshed from the next frame on
+    const auto numClients = clients.size();
+    for (size_t i = 0; i < numClients; ++i) {
+        if (auto* client = clients[i])
+            client->refresh();
+    }
+
+    dispatching = false;
+    clients.erase(std::remove(clients.begin(), clients.end(), nullptr), clients.end());
+
+    flushDirtyRegions();
+}
+
+void UIRefreshScheduler::flushDirtyRegions() {
+    for (auto& region : dirtyRegions) {
+        if (auto* component = region.component.getComponent()) {
+            // Few large rectangles are cheaper to paint than many small ones
+            region.area.consolidate();
+            for (const auto& rectangle : region.area)
+                component->repaint(rectangle);
+        }
+    }
+
+    // Keeps its capacity, so steady-state frames do not allocate
+    dirtyRegions.clear();
+}
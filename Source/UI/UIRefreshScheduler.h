@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    UIRefreshScheduler.h
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "JuceHeader.h"
+#include <vector>
+
+//==============================================================================
+/**
+ * Single display-synced refresh tick for the whole editor
+ *
+ * Instead of every component running its own timer, clients register here and
+ * are called once per display frame (driven by a juce::VBlankAttachment on the
+ * host component). A client checks its data source (usually one atomic load)
+ * and, if something changed, marks the affected region dirty. Dirty regions
+ * are collected per component and flushed together after all clients have run,
+ * so each component is repainted at most once per frame and only where needed.
+ * Nothing is repainted while nothing changes.
+ */
+class UIRefreshScheduler {
+   public:
+    class Client {
+       public:
+        virtual ~Client();
+
+        /** Called on the message thread once per display frame while registered. */
+        virtual void refresh() = 0;
+
+       protected:
+        /** Repaints the given area of a component with the next flush. */
+        void markDirty(juce::Component& component, juce::Rectangle<int> area);
+        void markDirty(juce::Component& component);
+
+       private:
+        friend class UIRefreshScheduler;
+        UIRefreshScheduler* scheduler = nullptr;
+    };
+
+    /**
+     * @param hostComponent Component whose peer provides the display refresh
+     */
+    explicit UIRefreshScheduler(juce::Component& hostComponent);
+    ~UIRefreshScheduler();
+
+    void addClient(Client& client);
+    void removeClient(Client& client);
+
+    /** Queues a repaint of an area; overlapping requests within a frame are merged. */
+    void markDirty(juce::Component& component, juce::Rectangle<int> area);
+
+    /** Runs one frame: refreshes all clients, then flushes the dirty regions. */
+    void dispatchFrame();
+
+    int getNumClients() const noexcept {
+        return static_cast<int>(clients.size());
+    }
+    int getNumDirtyComponents() const noexcept {
+        return static_cast<int>(dirtyRegions.size());
+    }
+
+   private:
+    struct DirtyRegion {
+        juce::Component::SafePointer<juce::Component> component;
+        juce::RectangleList<int> area;
+    };
+
+    void flushDirtyRegions();
+
+    std::vector<Client*> clients;
+    std::vector<DirtyRegion> dirtyRegions;
+    bool dispatching = false;
+
+    juce::VBlankAttachment vBlankAttachment;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(UIRefreshScheduler)
+};
@@ -33,3 +33,7 @@ void VCAComponent::resized() {
 
     grid.performLayout(getLocalBounds().reduced(10).withTrimmedTop(20));
 }
+
+void VCAComponent::updateFromParameters() {
+    vcaEgDepthAttachment->sendInitialUpdate();
+}
@@ -7,6 +7,7 @@ class VCAComponent : public juce::Component {
     ~VCAComponent() override;
     void paint(juce::Graphics& g) override;
     void resized() override;
+    void updateFromParameters();
 
    private:
     juce::AudioProcessorValueTreeState& valueTreeState;
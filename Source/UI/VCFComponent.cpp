@@ -156,3 +156,14 @@ void VCFComponent::resized() {
     resonanceLabel.setBounds(resonanceLabelArea);
     resonanceSliderLabel.setBounds(resonanceLabelArea);
 }
+
+void VCFComponent::updateFromParameters() {
+    cutoffAttachment->sendInitialUpdate();
+    vcfEgDepthAttachment->sendInitialUpdate();
+
+    // Only the attachment for the active filter type exists
+    if (resonanceAttachment)
+        resonanceAttachment->sendInitialUpdate();
+    if (resonanceSliderAttachment)
+        resonanceSliderAttachment->sendInitialUpdate();
+}
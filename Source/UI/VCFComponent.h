@@ -9,6 +9,7 @@ class VCFComponent : public juce::Component {
     ~VCFComponent() override;
     void paint(juce::Graphics& g) override;
     void resized() override;
+    void updateFromParameters();
 
     // Update UI when filter processor changes
     void updateFilterControl(IFilter* filterProcessor);
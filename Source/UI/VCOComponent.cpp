@@ -64,8 +64,7 @@ VCOComponent::VCOComponent(juce::AudioProcessorValueTreeState& apvts) : valueTre
     feetParam->addListener(this);
 
     // Initial update
-    parameterValueChanged(waveTypeParam->getParameterIndex(), waveTypeParam->getValue());
-    parameterValueChanged(feetParam->getParameterIndex(), feetParam->getValue());
+    updateChoiceButtons();
 }
 
 VCOComponent::~VCOComponent() {
@@ -173,18 +172,30 @@ void VCOComponent::resized() {
 }
 
 void VCOComponent::parameterValueChanged(int parameterIndex, float newValue) {
-    if (parameterIndex == waveTypeParam->getParameterIndex()) {
-        if (auto* choiceParam = dynamic_cast<juce::AudioParameterChoice*>(waveTypeParam)) {
-            waveTypeButtons[choiceParam->getIndex()]->setToggleState(true,
-                                                                     juce::dontSendNotification);
-        }
-    } else if (parameterIndex == feetParam->getParameterIndex()) {
-        if (auto* choiceParam = dynamic_cast<juce::AudioParameterChoice*>(feetParam)) {
-            feetButtons[choiceParam->getIndex()]->setToggleState(true, juce::dontSendNotification);
-        }
-    }
+    // May be called on the audio thread (automation, program changes)
+    choicesChanged.store(true);
+}
+
+void VCOComponent::refresh() {
+    if (choicesChanged.exchange(false))
+        updateChoiceButtons();
+}
+
+void VCOComponent::updateChoiceButtons() {
+    if (auto* choiceParam = dynamic_cast<juce::AudioParameterChoice*>(waveTypeParam))
+        waveTypeButtons[choiceParam->getIndex()]->setToggleState(true, juce::dontSendNotification);
+
+    if (auto* choiceParam = dynamic_cast<juce::AudioParameterChoice*>(feetParam))
+        feetButtons[choiceParam->getIndex()]->setToggleState(true, juce::dontSendNotification);
 }
 
 void VCOComponent::parameterGestureChanged(int parameterIndex, bool gestureIsStarting) {
     // Not needed for this component
 }
+
+void VCOComponent::updateFromParameters() {
+    glissandoAttachment->sendInitialUpdate();
+    pitchAttachment->sendInitialUpdate();
+    pwmSpeedAttachment->sendInitialUpdate();
+    choicesChanged.store(true);
+}
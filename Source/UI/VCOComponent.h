@@ -1,7 +1,10 @@
 #pragma once
 #include <JuceHeader.h>
+#include "UIRefreshScheduler.h"
 
-class VCOComponent : public juce::Component, public juce::AudioProcessorParameter::Listener {
+class VCOComponent : public juce::Component,
+                     public juce::AudioProcessorParameter::Listener,
+                     public UIRefreshScheduler::Client {
    public:
     VCOComponent(juce::AudioProcessorValueTreeState& apvts);
     ~VCOComponent() override;
@@ -10,8 +13,15 @@ class VCOComponent : public juce::Component, public juce::AudioProcessorParamete
     void resized() override;
     void parameterValueChanged(int parameterIndex, float newValue) override;
     void parameterGestureChanged(int parameterIndex, bool gestureIsStarting) override;
+    void refresh() override;
+    void updateFromParameters();
 
    private:
+    void updateChoiceButtons();
+
+    // Set from any thread by parameter changes, applied on the next frame
+    std::atomic<bool> choicesChanged{false};
+
     juce::AudioProcessorValueTreeState& valueTreeState;
     juce::Slider glissandoSlider;
     juce::Label glissandoLabel;
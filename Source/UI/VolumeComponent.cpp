@@ -32,3 +32,7 @@ void VolumeComponent::resized() {
     volumeLabel.setBounds(knobArea.getX(), volumeSlider.getBottom(), knobArea.getWidth(),
                           labelHeight);
 }
+
+void VolumeComponent::updateFromParameters() {
+    volumeAttachment->sendInitialUpdate();
+}
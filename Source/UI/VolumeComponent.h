@@ -7,6 +7,7 @@ class VolumeComponent : public juce::Component {
     ~VolumeComponent() override;
     void paint(juce::Graphics& g) override;
     void resized() override;
+    void updateFromParameters();
 
    private:
     juce::AudioProcessorValueTreeState& valueTreeState;
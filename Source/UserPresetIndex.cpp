@@ -0,0 +1,179 @@
+#include "UserPresetIndex.h"
+
+UserPresetIndex::UserPresetIndex() : UserPresetIndex(getDefaultDirectory()) {}
+
+UserPresetIndex::UserPresetIndex(const juce::File& directoryToWatch)
+    : juce::Thread("CS01 Preset Indexer"), directory(directoryToWatch) {
+    startThread(juce::Thread::Priority::low);
+}
+
+UserPresetIndex::~UserPresetIndex() {
+    stopThread(4000);
+}
+
+juce::File UserPresetIndex::getDefaultDirectory() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("CheapSynth01")
+        .getChildFile("UserPresets");
+}
+
+std::vector<UserPresetIndex::Entry> UserPresetIndex::getEntries() const {
+    const juce::ScopedLock lock(entriesLock);
+    return entries;
+}
+
+void UserPresetIndex::requestRescan() {
+    ++requestedScan;
+    notify();
+}
+
+bool UserPresetIndex::waitForRescan(int timeoutMilliseconds) {
+    const int request = ++requestedScan;
+    notify();
+
+    const auto deadline =
+        juce::Time::getMillisecondCounter() + static_cast<juce::uint32>(timeoutMilliseconds);
+
+    while (completedScan.load() < request) {
+        const auto now = juce::Time::getMillisecondCounter();
+        if (now >= deadline)
+            return false;
+
+        // Short slices so several waiters can share the auto-reset event
+        scanFinished.wait(static_cast<double>(juce::jmin<juce::uint32>(deadline - now, 10)));
+    }
+
+    return true;
+}
+
+void UserPresetIndex::run() {
+    while (!threadShouldExit()) {
+        const int request = requestedScan.load();
+
+        // The first finished scan is published even when it found nothing, so listeners
+        // know the list is complete
+        const bool firstScan = generation.load() == 0;
+
+        if (scanDirectory() || (firstScan && !threadShouldExit())) {
+            ++generation;
+            sendChangeMessage();
+        }
+
+        completedScan.store(request);
+        scanFinished.signal();
+
+        // JUCE has no portable directory watcher; listing is cheap, parsing only happens
+        // for files that changed
+        wait(POLL_INTERVAL_MS);
+    }
+}
+
+bool UserPresetIndex::scanDirectory() {
+    std::map<juce::String, Entry> found;
+    bool changed = false;
+
+    if (directory.isDirectory()) {
+        for (const auto& item : juce::RangedDirectoryIterator(directory, false, "*.xml",
+                                                              juce::File::findFiles)) {
+            if (threadShouldExit())
+                return false;
+
+            const auto file = item.getFile();
+            const auto filename = file.getFileName();
+            const auto previous = indexedFiles.find(filename);
+
+            if (previous != indexedFiles.end() &&
+                previous->second.modificationTime == item.getModificationTime() &&
+                previous->second.fileSize == item.getFileSize()) {
+                found.emplace(filename, previous->second);
+                continue;
+            }
+
+            Entry entry;
+            entry.name = file.getFileNameWithoutExtension();
+            entry.filename = filename;
+            entry.modificationTime = item.getModificationTime();
+            entry.fileSize = item.getFileSize();
+
+            if (!parsePresetFile(file, entry)) {
+                // Possibly still being written; keep the last good version until the next poll
+                if (previous != indexedFiles.end())
+                    found.emplace(filename, previous->second);
+                continue;
+            }
+
+            // A touched file with identical contents does not need republishing
+            if (previous == indexedFiles.end() ||
+                previous->second.parameterHash != entry.parameterHash)
+                changed = true;
+
+            found.emplace(filename, std::move(entry));
+        }
+    }
+
+    for (const auto& indexed : indexedFiles) {
+        if (found.find(indexed.first) == found.end())
+            changed = true;
+    }
+
+    indexedFiles.swap(found);
+
+    if (changed) {
+        std::vector<Entry> sorted;
+        sorted.reserve(indexedFiles.size());
+        for (const auto& indexed : indexedFiles)
+            sorted.push_back(indexed.second);
+
+        std::sort(sorted.begin(), sorted.end(),
+                  [](const Entry& a, const Entry& b) { return a.name < b.name; });
+
+        const juce::ScopedLock lock(entriesLock);
+        entries.swap(sorted);
+    }
+
+    return changed;
+}
+
+bool UserPresetIndex::parsePresetFile(const juce::File& file, Entry& entry) {
+    auto xml = juce::XmlDocument::parse(file);
+    if (xml == nullptr)
+        return false;
+
+    auto values = std::make_shared<std::map<juce::String, float>>();
+    for (auto* child : xml->getChildWithTagNameIterator("PARAM")) {
+        if (child->hasAttribute("id") && child->hasAttribute("value")) {
+            (*values)[child->getStringAttribute("id")] =
+                static_cast<float>(child->getDoubleAttribute("value"));
+        }
+    }
+
+    entry.parameterHash = calculateParameterHash(*values);
+    entry.values = std::move(values);
+    return true;
+}
+
+juce::uint64 UserPresetIndex::calculateParameterHash(const std::map<juce::String, float>& values) {
+    // FNV-1a over "id=value" pairs; std::map keeps them in a stable order
+    juce::uint64 hash = 14695981039346656037ull;
+
+    const auto addBytes = [&hash](const void* data, size_t numBytes) {
+        const auto* bytes = static_cast<const juce::uint8*>(data);
+        for (size_t i = 0; i < numBytes; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+
+    for (const auto& [id, value] : values) {
+        addBytes(id.toRawUTF8(), id.getNumBytesAsUTF8());
+
+        const char separator = '=';
+        addBytes(&separator, 1);
+
+        juce::uint32 bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        addBytes(&bits, sizeof(bits));
+    }
+
+    return hash;
+}
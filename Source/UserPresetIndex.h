@@ -0,0 +1,75 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <map>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+// Process-wide index of the user preset directory.
+//
+// A background thread lists the directory, parses only files that are new or
+// whose modification time/size changed, and publishes the result. Plugin
+// instances share one index through juce::SharedResourcePointer, so opening a
+// session with many instances scans the directory once, and constructing an
+// instance never touches the disk. Listeners are notified on the message
+// thread whenever the set of presets or their contents change.
+class UserPresetIndex : public juce::ChangeBroadcaster, private juce::Thread {
+   public:
+    struct Entry {
+        juce::String name;
+        juce::String filename;
+        juce::Time modificationTime;
+        juce::int64 fileSize = 0;
+        juce::uint64 parameterHash = 0;  // FNV-1a of the sorted id/value pairs
+
+        // Raw (denormalised) values by parameter ID, shared between snapshots
+        std::shared_ptr<const std::map<juce::String, float>> values;
+    };
+
+    UserPresetIndex();
+    explicit UserPresetIndex(const juce::File& directoryToWatch);
+    ~UserPresetIndex() override;
+
+    static juce::File getDefaultDirectory();
+    const juce::File& getDirectory() const {
+        return directory;
+    }
+
+    // Current entries sorted by name. Empty until the first scan has finished.
+    std::vector<Entry> getEntries() const;
+    // 0 until the first scan has finished, then increased whenever the entries change
+    int getGeneration() const noexcept {
+        return generation.load();
+    }
+
+    // Asks the indexer to rescan now instead of at the next poll
+    void requestRescan();
+
+    // Requests a rescan and blocks until it has completed
+    bool waitForRescan(int timeoutMilliseconds);
+
+    static juce::uint64 calculateParameterHash(const std::map<juce::String, float>& values);
+
+   private:
+    void run() override;
+    bool scanDirectory();
+    static bool parsePresetFile(const juce::File& file, Entry& entry);
+
+    static constexpr int POLL_INTERVAL_MS = 1000;
+
+    const juce::File directory;
+
+    juce::CriticalSection entriesLock;
+    std::vector<Entry> entries;
+    std::atomic<int> generation{0};
+
+    // Only touched by the indexer thread
+    std::map<juce::String, Entry> indexedFiles;
+
+    std::atomic<int> requestedScan{0};
+    std::atomic<int> completedScan{0};
+    juce::WaitableEvent scanFinished;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(UserPresetIndex)
+};
@@ -2,37 +2,53 @@
 
 namespace BinaryData
 {
-    // Simple XML for default preset
+    // Default preset (same format as Source/Resources/Presets/Default.xml)
     const char* defaultPreset_xml = 
-        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
-        "<PRESET name=\"Default\">"
-        "  <PARAMETERS>"
-        "    <PARAM id=\"vco_waveform\" value=\"0\"/>"
-        "    <PARAM id=\"vco_octave\" value=\"0\"/>"
-        "    <PARAM id=\"vcf_cutoff\" value=\"0.7\"/>"
-        "    <PARAM id=\"vcf_resonance\" value=\"0.3\"/>"
-        "    <PARAM id=\"vcf_eg_intensity\" value=\"0.5\"/>"
-        "    <PARAM id=\"eg_attack\" value=\"0.1\"/>"
-        "    <PARAM id=\"eg_decay\" value=\"0.3\"/>"
-        "    <PARAM id=\"eg_sustain\" value=\"0.7\"/>"
-        "    <PARAM id=\"eg_release\" value=\"0.2\"/>"
-        "    <PARAM id=\"lfo_waveform\" value=\"0\"/>"
-        "    <PARAM id=\"lfo_rate\" value=\"0.4\"/>"
-        "    <PARAM id=\"lfo_intensity\" value=\"0.2\"/>"
-        "    <PARAM id=\"vca_level\" value=\"0.8\"/>"
-        "    <PARAM id=\"breath_control\" value=\"0.0\"/>"
-        "  </PARAMETERS>"
-        "</PRESET>";
+        "<Parameters>"
+        "  <PARAM id=\"WAVE_TYPE\" value=\"1\"/>"
+        "  <PARAM id=\"FEET\" value=\"2\"/>"
+        "  <PARAM id=\"CUTOFF\" value=\"20000.0\"/>"
+        "  <PARAM id=\"RESONANCE\" value=\"0.3\"/>"
+        "  <PARAM id=\"ATTACK\" value=\"0.1\"/>"
+        "  <PARAM id=\"DECAY\" value=\"0.1\"/>"
+        "  <PARAM id=\"SUSTAIN\" value=\"0.8\"/>"
+        "  <PARAM id=\"RELEASE\" value=\"0.1\"/>"
+        "  <PARAM id=\"FILTER_TYPE\" value=\"0\"/>"
+        "</Parameters>";
     
     const int defaultPreset_xmlSize = static_cast<int>(std::strlen(defaultPreset_xml));
+
+    // Second preset with clearly different values for program change tests
+    const char* flutePreset_xml =
+        "<Parameters>"
+        "  <PARAM id=\"WAVE_TYPE\" value=\"0\"/>"
+        "  <PARAM id=\"FEET\" value=\"2\"/>"
+        "  <PARAM id=\"CUTOFF\" value=\"3000.0\"/>"
+        "  <PARAM id=\"RESONANCE\" value=\"0.35\"/>"
+        "  <PARAM id=\"ATTACK\" value=\"1.2\"/>"
+        "  <PARAM id=\"DECAY\" value=\"1.5\"/>"
+        "  <PARAM id=\"SUSTAIN\" value=\"0.8\"/>"
+        "  <PARAM id=\"RELEASE\" value=\"0.8\"/>"
+        "  <PARAM id=\"FILTER_TYPE\" value=\"0\"/>"
+        "</Parameters>";
+
+    const int flutePreset_xmlSize = static_cast<int>(std::strlen(flutePreset_xml));
     
     const char* getNamedResource(const char* resourceNameUTF8, int& dataSizeInBytes)
     {
-        if (std::strcmp(resourceNameUTF8, "Default.xml") == 0)
+        // ProgramManager asks for "<file>_xml", as generated by juce_add_binary_data
+        if (std::strcmp(resourceNameUTF8, "Default_xml") == 0 ||
+            std::strcmp(resourceNameUTF8, "Default.xml") == 0)
         {
             dataSizeInBytes = defaultPreset_xmlSize;
             return defaultPreset_xml;
         }
+
+        if (std::strcmp(resourceNameUTF8, "Flute_xml") == 0)
+        {
+            dataSizeInBytes = flutePreset_xmlSize;
+            return flutePreset_xml;
+        }
         
         dataSizeInBytes = 0;
         return nullptr;
@@ -12,4 +12,6 @@ namespace BinaryData
     extern const char* getNamedResource(const char* resourceNameUTF8, int& dataSizeInBytes);
     extern const char* defaultPreset_xml;
     extern const int defaultPreset_xmlSize;
+    extern const char* flutePreset_xml;
+    extern const int flutePreset_xmlSize;
 }
@@ -0,0 +1,174 @@
+#include "GoldenAudio.h"
+#include <cmath>
+
+namespace {
+constexpr int FFT_ORDER = 12;
+constexpr int FFT_SIZE = 1 << FFT_ORDER;
+
+struct Biquad {
+    double b0, b1, b2, a1, a2;
+    double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+
+    double process(double x) noexcept {
+        const double y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+        return y;
+    }
+};
+
+float toDecibels(double power, float floor) {
+    return power > 0.0 ? juce::jmax(floor, static_cast<float>(10.0 * std::log10(power))) : floor;
+}
+
+float round2(double value) {
+    return static_cast<float>(std::round(value * 100.0) / 100.0);
+}
+
+// Largest difference after clamping both sides to the floor
+float maxDifference(const std::vector<float>& a, const std::vector<float>& b, float floor) {
+    float largest = 0.0f;
+    for (size_t i = 0; i < a.size(); ++i)
+        largest = juce::jmax(largest, std::abs(juce::jmax(a[i], floor) - juce::jmax(b[i], floor)));
+    return largest;
+}
+
+juce::var toArray(const std::vector<float>& values) {
+    juce::Array<juce::var> array;
+    for (auto value : values)
+        array.add(round2(value));
+    return array;
+}
+
+std::vector<float> fromArray(const juce::var& value) {
+    std::vector<float> values;
+    if (auto* array = value.getArray()) {
+        for (const auto& element : *array)
+            values.push_back(static_cast<float>(static_cast<double>(element)));
+    }
+    return values;
+}
+}  // namespace
+
+const std::vector<double>& GoldenAudio::getBandCentres() {
+    static const std::vector<double> centres = [] {
+        std::vector<double> result;
+        for (int k = -16; k <= 12; ++k)
+            result.push_back(1000.0 * std::pow(2.0, k / 3.0));
+        return result;
+    }();
+    return centres;
+}
+
+double GoldenAudio::measureLoudness(const float* samples, int numSamples) {
+    if (numSamples <= 0)
+        return LOUDNESS_FLOOR_LUFS;
+
+    // BS.1770 K-weighting at 48 kHz: high shelf, then the RLB high-pass
+    Biquad shelf{1.53512485958697, -2.69169618940638, 1.19839281085285, -1.69065929318241,
+                 0.73248077421585};
+    Biquad highPass{1.0, -2.0, 1.0, -1.99004745483398, 0.99007225036621};
+
+    double sumOfSquares = 0.0;
+    for (int i = 0; i < numSamples; ++i) {
+        const double weighted = highPass.process(shelf.process(samples[i]));
+        sumOfSquares += weighted * weighted;
+    }
+
+    const double meanSquare = sumOfSquares / numSamples;
+    if (meanSquare <= 0.0)
+        return LOUDNESS_FLOOR_LUFS;
+
+    return juce::jmax(LOUDNESS_FLOOR_LUFS, -0.691 + 10.0 * std::log10(meanSquare));
+}
+
+GoldenAudio::Fingerprint GoldenAudio::analyse(const juce::AudioBuffer<float>& audio,
+                                              int heldSamples) {
+    Fingerprint fingerprint;
+    const float* samples = audio.getReadPointer(0);
+    const int numSamples = audio.getNumSamples();
+
+    fingerprint.loudness = measureLoudness(samples, numSamples);
+
+    // Envelope
+    const int windowSize = juce::roundToInt(ENVELOPE_WINDOW_SECONDS * SAMPLE_RATE);
+    for (int start = 0; start + windowSize <= numSamples; start += windowSize) {
+        double sumOfSquares = 0.0;
+        for (int i = start; i < start + windowSize; ++i)
+            sumOfSquares += static_cast<double>(samples[i]) * samples[i];
+        fingerprint.envelope.push_back(toDecibels(sumOfSquares / windowSize, ENVELOPE_FLOOR_DB));
+    }
+
+    // Averaged power spectrum of the held part: Hann window, 50 % overlap
+    juce::dsp::FFT fft(FFT_ORDER);
+    juce::dsp::WindowingFunction<float> window(FFT_SIZE,
+                                               juce::dsp::WindowingFunction<float>::hann, false);
+    std::vector<float> frame(FFT_SIZE * 2);
+    std::vector<double> power(FFT_SIZE / 2 + 1, 0.0);
+
+    const int held = juce::jlimit(0, numSamples, heldSamples);
+    for (int start = 0; start < juce::jmax(1, held - FFT_SIZE + 1); start += FFT_SIZE / 2) {
+        std::fill(frame.begin(), frame.end(), 0.0f);
+        std::copy(samples + start, samples + juce::jmin(held, start + FFT_SIZE), frame.begin());
+        window.multiplyWithWindowingTable(frame.data(), FFT_SIZE);
+        fft.performFrequencyOnlyForwardTransform(frame.data(), true);
+
+        for (size_t bin = 0; bin < power.size(); ++bin)
+            power[bin] += static_cast<double>(frame[bin]) * frame[bin];
+    }
+
+    const double binWidth = SAMPLE_RATE / FFT_SIZE;
+    double total = 0.0;
+    for (size_t bin = 1; bin < power.size(); ++bin)
+        total += power[bin];
+
+    for (auto centre : getBandCentres()) {
+        const double low = centre * std::pow(2.0, -1.0 / 6.0);
+        const double high = centre * std::pow(2.0, 1.0 / 6.0);
+
+        double bandPower = 0.0;
+        for (size_t bin = 1; bin < power.size(); ++bin) {
+            const double frequency = static_cast<double>(bin) * binWidth;
+            if (frequency >= low && frequency < high)
+                bandPower += power[bin];
+        }
+
+        fingerprint.spectrum.push_back(
+            total > 0.0 ? toDecibels(bandPower / total, SPECTRUM_FLOOR_DB) : SPECTRUM_FLOOR_DB);
+    }
+
+    return fingerprint;
+}
+
+GoldenAudio::Delta GoldenAudio::compare(const Fingerprint& golden, const Fingerprint& actual) {
+    Delta delta;
+    delta.loudnessLu = std::abs(golden.loudness - actual.loudness);
+
+    if (golden.envelope.size() != actual.envelope.size() ||
+        golden.spectrum.size() != actual.spectrum.size()) {
+        delta.shapeMismatch = true;
+        return delta;
+    }
+
+    delta.envelopeDb = maxDifference(golden.envelope, actual.envelope, ENVELOPE_FLOOR_DB);
+    delta.spectrumDb = maxDifference(golden.spectrum, actual.spectrum, SPECTRUM_FLOOR_DB);
+    return delta;
+}
+
+juce::var GoldenAudio::toVar(const Fingerprint& fingerprint) {
+    auto object = std::make_unique<juce::DynamicObject>();
+    object->setProperty("loudness", round2(fingerprint.loudness));
+    object->setProperty("envelope", toArray(fingerprint.envelope));
+    object->setProperty("spectrum", toArray(fingerprint.spectrum));
+    return juce::var(object.release());
+}
+
+GoldenAudio::Fingerprint GoldenAudio::fromVar(const juce::var& value) {
+    Fingerprint fingerprint;
+    fingerprint.loudness = static_cast<double>(value.getProperty("loudness", LOUDNESS_FLOOR_LUFS));
+    fingerprint.envelope = fromArray(value.getProperty("envelope", {}));
+    fingerprint.spectrum = fromArray(value.getProperty("spectrum", {}));
+    return fingerprint;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+/**
+ * Audio fingerprints for golden-render regression tests
+ *
+ * Renders are not compared sample by sample: an optimisation that shifts a
+ * phase or rounds differently would fail such a test without being audible.
+ * Instead each render is reduced to
+ *
+ * - a level envelope (RMS in dB per 20 ms window)             - time domain
+ * - third-octave band levels relative to the total power of
+ *   the held part of the note                                  - spectral
+ * - integrated loudness (ITU-R BS.1770 K-weighting, ungated)   - perceptual
+ *
+ * and compared against stored fingerprints with per-measure tolerances.
+ * Analysis expects 48 kHz mono audio (the K-weighting coefficients are the
+ * BS.1770 ones for that rate).
+ */
+namespace GoldenAudio {
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr double ENVELOPE_WINDOW_SECONDS = 0.02;
+constexpr float ENVELOPE_FLOOR_DB = -60.0f;  // Quieter windows count as silence
+constexpr float SPECTRUM_FLOOR_DB = -50.0f;  // Relative to the total power
+constexpr double LOUDNESS_FLOOR_LUFS = -100.0;
+
+struct Fingerprint {
+    double loudness = LOUDNESS_FLOOR_LUFS;  // LUFS
+    std::vector<float> envelope;            // dB per window
+    std::vector<float> spectrum;            // dB per third-octave band
+};
+
+struct Tolerances {
+    float envelopeDb = 1.0f;
+    float spectrumDb = 1.5f;
+    double loudnessLu = 0.5;
+};
+
+struct Delta {
+    float envelopeDb = 0.0f;  // Largest per-window difference
+    float spectrumDb = 0.0f;  // Largest per-band difference
+    double loudnessLu = 0.0;  // Absolute difference
+    bool shapeMismatch = false;
+
+    bool isWithin(const Tolerances& tolerances) const {
+        return !shapeMismatch && envelopeDb <= tolerances.envelopeDb &&
+               spectrumDb <= tolerances.spectrumDb && loudnessLu <= tolerances.loudnessLu;
+    }
+};
+
+// Third-octave band centres, 25 Hz to 16 kHz
+const std::vector<double>& getBandCentres();
+
+/**
+ * @param audio       Mono render (channel 0 is used)
+ * @param heldSamples Length of the note-on part; the spectrum is taken from it
+ */
+Fingerprint analyse(const juce::AudioBuffer<float>& audio, int heldSamples);
+double measureLoudness(const float* samples, int numSamples);
+
+Delta compare(const Fingerprint& golden, const Fingerprint& actual);
+
+juce::var toVar(const Fingerprint& fingerprint);
+Fingerprint fromVar(const juce::var& value);
+}  // namespace GoldenAudio
@@ -0,0 +1,326 @@
+#include "RealtimeSafety.h"
+#include "../Source/CS01Synth/RealtimeScope.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+// Set by Tests/CMakeLists.txt together with the matching -Wl,--wrap options
+#ifndef CS01_REALTIME_WRAP_SYMBOLS
+#define CS01_REALTIME_WRAP_SYMBOLS 0
+#endif
+
+#if CS01_REALTIME_WRAP_SYMBOLS
+#include <pthread.h>
+
+extern "C" {
+void* __real_malloc(std::size_t size);
+void* __real_calloc(std::size_t count, std::size_t size);
+void* __real_realloc(void* pointer, std::size_t size);
+void __real_free(void* pointer);
+int __real_pthread_mutex_lock(pthread_mutex_t* mutex);
+}
+#endif
+
+namespace {
+// Constant-initialised, so reading them never allocates
+thread_local int scopeDepth = 0;
+thread_local const char* scopeName = nullptr;
+
+std::atomic<int> allocations{0};
+std::atomic<int> deallocations{0};
+std::atomic<int> blockingLocks{0};
+std::atomic<int> lockAcquisitions{0};
+std::atomic<const char*> firstScope{nullptr};
+std::atomic<juce::int64> heapBytesInUse{0};
+
+bool isInRealtimeScope() noexcept {
+    return scopeDepth > 0;
+}
+
+void recordViolation(std::atomic<int>& counter) noexcept {
+    counter.fetch_add(1, std::memory_order_relaxed);
+
+    const char* expected = nullptr;
+    firstScope.compare_exchange_strong(expected, scopeName);
+}
+
+// Usable size of a malloc block; counted the same way on allocation and free, so the
+// total returns to where it was once everything is released
+std::size_t getBlockSize(void* pointer) noexcept {
+    if (pointer == nullptr)
+        return 0;
+#if defined(__APPLE__)
+    return malloc_size(pointer);
+#elif defined(_WIN32)
+    return _msize(pointer);
+#else
+    return malloc_usable_size(pointer);
+#endif
+}
+
+void countAllocated(void* pointer) noexcept {
+    heapBytesInUse.fetch_add(static_cast<juce::int64>(getBlockSize(pointer)),
+                             std::memory_order_relaxed);
+}
+
+void countFreed(void* pointer) noexcept {
+    heapBytesInUse.fetch_sub(static_cast<juce::int64>(getBlockSize(pointer)),
+                             std::memory_order_relaxed);
+}
+
+void* rawAllocate(std::size_t size) noexcept {
+#if CS01_REALTIME_WRAP_SYMBOLS
+    auto* pointer = __real_malloc(size);
+#else
+    auto* pointer = std::malloc(size);
+#endif
+    countAllocated(pointer);
+    return pointer;
+}
+
+void rawFree(void* pointer) noexcept {
+    countFreed(pointer);
+#if CS01_REALTIME_WRAP_SYMBOLS
+    __real_free(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+
+void* allocate(std::size_t size) noexcept {
+    if (isInRealtimeScope())
+        recordViolation(allocations);
+
+    return rawAllocate(size == 0 ? 1 : size);
+}
+
+// Over-allocates and keeps the original pointer just below the aligned block,
+// which works with any malloc
+void* allocateAligned(std::size_t size, std::align_val_t alignment) noexcept {
+    if (isInRealtimeScope())
+        recordViolation(allocations);
+
+    const auto align = std::max(static_cast<std::size_t>(alignment), alignof(void*));
+    auto* raw = static_cast<char*>(rawAllocate(size + align + sizeof(void*)));
+    if (raw == nullptr)
+        return nullptr;
+
+    auto address = reinterpret_cast<std::uintptr_t>(raw + sizeof(void*));
+    address = (address + align - 1) & ~static_cast<std::uintptr_t>(align - 1);
+
+    auto* aligned = reinterpret_cast<void**>(address);
+    aligned[-1] = raw;
+    return aligned;
+}
+
+void deallocate(void* pointer) noexcept {
+    if (pointer == nullptr)
+        return;
+
+    if (isInRealtimeScope())
+        recordViolation(deallocations);
+
+    rawFree(pointer);
+}
+
+void deallocateAligned(void* pointer) noexcept {
+    if (pointer == nullptr)
+        return;
+
+    if (isInRealtimeScope())
+        recordViolation(deallocations);
+
+    rawFree(static_cast<void**>(pointer)[-1]);
+}
+
+void* allocateOrThrow(std::size_t size) {
+    if (auto* pointer = allocate(size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* allocateAlignedOrThrow(std::size_t size, std::align_val_t alignment) {
+    if (auto* pointer = allocateAligned(size, alignment))
+        return pointer;
+    throw std::bad_alloc();
+}
+}  // namespace
+
+//==============================================================================
+void RealtimeScope::enter(const char* name) noexcept {
+    // Nested scopes report the outermost one
+    if (scopeDepth++ == 0)
+        scopeName = name;
+}
+
+void RealtimeScope::exit() noexcept {
+    if (--scopeDepth == 0)
+        scopeName = nullptr;
+}
+
+//==============================================================================
+void RealtimeSafety::reset() noexcept {
+    allocations.store(0);
+    deallocations.store(0);
+    blockingLocks.store(0);
+    lockAcquisitions.store(0);
+    firstScope.store(nullptr);
+}
+
+RealtimeSafety::Report RealtimeSafety::getReport() noexcept {
+    Report report;
+    report.allocations = allocations.load();
+    report.deallocations = deallocations.load();
+    report.blockingLocks = blockingLocks.load();
+    report.lockAcquisitions = lockAcquisitions.load();
+    report.firstScope = firstScope.load();
+    return report;
+}
+
+juce::String RealtimeSafety::describe(const Report& report) {
+    juce::String text;
+    text << "Real-time safety violated in "
+         << (report.firstScope != nullptr ? report.firstScope : "an unnamed scope") << ": "
+         << report.allocations << " allocation(s), " << report.deallocations << " free(s), "
+         << report.blockingLocks << " blocking lock(s)";
+    return text;
+}
+
+juce::int64 RealtimeSafety::getHeapBytesInUse() noexcept {
+    return heapBytesInUse.load();
+}
+
+bool RealtimeSafety::canDetectLocks() noexcept {
+    return CS01_REALTIME_WRAP_SYMBOLS != 0;
+}
+
+//==============================================================================
+// Replaceable global allocation functions (all platforms)
+void* operator new(std::size_t size) {
+    return allocateOrThrow(size);
+}
+void* operator new[](std::size_t size) {
+    return allocateOrThrow(size);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocateAlignedOrThrow(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocateAlignedOrThrow(size, alignment);
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept {
+    deallocate(pointer);
+}
+void operator delete[](void* pointer) noexcept {
+    deallocate(pointer);
+}
+void operator delete(void* pointer, std::size_t) noexcept {
+    deallocate(pointer);
+}
+void operator delete[](void* pointer, std::size_t) noexcept {
+    deallocate(pointer);
+}
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    deallocate(pointer);
+}
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    deallocate(pointer);
+}
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    deallocateAligned(pointer);
+}
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    deallocateAligned(pointer);
+}
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+    deallocateAligned(pointer);
+}
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+    deallocateAligned(pointer);
+}
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    deallocateAligned(pointer);
+}
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    deallocateAligned(pointer);
+}
+
+//==============================================================================
+// Link-time wrappers (Linux): every object in the test binary, JUCE included,
+// calls these instead of the C library functions
+#if CS01_REALTIME_WRAP_SYMBOLS
+extern "C" {
+void* __wrap_malloc(std::size_t size) {
+    if (isInRealtimeScope())
+        recordViolation(allocations);
+    auto* pointer = __real_malloc(size);
+    countAllocated(pointer);
+    return pointer;
+}
+
+void* __wrap_calloc(std::size_t count, std::size_t size) {
+    if (isInRealtimeScope())
+        recordViolation(allocations);
+    auto* pointer = __real_calloc(count, size);
+    countAllocated(pointer);
+    return pointer;
+}
+
+void* __wrap_realloc(void* pointer, std::size_t size) {
+    if (isInRealtimeScope())
+        recordViolation(allocations);
+
+    // The old block is gone only if realloc succeeded (or freed it for size 0)
+    const auto oldSize = static_cast<juce::int64>(getBlockSize(pointer));
+    auto* result = __real_realloc(pointer, size);
+    if (result != nullptr || size == 0) {
+        heapBytesInUse.fetch_sub(oldSize, std::memory_order_relaxed);
+        countAllocated(result);
+    }
+    return result;
+}
+
+void __wrap_free(void* pointer) {
+    if (pointer != nullptr && isInRealtimeScope())
+        recordViolation(deallocations);
+    countFreed(pointer);
+    __real_free(pointer);
+}
+
+int __wrap_pthread_mutex_lock(pthread_mutex_t* mutex) {
+    if (isInRealtimeScope()) {
+        // A free mutex costs an atomic operation; only waiting is a problem
+        if (pthread_mutex_trylock(mutex) == 0) {
+            lockAcquisitions.fetch_add(1, std::memory_order_relaxed);
+            return 0;
+        }
+
+        recordViolation(blockingLocks);
+    }
+
+    return __real_pthread_mutex_lock(mutex);
+}
+}
+#endif
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+
+/**
+ * Real-time safety checks for the test binary
+ *
+ * Code marked with CS01_REALTIME_SCOPE (CS01AudioProcessor::processBlock and
+ * everything it calls, including every graph node) is watched while it runs:
+ *
+ * - Heap allocations and frees are counted. operator new/delete are replaced
+ *   on every platform; on Linux malloc/calloc/realloc/free are wrapped at link
+ *   time as well, which also catches JUCE's HeapBlock and C code.
+ * - On Linux, pthread_mutex_lock is wrapped. A lock that is free is only
+ *   counted (JUCE itself takes uncontended locks around every node's
+ *   processBlock and in its MIDI collector); one that would block is a
+ *   violation.
+ *
+ * Violations are collected from any thread until reset().
+ *
+ * The same hooks keep a running total of the heap in use (usable block sizes),
+ * which the memory footprint tests read. Off Linux only C++ allocations are seen.
+ */
+namespace RealtimeSafety {
+struct Report {
+    int allocations = 0;
+    int deallocations = 0;
+    int blockingLocks = 0;
+    int lockAcquisitions = 0;            // Uncontended; informational
+    const char* firstScope = nullptr;    // Scope of the first violation
+
+    bool hasViolations() const {
+        return allocations > 0 || deallocations > 0 || blockingLocks > 0;
+    }
+};
+
+void reset() noexcept;
+Report getReport() noexcept;
+juce::String describe(const Report& report);
+
+// Bytes currently allocated by the whole process, from any thread
+juce::int64 getHeapBytesInUse() noexcept;
+
+// False where mutexes cannot be intercepted (anything but Linux)
+bool canDetectLocks() noexcept;
+}  // namespace RealtimeSafety
+
+/**
+ * Base fixture for integration tests: fails the test if any marked scope
+ * violated real-time safety while it ran
+ */
+class RealtimeSafeTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        RealtimeSafety::reset();
+    }
+
+    void TearDown() override
+    {
+        const auto report = RealtimeSafety::getReport();
+        EXPECT_FALSE(report.hasViolations()) << RealtimeSafety::describe(report);
+    }
+};
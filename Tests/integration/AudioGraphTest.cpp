@@ -2,20 +2,12 @@
 #include <JuceHeader.h>
 #include "../../Source/CS01AudioProcessor.h"
 #include "../../Source/Parameters.h"
+#include "../RealtimeSafety.h"
 
-// Test fixture for AudioGraph integration tests
-class AudioGraphTest : public ::testing::Test
+// Test fixture for AudioGraph integration tests. Every processBlock call is checked for
+// allocations and blocking locks on the audio thread.
+class AudioGraphTest : public RealtimeSafeTest
 {
-protected:
-    void SetUp() override
-    {
-        // Test setup if needed
-    }
-    
-    void TearDown() override
-    {
-        // Test cleanup if needed
-    }
 };
 
 TEST_F(AudioGraphTest, ProcessorCreation)
@@ -275,3 +267,178 @@ TEST_F(AudioGraphTest, ProgramChangeEffect)
     // Clean up
     processor->releaseResources();
 }
+
+TEST_F(AudioGraphTest, FixedInternalProcessingRate)
+{
+    std::unique_ptr<CS01AudioProcessor> processor = std::make_unique<CS01AudioProcessor>();
+    auto& apvts = processor->getValueTreeState();
+
+    // Host mode runs the engine at the host rate without added latency
+    processor->prepareToPlay(44100.0, 512);
+    EXPECT_DOUBLE_EQ(processor->getEngineSampleRate(), 44100.0);
+    EXPECT_EQ(processor->getLatencySamples(), 0);
+
+    // Switch to a fixed 48 kHz engine and re-prepare as the host would
+    auto* rateParam = apvts.getParameter(ParameterIds::processingRate);
+    ASSERT_NE(rateParam, nullptr);
+    rateParam->setValueNotifyingHost(rateParam->convertTo0to1(1.0f));
+    processor->prepareToPlay(44100.0, 512);
+
+    EXPECT_DOUBLE_EQ(processor->getEngineSampleRate(), 48000.0);
+    EXPECT_GT(processor->getLatencySamples(), 0) << "Resampling latency should be reported";
+
+    // The resampled output should still produce sound for a note
+    juce::AudioBuffer<float> buffer(2, 512);
+    juce::MidiBuffer midiBuffer;
+    midiBuffer.addEvent(juce::MidiMessage::noteOn(1, 60, 1.0f), 0);
+
+    float sum = 0.0f;
+    for (int i = 0; i < 10; ++i)
+    {
+        buffer.clear();
+        processor->processBlock(buffer, midiBuffer);
+        midiBuffer.clear();
+    }
+
+    for (int i = 0; i < buffer.getNumSamples(); ++i)
+    {
+        sum += std::abs(buffer.getSample(0, i));
+
+        // Both channels carry the same mono signal
+        EXPECT_FLOAT_EQ(buffer.getSample(0, i), buffer.getSample(1, i));
+    }
+
+    EXPECT_GT(sum, 0.0001f) << "Audio buffer should contain signal in fixed-rate mode";
+
+    // Oversized host blocks are split internally
+    juce::AudioBuffer<float> largeBuffer(2, 2000);
+    largeBuffer.clear();
+    processor->processBlock(largeBuffer, midiBuffer);
+    EXPECT_GT(largeBuffer.getMagnitude(0, 0, largeBuffer.getNumSamples()), 0.0f);
+
+    processor->releaseResources();
+}
+
+TEST_F(AudioGraphTest, MidiProgramChange)
+{
+    std::unique_ptr<CS01AudioProcessor> processor = std::make_unique<CS01AudioProcessor>();
+    auto& apvts = processor->getValueTreeState();
+    processor->prepareToPlay(44100.0, 512);
+
+    int fluteProgram = -1;
+    for (int i = 0; i < processor->getNumPrograms(); ++i)
+    {
+        if (processor->getProgramName(i) == "Flute")
+            fluteProgram = i;
+    }
+
+    ASSERT_GE(fluteProgram, 0) << "Flute preset should be available";
+    ASSERT_LT(fluteProgram, 128);
+
+    // Program change arrives in the middle of a block
+    juce::AudioBuffer<float> buffer(2, 512);
+    juce::MidiBuffer midiBuffer;
+    midiBuffer.addEvent(juce::MidiMessage::noteOn(1, 60, 1.0f), 0);
+    midiBuffer.addEvent(juce::MidiMessage::programChange(1, fluteProgram), 200);
+    processor->processBlock(buffer, midiBuffer);
+    midiBuffer.clear();
+
+    // Switches change at the event, continuous parameters follow within the ramp time
+    EXPECT_EQ(processor->getCurrentProgram(), fluteProgram);
+    EXPECT_EQ(static_cast<int>(apvts.getRawParameterValue(ParameterIds::waveType)->load()), 0);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        processor->processBlock(buffer, midiBuffer);
+    }
+
+    EXPECT_NEAR(apvts.getRawParameterValue(ParameterIds::cutoff)->load(), 3000.0f, 1.0f);
+
+    processor->releaseResources();
+}
+
+TEST_F(AudioGraphTest, TailLengthFollowsSettings)
+{
+    auto processor = std::make_unique<CS01AudioProcessor>();
+    auto& apvts = processor->getValueTreeState();
+    auto* release = apvts.getParameter(ParameterIds::release);
+
+    // Release, then the filter and VCA ringing down
+    release->setValueNotifyingHost(release->convertTo0to1(2.0f));
+    const double longTail = processor->getTailLengthSeconds();
+    EXPECT_GT(longTail, 2.0);
+    EXPECT_LT(longTail, 4.0);
+
+    release->setValueNotifyingHost(release->convertTo0to1(0.1f));
+    const double shortTail = processor->getTailLengthSeconds();
+    EXPECT_GT(shortTail, 0.1);
+    EXPECT_NEAR(longTail - shortTail, 1.9, 0.01);
+
+    // A low, resonant cutoff rings longer
+    auto* cutoff = apvts.getParameter(ParameterIds::cutoff);
+    auto* resonance = apvts.getParameter(ParameterIds::resonance);
+    cutoff->setValueNotifyingHost(0.0f);
+    resonance->setValueNotifyingHost(1.0f);
+    EXPECT_GT(processor->getTailLengthSeconds(), shortTail);
+}
+
+TEST_F(AudioGraphTest, IdleAfterTail)
+{
+    constexpr double sampleRate = 44100.0;
+    constexpr int blockSize = 512;
+
+    auto processor = std::make_unique<CS01AudioProcessor>();
+    processor->prepareToPlay(sampleRate, blockSize);
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midiBuffer;
+
+    // Nothing has played yet
+    buffer.clear();
+    processor->processBlock(buffer, midiBuffer);
+    EXPECT_TRUE(processor->isIdle());
+
+    midiBuffer.addEvent(juce::MidiMessage::noteOn(1, 60, 1.0f), 0);
+    for (int i = 0; i < 10; ++i)
+    {
+        buffer.clear();
+        processor->processBlock(buffer, midiBuffer);
+        midiBuffer.clear();
+    }
+    EXPECT_FALSE(processor->isIdle());
+
+    // The tail is reported from the settings in use when the note ends
+    const double tailSeconds = processor->getTailLengthSeconds();
+    const int tailBlocks = static_cast<int>(std::ceil(tailSeconds * sampleRate / blockSize));
+
+    midiBuffer.addEvent(juce::MidiMessage::noteOff(1, 60), 0);
+    int blocks = 0;
+    while (!processor->isIdle() && blocks <= tailBlocks + 2)
+    {
+        buffer.clear();
+        processor->processBlock(buffer, midiBuffer);
+        midiBuffer.clear();
+        ++blocks;
+    }
+    EXPECT_TRUE(processor->isIdle()) << "Not idle after " << blocks << " blocks";
+    EXPECT_LE(blocks, tailBlocks + 2);
+    EXPECT_LT(buffer.getMagnitude(0, 0, blockSize), 0.001f);
+
+    // Idle blocks are silent, and the next note plays at once
+    buffer.applyGain(0.0f);
+    buffer.setSample(0, 0, 1.0f);
+    processor->processBlock(buffer, midiBuffer);
+    EXPECT_EQ(buffer.getMagnitude(0, blockSize), 0.0f);
+
+    midiBuffer.addEvent(juce::MidiMessage::noteOn(1, 60, 1.0f), 0);
+    for (int i = 0; i < 10; ++i)
+    {
+        buffer.clear();
+        processor->processBlock(buffer, midiBuffer);
+        midiBuffer.clear();
+    }
+    EXPECT_FALSE(processor->isIdle());
+    EXPECT_GT(buffer.getMagnitude(0, 0, blockSize), 0.0001f);
+
+    processor->releaseResources();
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../RealtimeSafety.h"
+#include "../../Source/OfflineRenderer.h"
+#include "../../Source/Parameters.h"
+
+// Offline renders must be bit-identical for the same input, whatever the block size
+class DeterministicRenderTest : public RealtimeSafeTest
+{
+protected:
+    static constexpr double SAMPLE_RATE = 48000.0;
+    static constexpr int NUM_SAMPLES = 24000;
+
+    // A short phrase with a legato change, pitch bend and a note-off/note-on pair at one sample
+    static juce::MidiBuffer makePhrase()
+    {
+        juce::MidiBuffer midi;
+        midi.addEvent(juce::MidiMessage::noteOn(1, 60, 1.0f), 0);
+        midi.addEvent(juce::MidiMessage::noteOn(1, 67, 0.8f), 3001);
+        midi.addEvent(juce::MidiMessage::pitchWheel(1, 10000), 7777);
+        midi.addEvent(juce::MidiMessage::noteOff(1, 60), 9000);
+        midi.addEvent(juce::MidiMessage::noteOff(1, 67), 12345);
+        midi.addEvent(juce::MidiMessage::noteOn(1, 72, 1.0f), 12345);
+        midi.addEvent(juce::MidiMessage::noteOff(1, 72), 18000);
+        return midi;
+    }
+
+    static juce::uint64 renderHash(int blockSize, const juce::MidiBuffer& midi, int feet = 2)
+    {
+        OfflineRenderer renderer(SAMPLE_RATE, blockSize);
+        renderer.setParameter(ParameterIds::feet, static_cast<float>(feet));
+        renderer.setParameter(ParameterIds::lfoSpeed, 7.0f);
+        renderer.setParameter(ParameterIds::modDepth, 0.5f);
+
+        juce::AudioBuffer<float> output(1, NUM_SAMPLES);
+        renderer.render(midi, output);
+        return OfflineRenderer::calculateContentHash(output);
+    }
+};
+
+TEST_F(DeterministicRenderTest, RepeatedRendersAreBitIdentical)
+{
+    const auto midi = makePhrase();
+
+    OfflineRenderer renderer(SAMPLE_RATE, 512);
+    juce::AudioBuffer<float> first(1, NUM_SAMPLES);
+    juce::AudioBuffer<float> second(1, NUM_SAMPLES);
+    renderer.render(midi, first);
+    renderer.render(midi, second);
+
+    EXPECT_GT(first.getMagnitude(0, 0, NUM_SAMPLES), 0.01f);
+    EXPECT_EQ(OfflineRenderer::calculateContentHash(first),
+              OfflineRenderer::calculateContentHash(second));
+}
+
+TEST_F(DeterministicRenderTest, BlockSizeDoesNotChangeOutput)
+{
+    const auto midi = makePhrase();
+    const auto reference = renderHash(512, midi);
+
+    for (int blockSize : {1, 31, 64, 100, 441, 4096})
+        EXPECT_EQ(renderHash(blockSize, midi), reference) << "Block size " << blockSize;
+}
+
+TEST_F(DeterministicRenderTest, NoiseIsSeeded)
+{
+    const auto midi = makePhrase();
+    constexpr int whiteNoise = 4;
+
+    EXPECT_EQ(renderHash(512, midi, whiteNoise), renderHash(256, midi, whiteNoise));
+}
+
+TEST_F(DeterministicRenderTest, SimultaneousEventsHaveAFixedOrder)
+{
+    // Same events, note-on inserted before the note-off at the shared position
+    juce::MidiBuffer reordered;
+    reordered.addEvent(juce::MidiMessage::noteOn(1, 60, 1.0f), 0);
+    reordered.addEvent(juce::MidiMessage::noteOn(1, 67, 0.8f), 3001);
+    reordered.addEvent(juce::MidiMessage::pitchWheel(1, 10000), 7777);
+    reordered.addEvent(juce::MidiMessage::noteOff(1, 60), 9000);
+    reordered.addEvent(juce::MidiMessage::noteOn(1, 72, 1.0f), 12345);
+    reordered.addEvent(juce::MidiMessage::noteOff(1, 67), 12345);
+    reordered.addEvent(juce::MidiMessage::noteOff(1, 72), 18000);
+
+    EXPECT_EQ(renderHash(512, reordered), renderHash(512, makePhrase()));
+}
+
+TEST_F(DeterministicRenderTest, LatencyIsOneQuantum)
+{
+    OfflineRenderer renderer(SAMPLE_RATE, 512);
+    auto& processor = renderer.getProcessor();
+    processor.prepareToPlay(SAMPLE_RATE, 512);
+
+    EXPECT_TRUE(processor.isDeterministic());
+    EXPECT_EQ(processor.getLatencySamples(), CS01AudioProcessor::RENDER_QUANTUM);
+
+    processor.releaseResources();
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../../Source/CS01Synth/DspKernels.h"
+
+// Throughput of every kernel variant this machine can run, on the VCO pitch and VCA gain
+// work of one block. Timings are reported, not asserted, so the test stays stable on slow
+// machines.
+class DspKernelsBenchmarkTest : public ::testing::Test
+{
+protected:
+    static constexpr int NUM_SAMPLES = 512;
+    static constexpr int NUM_BLOCKS = 2000;
+
+    static std::vector<float> makeRandom(juce::Random& random, float minimum, float maximum)
+    {
+        std::vector<float> values(static_cast<size_t>(NUM_SAMPLES));
+        for (auto& value : values)
+            value = minimum + random.nextFloat() * (maximum - minimum);
+        return values;
+    }
+};
+
+TEST_F(DspKernelsBenchmarkTest, ThroughputPerVariant)
+{
+    juce::Random random(4);
+    const auto pitches = makeRandom(random, 36.0f, 96.0f);
+    const auto eg = makeRandom(random, 0.0f, 1.0f);
+    std::vector<float> work(static_cast<size_t>(NUM_SAMPLES));
+
+    for (const auto* variant : DspKernels::getSupported())
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+        for (int block = 0; block < NUM_BLOCKS; ++block)
+        {
+            std::copy(pitches.begin(), pitches.end(), work.begin());
+            variant->pitchToPhaseIncrement(work.data(), NUM_SAMPLES, 440.0f / 48000.0f);
+            variant->applyVCAGain(work.data(), eg.data(), NUM_SAMPLES, 0.8f, 1.0f, 0.9f);
+        }
+        const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+
+        const double nsPerSample = juce::Time::highResolutionTicksToSeconds(elapsed) * 1.0e9 /
+                                   (NUM_BLOCKS * NUM_SAMPLES);
+        RecordProperty(variant->name, (juce::String(nsPerSample, 3) + " ns per sample").toStdString());
+        ASSERT_TRUE(std::isfinite(work.front()));
+    }
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../GoldenAudio.h"
+#include "../RealtimeSafety.h"
+#include "../../Source/OfflineRenderer.h"
+#include "../../Source/Parameters.h"
+
+// Golden-render regression suite: every factory preset x note range x waveform x filter type
+// is rendered headless and compared with the stored fingerprints in Tests/golden.
+//
+// Regenerate after an intended change to the sound with
+//   CS01_UPDATE_GOLDEN=1 ./CheapSynth01Tests --gtest_filter=GoldenAudioTest.*
+// and commit the updated golden_fingerprints.json. Per-case deltas are written to
+// golden_report.csv in the working directory.
+class GoldenAudioTest : public RealtimeSafeTest
+{
+protected:
+    static constexpr double HOLD_SECONDS = 0.6;
+    static constexpr double RELEASE_SECONDS = 0.4;
+    static constexpr int NOTES[] = {36, 60, 84};
+    static constexpr const char* WAVEFORMS[] = {"Triangle", "Sawtooth", "Square", "Pulse", "PWM"};
+    static constexpr const char* FILTER_TYPES[] = {"Original", "Modern"};
+
+    static juce::File getGoldenFile()
+    {
+        return juce::File(CS01_GOLDEN_DIR).getChildFile("golden_fingerprints.json");
+    }
+
+    static bool isUpdating()
+    {
+        return juce::SystemStats::getEnvironmentVariable("CS01_UPDATE_GOLDEN", {}).isNotEmpty();
+    }
+
+    static juce::AudioBuffer<float> makeSine(float frequency, float amplitude, int numSamples)
+    {
+        juce::AudioBuffer<float> buffer(1, numSamples);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double phase = juce::MathConstants<double>::twoPi * frequency * i /
+                                 GoldenAudio::SAMPLE_RATE;
+            buffer.setSample(0, i, amplitude * static_cast<float>(std::sin(phase)));
+        }
+        return buffer;
+    }
+};
+
+TEST_F(GoldenAudioTest, LoudnessOfReferenceSine)
+{
+    // BS.1770: a full-scale 1 kHz sine reads -3.01 LUFS
+    const auto sine = makeSine(1000.0f, 1.0f, 48000);
+    EXPECT_NEAR(GoldenAudio::measureLoudness(sine.getReadPointer(0), sine.getNumSamples()),
+                -3.01, 0.05);
+}
+
+TEST_F(GoldenAudioTest, FingerprintTracksLevelAndSpectrum)
+{
+    const auto reference = makeSine(440.0f, 0.5f, 48000);
+    const auto quieter = makeSine(440.0f, 0.5f * juce::Decibels::decibelsToGain(-2.0f), 48000);
+    const auto higher = makeSine(1760.0f, 0.5f, 48000);
+
+    const auto referencePrint = GoldenAudio::analyse(reference, 48000);
+    const GoldenAudio::Tolerances tolerances;
+
+    // Identical input, identical fingerprint (also through the JSON round trip)
+    const auto roundTrip = GoldenAudio::fromVar(GoldenAudio::toVar(referencePrint));
+    EXPECT_TRUE(GoldenAudio::compare(referencePrint, roundTrip).isWithin(tolerances));
+
+    // A level change shows in loudness and envelope but not in the spectral shape
+    const auto levelDelta = GoldenAudio::compare(referencePrint, GoldenAudio::analyse(quieter, 48000));
+    EXPECT_NEAR(levelDelta.loudnessLu, 2.0, 0.05);
+    EXPECT_NEAR(levelDelta.envelopeDb, 2.0f, 0.05f);
+    EXPECT_LT(levelDelta.spectrumDb, 0.1f);
+    EXPECT_FALSE(levelDelta.isWithin(tolerances));
+
+    // Moving the tone two octaves changes the spectrum
+    const auto pitchDelta = GoldenAudio::compare(referencePrint, GoldenAudio::analyse(higher, 48000));
+    EXPECT_GT(pitchDelta.spectrumDb, 20.0f);
+}
+
+TEST_F(GoldenAudioTest, RenderMatrixMatchesGolden)
+{
+    const bool updating = isUpdating();
+    const auto goldenFile = getGoldenFile();
+
+    // A missing file must not pass as a clean run, or every change to the sound goes unchecked
+    if (!updating && !goldenFile.existsAsFile())
+        FAIL() << "No golden renders at " << goldenFile.getFullPathName()
+               << "; record them on the reference build with CS01_UPDATE_GOLDEN=1 and commit them";
+
+    const auto golden = updating ? juce::var() : juce::JSON::parse(goldenFile);
+    auto recorded = std::make_unique<juce::DynamicObject>();
+
+    OfflineRenderer renderer(GoldenAudio::SAMPLE_RATE, 512);
+    auto& processor = renderer.getProcessor();
+    const GoldenAudio::Tolerances tolerances;
+
+    juce::String report = "case,envelope_db,spectrum_db,loudness_lu,status\n";
+    int numCases = 0;
+    int numFailures = 0;
+    int numMissing = 0;
+
+    for (int program = 0; program < processor.getNumPrograms(); ++program)
+    {
+        if (processor.getPresetManager().getPresetType(program) != PresetType::Factory)
+            continue;
+
+        for (int note : NOTES)
+        {
+            for (int waveform = 0; waveform < juce::numElementsInArray(WAVEFORMS); ++waveform)
+            {
+                for (int filterType = 0; filterType < juce::numElementsInArray(FILTER_TYPES);
+                     ++filterType)
+                {
+                    const auto caseName = processor.getProgramName(program) + "/" +
+                                          juce::MidiMessage::getMidiNoteName(note, true, true, 3) +
+                                          "/" + WAVEFORMS[waveform] + "/" +
+                                          FILTER_TYPES[filterType];
+
+                    renderer.loadProgram(program);
+                    renderer.setParameter(ParameterIds::waveType, static_cast<float>(waveform));
+                    renderer.setParameter(ParameterIds::filterType, static_cast<float>(filterType));
+
+                    const auto audio = renderer.renderNote({note, 1.0f, HOLD_SECONDS, RELEASE_SECONDS});
+                    const auto fingerprint = GoldenAudio::analyse(
+                        audio, juce::roundToInt(HOLD_SECONDS * GoldenAudio::SAMPLE_RATE));
+                    ++numCases;
+
+                    if (updating)
+                    {
+                        recorded->setProperty(caseName, GoldenAudio::toVar(fingerprint));
+                        continue;
+                    }
+
+                    const auto stored = golden.getProperty(caseName, {});
+                    if (stored.isVoid())
+                    {
+                        ++numMissing;
+                        report << caseName << ",,,,missing\n";
+                        continue;
+                    }
+
+                    const auto delta = GoldenAudio::compare(GoldenAudio::fromVar(stored), fingerprint);
+                    const bool passed = delta.isWithin(tolerances);
+                    report << caseName << "," << delta.envelopeDb << "," << delta.spectrumDb << ","
+                           << delta.loudnessLu << "," << (passed ? "ok" : "FAIL") << "\n";
+
+                    if (!passed)
+                    {
+                        ++numFailures;
+                        ADD_FAILURE() << caseName << ": envelope " << delta.envelopeDb
+                                      << " dB, spectrum " << delta.spectrumDb << " dB, loudness "
+                                      << delta.loudnessLu << " LU"
+                                      << (delta.shapeMismatch ? " (length changed)" : "");
+                    }
+                }
+            }
+        }
+    }
+
+    if (updating)
+    {
+        goldenFile.getParentDirectory().createDirectory();
+        ASSERT_TRUE(goldenFile.replaceWithText(
+            juce::JSON::toString(juce::var(recorded.release()), false, 2)));
+        RecordProperty("recordedCases", numCases);
+        RecordProperty("goldenFile", goldenFile.getFullPathName().toStdString());
+        return;
+    }
+
+    juce::File::getCurrentWorkingDirectory().getChildFile("golden_report.csv").replaceWithText(report);
+    RecordProperty("goldenCases", numCases);
+    RecordProperty("outsideTolerance", numFailures);
+    RecordProperty("withoutGoldenData", numMissing);
+
+#if CS01_ENABLE_PROFILING
+    RecordProperty("dspProfile", processor.getDspProfiler().createReport().toStdString());
+#endif
+
+    EXPECT_EQ(numMissing, 0) << "The render matrix has cases the golden file does not cover";
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include <iostream>
+#include "../../Source/CS01AudioProcessor.h"
+#include "../../Source/Parameters.h"
+#include "../RealtimeSafety.h"
+
+// Cost of creating instances, as when a host loads a session with many of them, and of
+// preparing them again, as on a sample rate or block size change.
+// Timings are reported, not asserted, so the test stays stable on slow machines.
+class InstantiationBenchmarkTest : public RealtimeSafeTest
+{
+protected:
+    static constexpr double SAMPLE_RATE = 48000.0;
+    static constexpr int BLOCK_SIZE = 512;
+    static constexpr int NUM_INSTANCES = 100;
+    static constexpr int NUM_BLOCKS = 20;
+
+    template <typename Function>
+    static double measureMilliseconds(Function&& function)
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+        function();
+        const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+        return juce::Time::highResolutionTicksToSeconds(elapsed) * 1000.0;
+    }
+
+    // One held note, rendered into a single buffer
+    static juce::AudioBuffer<float> render(CS01AudioProcessor& processor)
+    {
+        juce::AudioBuffer<float> output(2, BLOCK_SIZE * NUM_BLOCKS);
+        juce::AudioBuffer<float> buffer(2, BLOCK_SIZE);
+        juce::MidiBuffer midiBuffer;
+        midiBuffer.addEvent(juce::MidiMessage::noteOn(1, 60, 1.0f), 0);
+
+        for (int block = 0; block < NUM_BLOCKS; ++block)
+        {
+            buffer.clear();
+            processor.processBlock(buffer, midiBuffer);
+            midiBuffer.clear();
+
+            for (int channel = 0; channel < 2; ++channel)
+                output.copyFrom(channel, block * BLOCK_SIZE, buffer, channel, 0, BLOCK_SIZE);
+        }
+
+        return output;
+    }
+};
+
+TEST_F(InstantiationBenchmarkTest, ConstructAndPrepare)
+{
+    std::vector<std::unique_ptr<CS01AudioProcessor>> processors;
+    processors.reserve(NUM_INSTANCES);
+
+    const double construct = measureMilliseconds([&] {
+        for (int i = 0; i < NUM_INSTANCES; ++i)
+            processors.push_back(std::make_unique<CS01AudioProcessor>());
+    });
+    const double prepare = measureMilliseconds([&] {
+        for (auto& processor : processors)
+            processor->prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+    });
+    const double prepareAgain = measureMilliseconds([&] {
+        for (auto& processor : processors)
+            processor->prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+    });
+    const double prepareNewRate = measureMilliseconds([&] {
+        for (auto& processor : processors)
+            processor->prepareToPlay(44100.0, BLOCK_SIZE * 2);
+    });
+
+    std::cout << "x" << NUM_INSTANCES << ": construct " << construct << " ms, prepare "
+              << prepare << " ms, prepare again " << prepareAgain
+              << " ms, prepare at a new rate " << prepareNewRate << " ms" << std::endl;
+
+    for (auto& processor : processors)
+        processor->releaseResources();
+}
+
+TEST_F(InstantiationBenchmarkTest, PrepareKeepsTheGraph)
+{
+    CS01AudioProcessor processor;
+    auto* filter = processor.getCurrentFilterProcessor();
+    ASSERT_NE(filter, nullptr);
+
+    processor.prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+    EXPECT_EQ(processor.getCurrentFilterProcessor(), filter);
+
+    processor.prepareToPlay(44100.0, BLOCK_SIZE);
+    EXPECT_EQ(processor.getCurrentFilterProcessor(), filter);
+
+    processor.releaseResources();
+}
+
+TEST_F(InstantiationBenchmarkTest, PreparedAgainSoundsLikeNew)
+{
+    CS01AudioProcessor fresh;
+    fresh.prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+    const auto expected = render(fresh);
+    fresh.releaseResources();
+
+    // A note left sounding, then a new spec and back: every node starts over
+    CS01AudioProcessor reused;
+    reused.prepareToPlay(44100.0, BLOCK_SIZE);
+    render(reused);
+    reused.prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+    const auto output = render(reused);
+    reused.releaseResources();
+
+    ASSERT_GT(expected.getMagnitude(0, 0, expected.getNumSamples()), 0.0f);
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        for (int i = 0; i < output.getNumSamples(); ++i)
+        {
+            ASSERT_NEAR(output.getSample(channel, i), expected.getSample(channel, i), 1.0e-5f)
+                << "channel " << channel << ", sample " << i;
+        }
+    }
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include <iostream>
+#include "../RealtimeSafety.h"
+#include "../../Source/CS01AudioProcessor.h"
+#include "../../Source/Parameters.h"
+
+// Heap held by one plugin instance, as counted by the allocation hooks in RealtimeSafety.cpp.
+// Process-wide state (shared tables, the user preset index, JUCE singletons) is created by
+// a first instance that stays alive, so only per-instance memory is measured.
+class MemoryFootprintTest : public RealtimeSafeTest
+{
+protected:
+    static constexpr double SAMPLE_RATE = 48000.0;
+    static constexpr int BLOCK_SIZE = 512;
+
+    struct Footprint
+    {
+        juce::int64 constructed = 0;
+        juce::int64 prepared = 0;
+    };
+
+    void SetUp() override
+    {
+        RealtimeSafeTest::SetUp();
+
+        warmUp = std::make_unique<CS01AudioProcessor>(false);
+        warmUp->prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+    }
+
+    void TearDown() override
+    {
+        warmUp->releaseResources();
+        warmUp.reset();
+
+        RealtimeSafeTest::TearDown();
+    }
+
+    // The object itself is heap-allocated too, so its inline members are included
+    static Footprint measure(bool compact)
+    {
+        Footprint footprint;
+        const auto before = RealtimeSafety::getHeapBytesInUse();
+
+        auto processor = std::make_unique<CS01AudioProcessor>(compact);
+        footprint.constructed = RealtimeSafety::getHeapBytesInUse() - before;
+
+        processor->prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+        footprint.prepared = RealtimeSafety::getHeapBytesInUse() - before;
+
+        processor->releaseResources();
+        return footprint;
+    }
+
+    static void processBlocks(CS01AudioProcessor& processor, int numBlocks)
+    {
+        juce::AudioBuffer<float> buffer(2, BLOCK_SIZE);
+        juce::MidiBuffer midiBuffer;
+        midiBuffer.addEvent(juce::MidiMessage::noteOn(1, 60, 1.0f), 0);
+
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            buffer.clear();
+            processor.processBlock(buffer, midiBuffer);
+            midiBuffer.clear();
+        }
+
+        EXPECT_GT(buffer.getMagnitude(0, 0, BLOCK_SIZE), 0.0f);
+    }
+
+    std::unique_ptr<CS01AudioProcessor> warmUp;
+};
+
+TEST_F(MemoryFootprintTest, CompactInstanceUsesLessThanHalf)
+{
+    const auto full = measure(false);
+    const auto compact = measure(true);
+
+    std::cout << "Per instance: full " << full.constructed << " bytes constructed, "
+              << full.prepared << " bytes prepared; compact " << compact.constructed
+              << " bytes constructed, " << compact.prepared << " bytes prepared" << std::endl;
+
+    // The budget: a compact instance, ready to play, holds under half of a full one
+    EXPECT_GT(compact.prepared, 0);
+    EXPECT_LT(compact.prepared, full.prepared / 2);
+}
+
+TEST_F(MemoryFootprintTest, CompactInstanceCreatesStateWhenNeeded)
+{
+    CS01AudioProcessor processor(true);
+    auto& apvts = processor.getValueTreeState();
+    processor.prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+
+    EXPECT_FALSE(processor.hasEditorState());
+    processBlocks(processor, 2);
+
+    // The editor asks for the taps on the message thread; they are fed from then on
+    processor.getOutputTap().setEnabled(true);
+    EXPECT_TRUE(processor.hasEditorState());
+    processBlocks(processor, 2);
+
+    std::vector<float> tapped(BLOCK_SIZE);
+    EXPECT_EQ(processor.getOutputTap().pull(tapped.data(), BLOCK_SIZE), BLOCK_SIZE);
+
+    // Selecting the other filter adds it to the graph
+    auto* filterType = apvts.getParameter(ParameterIds::filterType);
+    filterType->setValueNotifyingHost(1.0f);
+    EXPECT_NE(dynamic_cast<ModernVCFProcessor*>(processor.getCurrentFilterProcessor()), nullptr);
+    processBlocks(processor, 2);
+
+    filterType->setValueNotifyingHost(0.0f);
+    EXPECT_NE(dynamic_cast<OriginalVCFProcessor*>(processor.getCurrentFilterProcessor()), nullptr);
+    processBlocks(processor, 2);
+
+    processor.releaseResources();
+}
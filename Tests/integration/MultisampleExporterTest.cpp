@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../RealtimeSafety.h"
+#include "../../Source/MultisampleExporter.h"
+#include "../../Source/Parameters.h"
+
+class MultisampleExporterTest : public RealtimeSafeTest
+{
+protected:
+    void SetUp() override
+    {
+        RealtimeSafeTest::SetUp();
+        directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                        .getNonexistentChildFile("CS01MultisampleExporterTest", {}, false);
+    }
+
+    void TearDown() override
+    {
+        directory.deleteRecursively();
+        RealtimeSafeTest::TearDown();
+    }
+
+    juce::File directory;
+};
+
+TEST_F(MultisampleExporterTest, ZonesCoverEveryKeyOnce)
+{
+    const auto zones = MultisampleExporter::createZones(24, 96, 3);
+    ASSERT_EQ(zones.size(), 25u);
+
+    EXPECT_EQ(zones.front().lowKey, 0);
+    EXPECT_EQ(zones.back().highKey, 127);
+
+    for (size_t i = 0; i < zones.size(); ++i)
+    {
+        EXPECT_GE(zones[i].rootNote, zones[i].lowKey);
+        EXPECT_LE(zones[i].rootNote, zones[i].highKey);
+        if (i > 0)
+            EXPECT_EQ(zones[i].lowKey, zones[i - 1].highKey + 1);
+    }
+}
+
+TEST_F(MultisampleExporterTest, LoopsSteadyToneButNotNoise)
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int noteOff = 48000;
+    constexpr double frequency = 261.63;
+    std::vector<float> samples(noteOff);
+
+    double phase = 0.0;
+    for (auto& sample : samples)
+    {
+        sample = static_cast<float>(phase * 2.0 - 1.0) * 0.5f;
+        phase += frequency / sampleRate;
+        if (phase >= 1.0)
+            phase -= 1.0;
+    }
+
+    const auto loop = MultisampleExporter::findSustainLoop(samples.data(), 4800, noteOff, sampleRate);
+    ASSERT_TRUE(loop.isValid());
+    EXPECT_GE(loop.end - loop.start, static_cast<int>(MultisampleExporter::MIN_LOOP_SECONDS * sampleRate));
+    EXPECT_LT(loop.end, noteOff);
+
+    // The loop spans a whole number of periods
+    const double periods = (loop.end + 1 - loop.start) * frequency / sampleRate;
+    EXPECT_NEAR(periods, std::round(periods), 0.05);
+
+    juce::Random random(1);
+    for (auto& sample : samples)
+        sample = random.nextFloat() * 2.0f - 1.0f;
+
+    EXPECT_FALSE(MultisampleExporter::findSustainLoop(samples.data(), 4800, noteOff, sampleRate).isValid());
+}
+
+TEST_F(MultisampleExporterTest, TrimsSilentTail)
+{
+    std::vector<float> samples(1000, 0.0f);
+    for (int i = 0; i < 500; ++i)
+        samples[static_cast<size_t>(i)] = std::exp(-i / 50.0f);
+
+    const int length = MultisampleExporter::findTrimmedLength(samples.data(), 1000, -80.0f);
+    EXPECT_GT(length, 400);
+    EXPECT_LE(length, 500);
+}
+
+TEST_F(MultisampleExporterTest, ExportsProgramsAsSfzAndWav)
+{
+    MultisampleExporter::Settings settings;
+    settings.lowestNote = 48;
+    settings.highestNote = 72;
+    settings.noteStep = 12;
+    settings.velocityLayers = {0.5f, 1.0f};
+    settings.holdSeconds = 0.5;
+    settings.numWorkers = 2;
+    settings.cacheDirectory = directory.getChildFile("cache");
+
+    MultisampleExporter exporter(settings);
+    const auto outputDirectory = directory.getChildFile("export");
+    const auto results = exporter.exportPrograms(outputDirectory, {0, 1});
+
+    ASSERT_EQ(results.size(), 2u);
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    for (const auto& result : results)
+    {
+        EXPECT_TRUE(result.error.isEmpty()) << result.error;
+        EXPECT_EQ(result.numSamples, 6);  // 3 notes x 2 velocity layers
+        ASSERT_TRUE(result.sfzFile.existsAsFile());
+
+        const auto sfz = result.sfzFile.loadFileAsString();
+        EXPECT_TRUE(sfz.contains("<global>"));
+        EXPECT_TRUE(sfz.contains("pitch_keycenter=60"));
+        EXPECT_TRUE(sfz.contains("lovel=65 hivel=127"));
+
+        const auto sampleDirectory = outputDirectory.getChildFile(result.sfzFile.getFileNameWithoutExtension());
+        const auto wavFiles = sampleDirectory.findChildFiles(juce::File::findFiles, false, "*.wav");
+        EXPECT_EQ(wavFiles.size(), 6);
+
+        for (const auto& file : wavFiles)
+        {
+            EXPECT_TRUE(sfz.contains(file.getFileName()));
+
+            std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(file));
+            ASSERT_NE(reader, nullptr) << file.getFullPathName();
+            EXPECT_EQ(reader->sampleRate, settings.sampleRate);
+            EXPECT_EQ(reader->numChannels, 1u);
+            EXPECT_EQ(reader->bitsPerSample, 24u);
+            EXPECT_GT(reader->lengthInSamples, 0);
+        }
+    }
+}
+
+TEST_F(MultisampleExporterTest, TailFollowsReleaseTime)
+{
+    MultisampleExporter::Settings settings;
+    settings.lowestNote = 60;
+    settings.highestNote = 60;
+    settings.holdSeconds = 0.3;
+    settings.numWorkers = 1;
+    settings.cacheDirectory = directory.getChildFile("cache");
+
+    OfflineRenderer renderer;
+    renderer.loadProgram(0);
+    const float release = renderer.getParameterSnapshot()[ParameterIds::release];
+
+    MultisampleExporter exporter(settings);
+    const auto results = exporter.exportPrograms(directory.getChildFile("export"), {0});
+    ASSERT_EQ(results.size(), 1u);
+    ASSERT_TRUE(results[0].error.isEmpty()) << results[0].error;
+
+    const auto wavFiles = directory.getChildFile("export")
+                              .findChildFiles(juce::File::findFiles, true, "*.wav");
+    ASSERT_EQ(wavFiles.size(), 1);
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+    std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(wavFiles[0]));
+    ASSERT_NE(reader, nullptr);
+
+    // Rendered for the release plus a margin, then trimmed to what is audible
+    const auto noteOff = juce::roundToInt(settings.holdSeconds * settings.sampleRate);
+    const auto rendered = noteOff + juce::roundToInt((release + MultisampleExporter::TAIL_MARGIN_SECONDS) *
+                                                     settings.sampleRate);
+    EXPECT_GT(reader->lengthInSamples, noteOff);
+    EXPECT_LE(reader->lengthInSamples, rendered);
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include <algorithm>
+#include "../RealtimeSafety.h"
+#include "../../Source/CS01AudioProcessor.h"
+#include "../../Source/ModulatableParameter.h"
+#include "../../Source/Parameters.h"
+
+// Parameter events passed to processBlockWithEvents (as the CLAP direct process does) must
+// take effect at their exact sample position, without a smaller host block size
+class ParameterEventTest : public RealtimeSafeTest
+{
+protected:
+    static constexpr double SAMPLE_RATE = 48000.0;
+    static constexpr int BLOCK_SIZE = 512;
+    static constexpr int NUM_BLOCKS = 4;
+    static constexpr int EVENT_BLOCK = 1;
+
+    using ParameterEvent = CS01AudioProcessor::ParameterEvent;
+
+    // Renders a held note; the events are passed with block EVENT_BLOCK
+    static std::vector<float> render(CS01AudioProcessor& processor,
+                                     const std::vector<ParameterEvent>& events)
+    {
+        processor.prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+
+        std::vector<float> output;
+        juce::AudioBuffer<float> buffer(2, BLOCK_SIZE);
+        juce::MidiBuffer midi;
+
+        for (int block = 0; block < NUM_BLOCKS; ++block)
+        {
+            buffer.clear();
+            midi.clear();
+            if (block == 0)
+                midi.addEvent(juce::MidiMessage::noteOn(1, 60, 1.0f), 0);
+
+            if (block == EVENT_BLOCK)
+                processor.processBlockWithEvents(buffer, midi, events.data(), static_cast<int>(events.size()));
+            else
+                processor.processBlock(buffer, midi);
+
+            output.insert(output.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + BLOCK_SIZE);
+        }
+
+        processor.releaseResources();
+        return output;
+    }
+
+    static int findFirstDifference(const std::vector<float>& a, const std::vector<float>& b)
+    {
+        const auto mismatch = std::mismatch(a.begin(), a.end(), b.begin());
+        return mismatch.first == a.end() ? -1 : static_cast<int>(mismatch.first - a.begin());
+    }
+
+    static juce::RangedAudioParameter* getParameter(CS01AudioProcessor& processor, const juce::String& id)
+    {
+        return processor.getValueTreeState().getParameter(id);
+    }
+};
+
+TEST_F(ParameterEventTest, ValueChangeTakesEffectAtItsSample)
+{
+    constexpr int eventPosition = 300;
+
+    CS01AudioProcessor reference;
+    const auto unchanged = render(reference, {});
+
+    CS01AudioProcessor processor;
+    auto* volume = getParameter(processor, ParameterIds::volume);
+    const auto changed = render(processor, {{eventPosition, volume, 0.2f, false}});
+
+    EXPECT_EQ(findFirstDifference(unchanged, changed), EVENT_BLOCK * BLOCK_SIZE + eventPosition);
+    EXPECT_FLOAT_EQ(volume->getValue(), 0.2f);
+}
+
+TEST_F(ParameterEventTest, ModulationLeavesTheValueAlone)
+{
+    constexpr int eventPosition = 123;
+
+    CS01AudioProcessor reference;
+    const auto unmodulated = render(reference, {});
+
+    CS01AudioProcessor processor;
+    auto* volume = dynamic_cast<ModulatableParameter*>(getParameter(processor, ParameterIds::volume));
+    ASSERT_NE(volume, nullptr);
+    const float value = volume->getValue();
+
+    const auto modulated = render(processor, {{eventPosition, volume, -0.5f, true}});
+
+    EXPECT_EQ(findFirstDifference(unmodulated, modulated), EVENT_BLOCK * BLOCK_SIZE + eventPosition);
+    EXPECT_FLOAT_EQ(volume->getValue(), value);
+    EXPECT_FLOAT_EQ(volume->getModulation(), -0.5f);
+    EXPECT_NEAR(volume->getModulatedValue(), value - 0.5f, 1.0e-6f);
+
+    // Modulation is clamped to the parameter's range
+    volume->setModulation(-2.0f);
+    EXPECT_FLOAT_EQ(volume->getModulatedValue(), 0.0f);
+}
+
+TEST_F(ParameterEventTest, HostValuesAreNotSentBack)
+{
+    struct HostListener : public juce::AudioProcessorListener
+    {
+        void audioProcessorParameterChanged(juce::AudioProcessor*, int, float) override { ++numChanges; }
+        void audioProcessorChanged(juce::AudioProcessor*, const ChangeDetails&) override {}
+
+        std::atomic<int> numChanges{0};
+    };
+
+    CS01AudioProcessor processor;
+    HostListener host;
+    processor.addListener(&host);
+
+    auto* cutoff = getParameter(processor, ParameterIds::cutoff);
+    render(processor, {{64, cutoff, 0.3f, false}});
+
+    // The value is applied, and the DSP reads it, without an echo to the host
+    EXPECT_FLOAT_EQ(cutoff->getValue(), 0.3f);
+    EXPECT_FLOAT_EQ(processor.getValueTreeState().getRawParameterValue(ParameterIds::cutoff)->load(),
+                    cutoff->convertFrom0to1(0.3f));
+    EXPECT_EQ(host.numChanges.load(), 0);
+
+    processor.removeListener(&host);
+}
+
+TEST_F(ParameterEventTest, EventsAtTheSamePositionApplyInOrder)
+{
+    CS01AudioProcessor processor;
+    auto* cutoff = getParameter(processor, ParameterIds::cutoff);
+
+    render(processor, {{10, cutoff, 0.25f, false}, {10, cutoff, 0.75f, false}});
+    EXPECT_FLOAT_EQ(cutoff->getValue(), 0.75f);
+}
+
+TEST_F(ParameterEventTest, DeterministicModeDelaysEventsByOneQuantum)
+{
+    constexpr int eventPosition = 200;
+
+    CS01AudioProcessor reference;
+    reference.setDeterministic(true);
+    const auto unchanged = render(reference, {});
+
+    CS01AudioProcessor processor;
+    processor.setDeterministic(true);
+    const auto changed =
+        render(processor, {{eventPosition, getParameter(processor, ParameterIds::volume), 0.2f, false}});
+
+    EXPECT_EQ(findFirstDifference(unchanged, changed),
+              EVENT_BLOCK * BLOCK_SIZE + eventPosition + CS01AudioProcessor::RENDER_QUANTUM);
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include <cstring>
+#include "../RealtimeSafety.h"
+#include "../../Source/RenderCache.h"
+#include "../../Source/Parameters.h"
+
+class RenderCacheTest : public RealtimeSafeTest
+{
+protected:
+    void SetUp() override
+    {
+        RealtimeSafeTest::SetUp();
+        directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                        .getNonexistentChildFile("CS01RenderCacheTest", {}, false);
+    }
+
+    void TearDown() override
+    {
+        directory.deleteRecursively();
+        RealtimeSafeTest::TearDown();
+    }
+
+    static RenderCache::Request makeRequest(int noteNumber, int waveType = 1)
+    {
+        RenderCache::Request request;
+        request.parameters[ParameterIds::waveType] = static_cast<float>(waveType);
+        request.note.noteNumber = noteNumber;
+        request.note.holdSeconds = 0.2;
+        request.note.releaseSeconds = 0.1;
+        return request;
+    }
+
+    static bool sameSamples(const RenderCache::RenderPtr& a, const RenderCache::RenderPtr& b)
+    {
+        return a != nullptr && b != nullptr && a->getNumSamples() == b->getNumSamples() &&
+               std::memcmp(a->getSamples(), b->getSamples(),
+                           sizeof(float) * static_cast<size_t>(a->getNumSamples())) == 0;
+    }
+
+    juce::File directory;
+};
+
+TEST_F(RenderCacheTest, MissIsStoredAndServedFromDisk)
+{
+    const auto request = makeRequest(60);
+    RenderCache::RenderPtr first;
+
+    {
+        RenderCache cache(directory, 48000.0, 2);
+        first = cache.get(request);
+
+        ASSERT_NE(first, nullptr);
+        EXPECT_EQ(first->getNumSamples(), 14400);
+        EXPECT_GT(first->toBuffer().getMagnitude(0, 0, first->getNumSamples()), 0.01f);
+        EXPECT_EQ(cache.getStatistics().misses, 1);
+        EXPECT_EQ(cache.getStatistics().hits, 0);
+    }
+
+    // A new cache on the same directory finds the file
+    RenderCache cache(directory, 48000.0, 2);
+    const auto second = cache.get(request);
+
+    EXPECT_EQ(cache.getStatistics().hits, 1);
+    EXPECT_EQ(cache.getStatistics().misses, 0);
+    EXPECT_TRUE(sameSamples(first, second));
+}
+
+TEST_F(RenderCacheTest, ParallelMissesMatchSerialRenders)
+{
+    std::vector<RenderCache::Request> requests;
+    for (int note : {48, 60, 72})
+        for (int waveType : {0, 1})
+            requests.push_back(makeRequest(note, waveType));
+
+    RenderCache cache(directory, 48000.0, 3);
+    const auto renders = cache.get(requests);
+    ASSERT_EQ(renders.size(), requests.size());
+    EXPECT_EQ(cache.getStatistics().misses, static_cast<int>(requests.size()));
+
+    OfflineRenderer renderer(48000.0, 256);
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        ASSERT_NE(renders[i], nullptr);
+
+        renderer.resetParametersToDefaults();
+        renderer.applyParameterSnapshot(requests[i].parameters);
+        const auto expected = renderer.renderNote(requests[i].note);
+
+        EXPECT_EQ(OfflineRenderer::calculateContentHash(renders[i]->toBuffer()),
+                  OfflineRenderer::calculateContentHash(expected))
+            << "Request " << i;
+    }
+}
+
+TEST_F(RenderCacheTest, DuplicateRequestsRenderOnce)
+{
+    RenderCache cache(directory, 48000.0, 2);
+    const auto renders = cache.get({makeRequest(60), makeRequest(64), makeRequest(60)});
+
+    EXPECT_EQ(cache.getStatistics().misses, 2);
+    EXPECT_EQ(renders[0], renders[2]);
+    EXPECT_FALSE(sameSamples(renders[0], renders[1]));
+}
+
+TEST_F(RenderCacheTest, KeyCoversEveryField)
+{
+    RenderCache cache(directory);
+    const auto reference = makeRequest(60);
+    const auto key = cache.calculateKey(reference);
+
+    auto changed = reference;
+    changed.note.noteNumber = 61;
+    EXPECT_NE(cache.calculateKey(changed), key);
+
+    changed = reference;
+    changed.note.velocity = 0.5f;
+    EXPECT_NE(cache.calculateKey(changed), key);
+
+    changed = reference;
+    changed.note.holdSeconds = 0.3;
+    EXPECT_NE(cache.calculateKey(changed), key);
+
+    changed = reference;
+    changed.note.releaseSeconds = 0.2;
+    EXPECT_NE(cache.calculateKey(changed), key);
+
+    changed = reference;
+    changed.parameters[ParameterIds::cutoff] = 0.25f;
+    EXPECT_NE(cache.calculateKey(changed), key);
+
+    RenderCache otherRate(directory, 44100.0);
+    EXPECT_NE(otherRate.calculateKey(reference), key);
+}
+
+TEST_F(RenderCacheTest, DamagedEntryIsRenderedAgain)
+{
+    const auto request = makeRequest(60);
+
+    {
+        RenderCache cache(directory, 48000.0, 1);
+        ASSERT_NE(cache.get(request), nullptr);
+    }
+
+    const auto files = directory.findChildFiles(juce::File::findFiles, false, "*.cs01render");
+    ASSERT_EQ(files.size(), 1);
+    {
+        juce::FileOutputStream stream(files[0]);
+        ASSERT_TRUE(stream.openedOk());
+        stream.setPosition(0);
+        stream.truncate();
+        stream.writeString("not a render");
+    }
+
+    RenderCache cache(directory, 48000.0, 1);
+    const auto render = cache.get(request);
+
+    ASSERT_NE(render, nullptr);
+    EXPECT_EQ(cache.getStatistics().misses, 1);
+    EXPECT_EQ(render->getNumSamples(), 14400);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../../Source/CS01AudioProcessor.h"
+#include "../../Source/Parameters.h"
+#include "../RealtimeSafety.h"
+
+// Compares the binary session state with the XML format used by earlier versions.
+// Timings are reported, not asserted, so the test stays stable on slow machines.
+class StateBenchmarkTest : public RealtimeSafeTest
+{
+protected:
+    static constexpr int NUM_ITERATIONS = 64 * 10;  // 64 instances, 10 autosaves each
+
+    // Legacy format: APVTS tree as XML, wrapped by copyXmlToBinary
+    static void getLegacyState(CS01AudioProcessor& processor, juce::MemoryBlock& destData)
+    {
+        auto xml = processor.getValueTreeState().copyState().createXml();
+        xml->setAttribute("program", processor.getCurrentProgram());
+        juce::AudioProcessor::copyXmlToBinary(*xml, destData);
+    }
+
+    template <typename Function>
+    static double measureMilliseconds(Function&& function)
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+        for (int i = 0; i < NUM_ITERATIONS; ++i)
+            function();
+        const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+        return juce::Time::highResolutionTicksToSeconds(elapsed) * 1000.0;
+    }
+};
+
+TEST_F(StateBenchmarkTest, BinaryVersusXml)
+{
+    CS01AudioProcessor processor;
+    auto& apvts = processor.getValueTreeState();
+    apvts.getParameter(ParameterIds::cutoff)->setValueNotifyingHost(0.3f);
+
+    juce::MemoryBlock binaryState;
+    juce::MemoryBlock xmlState;
+    processor.getStateInformation(binaryState);
+    getLegacyState(processor, xmlState);
+
+    const double binarySave = measureMilliseconds([&] { processor.getStateInformation(binaryState); });
+    const double xmlSave = measureMilliseconds([&] { getLegacyState(processor, xmlState); });
+    const double binaryLoad = measureMilliseconds([&] {
+        processor.setStateInformation(binaryState.getData(), static_cast<int>(binaryState.getSize()));
+    });
+    const double xmlLoad = measureMilliseconds([&] {
+        processor.setStateInformation(xmlState.getData(), static_cast<int>(xmlState.getSize()));
+    });
+
+    std::cout << "State size: binary " << binaryState.getSize() << " bytes, XML "
+              << xmlState.getSize() << " bytes" << std::endl;
+    std::cout << "Save x" << NUM_ITERATIONS << ": binary " << binarySave << " ms, XML "
+              << xmlSave << " ms" << std::endl;
+    std::cout << "Load x" << NUM_ITERATIONS << ": binary " << binaryLoad << " ms, XML "
+              << xmlLoad << " ms" << std::endl;
+
+    EXPECT_LT(binaryState.getSize(), xmlState.getSize() / 4) << "Binary state should be compact";
+
+    // Both formats must restore the same values
+    apvts.getParameter(ParameterIds::cutoff)->setValueNotifyingHost(0.9f);
+    processor.setStateInformation(binaryState.getData(), static_cast<int>(binaryState.getSize()));
+    EXPECT_NEAR(apvts.getParameter(ParameterIds::cutoff)->getValue(), 0.3f, 0.001f);
+
+    apvts.getParameter(ParameterIds::cutoff)->setValueNotifyingHost(0.9f);
+    processor.setStateInformation(xmlState.getData(), static_cast<int>(xmlState.getSize()));
+    EXPECT_NEAR(apvts.getParameter(ParameterIds::cutoff)->getValue(), 0.3f, 0.001f);
+}
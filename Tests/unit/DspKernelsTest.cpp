@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../../Source/CS01Synth/DspKernels.h"
+
+// Every variant this machine can run is checked against the scalar one. Vector lanes
+// perform the scalar operations in the same order, so results match to the last bit on
+// x86; NEON may fuse multiply-adds, so matches are checked to within a few ULP.
+class DspKernelsTest : public ::testing::Test
+{
+protected:
+    static constexpr int MAX_SAMPLES = 67;  // Covers every vector width plus a tail
+
+    void SetUp() override
+    {
+        variants = DspKernels::getSupported();
+        ASSERT_FALSE(variants.empty());
+        scalar = variants.front();
+    }
+
+    static std::vector<float> makeRandom(juce::Random& random, int numSamples, float minimum,
+                                         float maximum)
+    {
+        std::vector<float> values(static_cast<size_t>(numSamples));
+        for (auto& value : values)
+            value = minimum + random.nextFloat() * (maximum - minimum);
+        return values;
+    }
+
+    std::vector<const DspKernels*> variants;
+    const DspKernels* scalar = nullptr;
+};
+
+TEST_F(DspKernelsTest, SelectsTheWidestSupportedVariant)
+{
+    EXPECT_EQ(scalar->instructionSet, DspKernels::InstructionSet::Scalar);
+    EXPECT_EQ(&DspKernels::get(), variants.back());
+
+    juce::StringArray supported;
+    for (const auto* variant : variants)
+    {
+        ASSERT_NE(variant->name, nullptr);
+        supported.add(variant->name);
+    }
+
+    // Kept in the test report, so a run shows which variants it covered
+    RecordProperty("supported", supported.joinIntoString(",").toStdString());
+    RecordProperty("selected", DspKernels::get().name);
+}
+
+TEST_F(DspKernelsTest, PhaseIncrementsMatchScalar)
+{
+    juce::Random random(1);
+    const float referenceIncrement = 440.0f / 48000.0f;
+
+    for (int numSamples = 0; numSamples <= MAX_SAMPLES; ++numSamples)
+    {
+        // Below and above the MIDI range, so negative exponents are floored correctly
+        const auto pitches = makeRandom(random, numSamples, -24.0f, 160.0f);
+        auto expected = pitches;
+        scalar->pitchToPhaseIncrement(expected.data(), numSamples, referenceIncrement);
+
+        for (const auto* variant : variants)
+        {
+            auto output = pitches;
+            variant->pitchToPhaseIncrement(output.data(), numSamples, referenceIncrement);
+
+            for (int i = 0; i < numSamples; ++i)
+                ASSERT_FLOAT_EQ(output[static_cast<size_t>(i)], expected[static_cast<size_t>(i)])
+                    << variant->name << ", pitch " << pitches[static_cast<size_t>(i)];
+        }
+    }
+
+    // And the polynomial stays within 0.002 cents of exp2
+    for (float pitch = 0.0f; pitch < 128.0f; pitch += 0.01f)
+    {
+        const double exact = referenceIncrement * std::exp2((pitch - 69.0) / 12.0);
+        const double cents = 1200.0 * std::log2(DspKernels::getPhaseIncrement(pitch, referenceIncrement) / exact);
+        ASSERT_LT(std::abs(cents), 0.002) << "at pitch " << pitch;
+    }
+}
+
+TEST_F(DspKernelsTest, VCAGainMatchesScalar)
+{
+    juce::Random random(2);
+
+    for (int numSamples = 0; numSamples <= MAX_SAMPLES; ++numSamples)
+    {
+        // Loud enough that about half the samples saturate, in both polarities
+        const auto input = makeRandom(random, numSamples, -2.0f, 2.0f);
+        const auto eg = makeRandom(random, numSamples, 0.0f, 1.0f);
+        const float egDepth = random.nextFloat();
+        const float breathGain = 0.5f + random.nextFloat() * 0.5f;
+        const float volumeGain = 0.2f + random.nextFloat();
+
+        auto expected = input;
+        scalar->applyVCAGain(expected.data(), eg.data(), numSamples, egDepth, breathGain,
+                             volumeGain);
+
+        for (const auto* variant : variants)
+        {
+            auto output = input;
+            variant->applyVCAGain(output.data(), eg.data(), numSamples, egDepth, breathGain,
+                                  volumeGain);
+
+            for (int i = 0; i < numSamples; ++i)
+                ASSERT_FLOAT_EQ(output[static_cast<size_t>(i)], expected[static_cast<size_t>(i)])
+                    << variant->name << ", input " << input[static_cast<size_t>(i)];
+        }
+    }
+}
+
+TEST_F(DspKernelsTest, DotProductsMatchScalar)
+{
+    juce::Random random(3);
+
+    for (int numTaps = 0; numTaps <= MAX_SAMPLES; ++numTaps)
+    {
+        const auto x = makeRandom(random, numTaps, -1.0f, 1.0f);
+        const auto c0 = makeRandom(random, numTaps, -1.0f, 1.0f);
+        const auto c1 = makeRandom(random, numTaps, -1.0f, 1.0f);
+
+        float expected[2];
+        scalar->dotProductPair(x.data(), c0.data(), c1.data(), numTaps, expected);
+
+        // Summed in a different order, so equal to rounding
+        for (const auto* variant : variants)
+        {
+            float sums[2];
+            variant->dotProductPair(x.data(), c0.data(), c1.data(), numTaps, sums);
+            EXPECT_NEAR(sums[0], expected[0], 1.0e-5f) << variant->name << ", " << numTaps << " taps";
+            EXPECT_NEAR(sums[1], expected[1], 1.0e-5f) << variant->name << ", " << numTaps << " taps";
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../../Source/CS01Synth/DspProfiler.h"
+
+// Test fixture for DspProfiler tests
+class DspProfilerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        profiler = std::make_unique<DspProfiler>();
+        profiler->prepare(48000.0);
+    }
+
+    void TearDown() override
+    {
+        profiler.reset();
+    }
+
+    std::unique_ptr<DspProfiler> profiler;
+};
+
+TEST_F(DspProfilerTest, BucketsCoverTheirValues)
+{
+    int previousIndex = 0;
+
+    for (juce::int64 nanoseconds = 1; nanoseconds < 100000000; nanoseconds = nanoseconds * 3 / 2 + 1)
+    {
+        const int index = DspProfiler::getBucketIndex(nanoseconds);
+        EXPECT_GE(index, previousIndex);
+        EXPECT_LT(index, DspProfiler::NUM_BUCKETS);
+        EXPECT_GE(DspProfiler::getBucketUpperBound(index), static_cast<double>(nanoseconds));
+        previousIndex = index;
+    }
+
+    // Quarter-octave resolution above a few nanoseconds
+    const int index = DspProfiler::getBucketIndex(10000);
+    EXPECT_LT(DspProfiler::getBucketUpperBound(index), 10000.0 * 1.25 + 1.0);
+}
+
+TEST_F(DspProfilerTest, RecordsStatistics)
+{
+    // 100 blocks of 512 samples at 48 kHz: 1.0667 s of audio
+    for (int i = 0; i < 100; ++i)
+    {
+        profiler->record(DspStage::Total, 20000, 512);
+        profiler->record(DspStage::VCO, i == 99 ? 100000 : 10000, 512);
+    }
+
+    const auto vco = profiler->getStatistics(DspStage::VCO);
+    EXPECT_EQ(vco.numBlocks, 100u);
+    EXPECT_NEAR(vco.meanMicroseconds, 10.9, 0.001);
+    EXPECT_NEAR(vco.maxMicroseconds, 100.0, 0.001);
+
+    // Percentiles come from quarter-octave buckets
+    EXPECT_GE(vco.medianMicroseconds, 10.0);
+    EXPECT_LT(vco.medianMicroseconds, 12.5);
+    EXPECT_GE(vco.p99Microseconds, 10.0);
+
+    // 1090 us of VCO time over 1066667 us of audio
+    EXPECT_NEAR(vco.cpuLoad, 1090.0 / (100.0 * 512.0 / 48000.0 * 1.0e6), 1.0e-6);
+
+    const auto unused = profiler->getStatistics(DspStage::VCA);
+    EXPECT_EQ(unused.numBlocks, 0u);
+    EXPECT_EQ(unused.cpuLoad, 0.0);
+
+    const auto report = profiler->createReport();
+    EXPECT_TRUE(report.contains("Total"));
+    EXPECT_TRUE(report.contains("VCO"));
+    EXPECT_FALSE(report.contains("VCA"));
+
+    profiler->reset();
+    EXPECT_EQ(profiler->getStatistics(DspStage::VCO).numBlocks, 0u);
+}
+
+TEST_F(DspProfilerTest, MeasurementsGoToTheThreadsProfiler)
+{
+    // Without a context nothing is recorded
+    {
+        const DspProfiler::ScopedMeasurement measurement(DspStage::LFO, 64);
+    }
+    EXPECT_EQ(profiler->getStatistics(DspStage::LFO).numBlocks, 0u);
+
+    {
+        const DspProfiler::ScopedContext context(*profiler);
+        EXPECT_EQ(DspProfiler::getCurrent(), profiler.get());
+
+        const DspProfiler::ScopedMeasurement measurement(DspStage::LFO, 64);
+        juce::Thread::sleep(1);
+    }
+
+    EXPECT_EQ(DspProfiler::getCurrent(), nullptr);
+
+    const auto lfo = profiler->getStatistics(DspStage::LFO);
+    EXPECT_EQ(lfo.numBlocks, 1u);
+    EXPECT_GT(lfo.maxMicroseconds, 500.0);
+
+    // Other threads are not affected by this thread's context
+    const DspProfiler::ScopedContext context(*profiler);
+    std::atomic<DspProfiler*> seenOnOtherThread{profiler.get()};
+    std::thread other([&] { seenOnOtherThread = DspProfiler::getCurrent(); });
+    other.join();
+    EXPECT_EQ(seenOnOtherThread.load(), nullptr);
+}
@@ -174,3 +174,19 @@ TEST_F(IG02610LPFTest, AsymmetricClippingBehavior)
     EXPECT_GT(negativeRatio, 0.0001f);
     EXPECT_LT(negativeRatio, 0.1f);
 }
+
+TEST_F(IG02610LPFTest, MagnitudeResponse)
+{
+    const double sampleRate = 44100.0;
+
+    // Unity gain well below the cutoff, strong attenuation well above it
+    EXPECT_NEAR(IG02610LPF::getMagnitudeResponse(1000.0f, 0.2f, sampleRate, 20.0), 1.0f, 0.02f);
+    EXPECT_LT(IG02610LPF::getMagnitudeResponse(1000.0f, 0.2f, sampleRate, 15000.0), 0.1f);
+
+    // Higher resonance lifts the response around the cutoff
+    EXPECT_GT(IG02610LPF::getMagnitudeResponse(1000.0f, 0.8f, sampleRate, 1000.0),
+              IG02610LPF::getMagnitudeResponse(1000.0f, 0.2f, sampleRate, 1000.0));
+
+    // The notch mix keeps some high frequency content at low cutoffs with resonance
+    EXPECT_GT(IG02610LPF::getMagnitudeResponse(100.0f, 0.8f, sampleRate, 15000.0), 0.05f);
+}
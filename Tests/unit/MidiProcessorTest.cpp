@@ -191,6 +191,30 @@ TEST_F(MidiProcessorTest, ControllerMessages)
     EXPECT_NEAR(apvts->getRawParameterValue(ParameterIds::breathInput)->load(), 100.0f / 127.0f, 0.01f);
 }
 
+TEST_F(MidiProcessorTest, ProgramChangeWithBankSelect)
+{
+    juce::AudioBuffer<float> buffer(1, 512);
+    juce::MidiBuffer midiBuffer;
+
+    std::vector<int> receivedPrograms;
+    processor->onProgramChange = [&receivedPrograms](int program) { receivedPrograms.push_back(program); };
+
+    // Plain program change uses bank 0
+    midiBuffer.addEvent(juce::MidiMessage::programChange(1, 5), 0);
+    processor->processBlock(buffer, midiBuffer);
+
+    // Bank 1 (MSB 0, LSB 1) selects programs 128-255
+    midiBuffer.clear();
+    midiBuffer.addEvent(juce::MidiMessage::controllerEvent(1, 0, 0), 0);
+    midiBuffer.addEvent(juce::MidiMessage::controllerEvent(1, 32, 1), 1);
+    midiBuffer.addEvent(juce::MidiMessage::programChange(1, 3), 2);
+    processor->processBlock(buffer, midiBuffer);
+
+    ASSERT_EQ(receivedPrograms.size(), 2u);
+    EXPECT_EQ(receivedPrograms[0], 5);
+    EXPECT_EQ(receivedPrograms[1], 131);
+}
+
 TEST_F(MidiProcessorTest, MonophonicNoteManagement)
 {
     // Create mock tone generator as sound generator
@@ -263,3 +263,16 @@ TEST_F(ModernVCFProcessorTest, Modulation)
         EXPECT_GT(modDepthParam->get(), 0.0f);
     }
 }
+
+TEST_F(ModernVCFProcessorTest, MagnitudeResponse)
+{
+    // Neutral response before the processor knows its sample rate
+    EXPECT_FLOAT_EQ(processor->getMagnitudeResponse(1000.0), 1.0f);
+
+    processor->prepareToPlay(44100.0, 512);
+
+    // Default settings: 1 kHz cutoff, minimum resonance
+    EXPECT_NEAR(processor->getMagnitudeResponse(10.0), 1.0f, 0.02f);
+    EXPECT_LT(processor->getMagnitudeResponse(1000.0), 0.2f);
+    EXPECT_LT(processor->getMagnitudeResponse(10000.0), 0.1f);
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../../Source/CS01Synth/ParameterRamp.h"
+#include "../../Source/Parameters.h"
+
+// Test fixture for ParameterRamp tests
+class ParameterRampTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        dummyProcessor = std::make_unique<juce::AudioProcessorGraph>();
+
+        juce::AudioProcessorValueTreeState::ParameterLayout layout;
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            ParameterIds::cutoff, "Cutoff",
+            juce::NormalisableRange<float>(20.0f, 20000.0f), 20000.0f));
+        layout.add(std::make_unique<juce::AudioParameterChoice>(
+            ParameterIds::waveType, "Wave Type", juce::StringArray{"Saw", "Square"}, 0));
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            ParameterIds::volume, "Volume",
+            juce::NormalisableRange<float>(0.0f, 1.0f), 1.0f));
+
+        apvts = std::make_unique<juce::AudioProcessorValueTreeState>(
+            *dummyProcessor, nullptr, "PARAMETERS", std::move(layout));
+
+        cutoff = apvts->getParameter(ParameterIds::cutoff);
+        waveType = apvts->getParameter(ParameterIds::waveType);
+        volume = apvts->getParameter(ParameterIds::volume);
+
+        // Volume is a global parameter, so presets never change it
+        sync = std::make_unique<ParameterSync>(*apvts);
+        ramp.prepare(*sync, 48000.0, 0.01, {cutoff, waveType, volume}, {false, false, true});
+    }
+
+    // Counts the notifications the host would receive
+    struct HostListener : public juce::AudioProcessorListener
+    {
+        void audioProcessorParameterChanged(juce::AudioProcessor*, int, float) override { ++numChanges; }
+        void audioProcessorChanged(juce::AudioProcessor*, const ChangeDetails&) override {}
+
+        int numChanges = 0;
+    };
+
+    std::unique_ptr<juce::AudioProcessorGraph> dummyProcessor;
+    std::unique_ptr<juce::AudioProcessorValueTreeState> apvts;
+    std::unique_ptr<ParameterSync> sync;
+    juce::RangedAudioParameter* cutoff = nullptr;
+    juce::RangedAudioParameter* waveType = nullptr;
+    juce::RangedAudioParameter* volume = nullptr;
+    ParameterRamp ramp;
+};
+
+TEST_F(ParameterRampTest, RampLength)
+{
+    EXPECT_EQ(ramp.getRampLengthInSamples(), 480);
+    EXPECT_FALSE(ramp.isActive());
+}
+
+TEST_F(ParameterRampTest, DiscreteParametersJumpImmediately)
+{
+    const float targets[] = {0.0f, 1.0f, 0.0f};
+    ramp.start(targets);
+
+    EXPECT_TRUE(ramp.isActive());
+    EXPECT_FLOAT_EQ(waveType->getValue(), 1.0f);
+
+    // Continuous parameters have not moved yet
+    EXPECT_FLOAT_EQ(cutoff->getValue(), 1.0f);
+}
+
+TEST_F(ParameterRampTest, ContinuousParametersInterpolate)
+{
+    const float targets[] = {0.0f, 0.0f, 0.0f};
+    ramp.start(targets);
+
+    ramp.advance(ramp.getRampLengthInSamples() / 2);
+    EXPECT_NEAR(cutoff->getValue(), 0.5f, 0.01f);
+    EXPECT_TRUE(ramp.isActive());
+
+    ramp.advance(ramp.getRampLengthInSamples());
+    EXPECT_FLOAT_EQ(cutoff->getValue(), 0.0f);
+    EXPECT_FALSE(ramp.isActive());
+}
+
+TEST_F(ParameterRampTest, ExcludedParametersUntouched)
+{
+    const float targets[] = {0.5f, 1.0f, 0.0f};
+    ramp.start(targets);
+    ramp.advance(ramp.getRampLengthInSamples());
+
+    EXPECT_FLOAT_EQ(volume->getValue(), 1.0f);
+}
+
+TEST_F(ParameterRampTest, StopHoldsCurrentValues)
+{
+    const float targets[] = {0.0f, 0.0f, 0.0f};
+    ramp.start(targets);
+    ramp.advance(ramp.getRampLengthInSamples() / 4);
+    ramp.stop();
+
+    const float heldValue = cutoff->getValue();
+    ramp.advance(ramp.getRampLengthInSamples());
+
+    EXPECT_FALSE(ramp.isActive());
+    EXPECT_FLOAT_EQ(cutoff->getValue(), heldValue);
+}
+
+TEST_F(ParameterRampTest, PublishedOnceWhenFinished)
+{
+    HostListener host;
+    dummyProcessor->addListener(&host);
+
+    const float targets[] = {0.0f, 1.0f, 0.0f};
+    ramp.start(targets);
+
+    // The DSP reads the new values at once; nobody is notified on the audio thread
+    for (int i = 0; i < 4; ++i)
+        ramp.advance(ramp.getRampLengthInSamples() / 4);
+
+    EXPECT_FALSE(ramp.isActive());
+    EXPECT_FLOAT_EQ(apvts->getRawParameterValue(ParameterIds::cutoff)->load(), 20.0f);
+    EXPECT_FLOAT_EQ(apvts->getRawParameterValue(ParameterIds::waveType)->load(), 1.0f);
+    EXPECT_EQ(host.numChanges, 0);
+
+    // Then one notification per changed parameter, and the state follows
+    EXPECT_FALSE(sync->publish());
+    EXPECT_EQ(host.numChanges, 2);
+    EXPECT_FLOAT_EQ(static_cast<float>(apvts->copyState().getChildWithProperty("id", ParameterIds::cutoff)
+                                           .getProperty("value")),
+                    20.0f);
+
+    sync->publish();
+    EXPECT_EQ(host.numChanges, 2);
+
+    dummyProcessor->removeListener(&host);
+}
+
+TEST_F(ParameterRampTest, HostValuesAreNotSentBack)
+{
+    HostListener host;
+    dummyProcessor->addListener(&host);
+
+    // As the CLAP direct process applies a value from the host's event list
+    sync->setValue(*cutoff, 0.25f, ParameterSync::Notify::Editor);
+    EXPECT_FLOAT_EQ(cutoff->getValue(), 0.25f);
+    EXPECT_FLOAT_EQ(apvts->getRawParameterValue(ParameterIds::cutoff)->load(),
+                    cutoff->convertFrom0to1(0.25f));
+
+    // The state follows and the editor re-reads its controls, but the host hears nothing
+    EXPECT_TRUE(sync->publish());
+    EXPECT_EQ(host.numChanges, 0);
+    EXPECT_FLOAT_EQ(static_cast<float>(apvts->copyState().getChildWithProperty("id", ParameterIds::cutoff)
+                                           .getProperty("value")),
+                    cutoff->convertFrom0to1(0.25f));
+
+    // A change the plugin made to the same parameter still reaches the host
+    sync->setValue(*cutoff, 0.5f, ParameterSync::Notify::Editor);
+    sync->setValue(*cutoff, 0.5f, ParameterSync::Notify::EditorAndHost);
+    EXPECT_FALSE(sync->publish());
+    EXPECT_EQ(host.numChanges, 1);
+
+    dummyProcessor->removeListener(&host);
+}
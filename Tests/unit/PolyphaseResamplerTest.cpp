@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../../Source/CS01Synth/PolyphaseResampler.h"
+
+// Test fixture for PolyphaseResampler tests
+class PolyphaseResamplerTest : public ::testing::Test
+{
+protected:
+    // Run a sine through the resampler in blocks of varying size and return the output
+    std::vector<float> resampleSine(double inputRate, double outputRate, double frequency,
+                                    int totalOutputSamples, int maxBlockSize)
+    {
+        resampler.prepare(inputRate, outputRate, maxBlockSize);
+
+        std::vector<float> input(static_cast<size_t>(resampler.getMaximumInputSamplesRequired()));
+        std::vector<float> output(static_cast<size_t>(totalOutputSamples));
+        int64_t inputPosition = 0;
+        int produced = 0;
+        int blockIndex = 0;
+
+        while (produced < totalOutputSamples)
+        {
+            const int blockSize = juce::jmin(1 + (blockIndex++ * 37) % maxBlockSize,
+                                             totalOutputSamples - produced);
+            const int required = resampler.getNumInputSamplesRequired(blockSize);
+
+            EXPECT_LE(required, resampler.getMaximumInputSamplesRequired());
+
+            for (int i = 0; i < required; ++i)
+            {
+                input[static_cast<size_t>(i)] = static_cast<float>(
+                    std::sin(juce::MathConstants<double>::twoPi * frequency *
+                             static_cast<double>(inputPosition++) / inputRate));
+            }
+
+            resampler.process(input.data(), required, output.data() + produced, blockSize);
+            produced += blockSize;
+        }
+
+        return output;
+    }
+
+    PolyphaseResampler resampler;
+};
+
+TEST_F(PolyphaseResamplerTest, ReportsLatency)
+{
+    resampler.prepare(48000.0, 44100.0, 512);
+    EXPECT_GT(resampler.getLatencyInOutputSamples(), 0);
+    EXPECT_LT(resampler.getLatencyInOutputSamples(), PolyphaseResampler::NUM_TAPS);
+
+    // Upsampling doubles the latency in output samples
+    resampler.prepare(48000.0, 96000.0, 512);
+    EXPECT_EQ(resampler.getLatencyInOutputSamples(), PolyphaseResampler::NUM_TAPS);
+}
+
+TEST_F(PolyphaseResamplerTest, PreservesInBandSine)
+{
+    const std::pair<double, double> rates[] = {
+        {48000.0, 44100.0}, {48000.0, 88200.0}, {96000.0, 44100.0}, {96000.0, 96000.0}};
+
+    for (const auto& [inputRate, outputRate] : rates)
+    {
+        const auto output = resampleSine(inputRate, outputRate, 1000.0, 4096, 512);
+
+        // Output is aligned with the input timeline, so it should match the ideal sine
+        float maxError = 0.0f;
+        for (int i = PolyphaseResampler::NUM_TAPS * 2; i < static_cast<int>(output.size()); ++i)
+        {
+            const auto expected = static_cast<float>(
+                std::sin(juce::MathConstants<double>::twoPi * 1000.0 * i / outputRate));
+            maxError = juce::jmax(maxError, std::abs(output[static_cast<size_t>(i)] - expected));
+        }
+
+        EXPECT_LT(maxError, 1.0e-3f) << inputRate << " Hz -> " << outputRate << " Hz";
+    }
+}
+
+TEST_F(PolyphaseResamplerTest, RejectsAliasingWhenDecimating)
+{
+    // 30 kHz is above the 22.05 kHz output Nyquist and must be filtered out
+    const auto output = resampleSine(96000.0, 44100.0, 30000.0, 8192, 512);
+
+    double sumOfSquares = 0.0;
+    for (size_t i = 1024; i < output.size(); ++i)
+        sumOfSquares += output[i] * output[i];
+
+    const double rms = std::sqrt(sumOfSquares / static_cast<double>(output.size() - 1024));
+    EXPECT_LT(rms, 0.01);
+}
+
+TEST_F(PolyphaseResamplerTest, BlockSizeIndependent)
+{
+    const auto smallBlocks = resampleSine(48000.0, 44100.0, 440.0, 2048, 64);
+    const auto largeBlocks = resampleSine(48000.0, 44100.0, 440.0, 2048, 1024);
+
+    for (size_t i = 0; i < smallBlocks.size(); ++i)
+    {
+        EXPECT_FLOAT_EQ(smallBlocks[i], largeBlocks[i]) << "Mismatch at sample " << i;
+    }
+}
@@ -57,7 +57,9 @@ protected:
             "mod", "Modulation", "|",
             std::make_unique<juce::AudioParameterFloat>(
                 ParameterIds::pitchBend, "Pitch Bend", 
-                juce::NormalisableRange<float>(0.0f, 12.0f), 0.0f)
+                juce::NormalisableRange<float>(0.0f, 12.0f), 0.0f),
+            std::make_unique<juce::AudioParameterInt>(
+                ParameterIds::pitchBendUpRange, "Pitch Bend Up", 0, 12, 12)
         );
         layout.add(std::move(modGroup));
         
@@ -221,3 +223,239 @@ TEST_F(ProgramManagerTest, ExcludedParameters)
     EXPECT_NEAR(restoredBreath, 0.1f, 0.01f) << "Breath input should not be restored";
     EXPECT_NEAR(restoredPitchBend, 0.1f, 0.01f) << "Pitch bend should not be restored";
 }
+
+TEST_F(ProgramManagerTest, SnapshotFromXml)
+{
+    TestAudioProcessor processor;
+    juce::AudioProcessorValueTreeState apvts(processor, nullptr, "Parameters", createTestParameterLayout());
+    ProgramManager programManager(apvts);
+
+    // Preset with one parameter missing (FEET) and one excluded parameter (VOLUME)
+    auto xml = juce::parseXML("<Parameters>"
+                              "  <PARAM id=\"WAVE_TYPE\" value=\"3\"/>"
+                              "  <PARAM id=\"VOLUME\" value=\"0.1\"/>"
+                              "</Parameters>");
+    ASSERT_NE(xml, nullptr);
+
+    auto snapshot = programManager.createSnapshotFromXml(*xml);
+    EXPECT_EQ(snapshot.values.size(), static_cast<size_t>(processor.getParameters().size()))
+        << "Snapshot should hold one value per parameter";
+
+    // Move parameters away from both the preset and the defaults
+    auto* waveType = apvts.getParameter(ParameterIds::waveType);
+    auto* feet = apvts.getParameter(ParameterIds::feet);
+    auto* volume = apvts.getParameter(ParameterIds::volume);
+    waveType->setValueNotifyingHost(0.0f);
+    feet->setValueNotifyingHost(1.0f);
+    volume->setValueNotifyingHost(0.9f);
+
+    programManager.applySnapshot(snapshot);
+
+    EXPECT_NEAR(waveType->getValue(), waveType->convertTo0to1(3.0f), 0.001f)
+        << "Preset value should be applied";
+    EXPECT_NEAR(feet->getValue(), feet->getDefaultValue(), 0.001f)
+        << "Parameters missing from the preset should fall back to their default";
+    EXPECT_NEAR(volume->getValue(), 0.9f, 0.001f) << "Excluded parameters should not change";
+}
+
+TEST_F(ProgramManagerTest, PitchBendRangeIsKeptAcrossPrograms)
+{
+    TestAudioProcessor processor;
+    juce::AudioProcessorValueTreeState apvts(processor, nullptr, "Parameters", createTestParameterLayout());
+    ProgramManager programManager(apvts);
+
+    auto* range = apvts.getParameter(ParameterIds::pitchBendUpRange);
+    range->setValueNotifyingHost(range->convertTo0to1(2.0f));
+
+    // A program that names the range still leaves the player's setting alone
+    auto xml = juce::parseXML("<Parameters>"
+                              "  <PARAM id=\"WAVE_TYPE\" value=\"2\"/>"
+                              "  <PARAM id=\"PITCH_BEND_UP_RANGE\" value=\"7\"/>"
+                              "</Parameters>");
+    ASSERT_NE(xml, nullptr);
+
+    programManager.applySnapshot(programManager.createSnapshotFromXml(*xml));
+    EXPECT_NEAR(range->convertFrom0to1(range->getValue()), 2.0f, 0.001f);
+
+    for (int program = 0; program < programManager.getNumPrograms(); ++program)
+    {
+        programManager.setCurrentProgram(program);
+        EXPECT_NEAR(range->convertFrom0to1(range->getValue()), 2.0f, 0.001f) << "program " << program;
+    }
+}
+
+TEST_F(ProgramManagerTest, LoadPresetFromXmlMatchesSnapshot)
+{
+    TestAudioProcessor processor;
+    juce::AudioProcessorValueTreeState apvts(processor, nullptr, "Parameters", createTestParameterLayout());
+    ProgramManager programManager(apvts);
+
+    auto xml = juce::parseXML("<Parameters>"
+                              "  <PARAM id=\"WAVE_TYPE\" value=\"4\"/>"
+                              "  <PARAM id=\"FEET\" value=\"0\"/>"
+                              "</Parameters>");
+    ASSERT_NE(xml, nullptr);
+
+    programManager.loadPresetFromXml(xml.get());
+
+    auto current = programManager.createSnapshotFromCurrentState();
+    auto expected = programManager.createSnapshotFromXml(*xml);
+    ASSERT_EQ(current.values.size(), expected.values.size());
+
+    int index = 0;
+    for (auto* param : processor.getParameters())
+    {
+        auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(param);
+        ASSERT_NE(ranged, nullptr);
+
+        // Excluded parameters keep their own values, everything else follows the preset
+        if (ranged->getParameterID() != ParameterIds::volume &&
+            ranged->getParameterID() != ParameterIds::breathInput &&
+            ranged->getParameterID() != ParameterIds::pitchBend &&
+            ranged->getParameterID() != ParameterIds::pitchBendUpRange)
+        {
+            EXPECT_NEAR(current.values[static_cast<size_t>(index)],
+                        expected.values[static_cast<size_t>(index)], 0.001f)
+                << ranged->getParameterID();
+        }
+
+        ++index;
+    }
+}
+
+TEST_F(ProgramManagerTest, BinaryStateFormat)
+{
+    TestAudioProcessor processor;
+    juce::AudioProcessorValueTreeState apvts(processor, nullptr, "Parameters", createTestParameterLayout());
+    ProgramManager programManager(apvts);
+
+    apvts.getParameter(ParameterIds::waveType)->setValueNotifyingHost(0.75f);
+
+    juce::MemoryBlock savedState;
+    programManager.getStateInformation(savedState);
+
+    // Header (12 bytes) plus 8 bytes per parameter, realtime inputs excluded
+    const int numSessionParameters = processor.getParameters().size() - 2;
+    EXPECT_EQ(savedState.getSize(), static_cast<size_t>(12 + numSessionParameters * 8));
+    EXPECT_EQ(std::memcmp(savedState.getData(), "CS1S", 4), 0) << "State should start with the magic";
+
+    // Truncated data must not change anything
+    apvts.getParameter(ParameterIds::waveType)->setValueNotifyingHost(0.0f);
+    programManager.setStateInformation(savedState.getData(), static_cast<int>(savedState.getSize()) - 4);
+    EXPECT_NEAR(apvts.getParameter(ParameterIds::waveType)->getValue(), 0.0f, 0.001f);
+
+    programManager.setStateInformation(savedState.getData(), static_cast<int>(savedState.getSize()));
+    EXPECT_NEAR(apvts.getParameter(ParameterIds::waveType)->getValue(), 0.75f, 0.001f);
+}
+
+TEST_F(ProgramManagerTest, OutOfRangeProgramInStateIsClamped)
+{
+    TestAudioProcessor processor;
+    juce::AudioProcessorValueTreeState apvts(processor, nullptr, "Parameters", createTestParameterLayout());
+    ProgramManager programManager(apvts);
+    const int lastProgram = programManager.getNumPrograms() - 1;
+
+    // Binary state: the little-endian program index follows the 8-byte magic and version header
+    juce::MemoryBlock savedState;
+    programManager.getStateInformation(savedState);
+
+    for (const int program : { -5, lastProgram + 1, 1 << 30 })
+    {
+        juce::MemoryBlock state(savedState);
+        auto* programField = static_cast<char*>(state.getData()) + 8;
+        const auto stored = juce::ByteOrder::swapIfBigEndian(static_cast<juce::uint32>(program));
+        std::memcpy(programField, &stored, sizeof(stored));
+
+        programManager.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+        EXPECT_GE(programManager.getCurrentProgram(), 0) << "program " << program;
+        EXPECT_LE(programManager.getCurrentProgram(), lastProgram) << "program " << program;
+    }
+
+    // Legacy XML state
+    auto xml = apvts.copyState().createXml();
+    ASSERT_NE(xml, nullptr);
+    xml->setAttribute("program", lastProgram + 10);
+
+    juce::MemoryBlock legacyState;
+    juce::AudioProcessor::copyXmlToBinary(*xml, legacyState);
+    programManager.setStateInformation(legacyState.getData(), static_cast<int>(legacyState.getSize()));
+    EXPECT_EQ(programManager.getCurrentProgram(), lastProgram);
+}
+
+TEST_F(ProgramManagerTest, UserProgramRestoredBeforeScanIsKept)
+{
+    auto directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                         .getNonexistentChildFile("CS01ProgramManagerTest", "");
+    ASSERT_TRUE(directory.createDirectory());
+
+    for (const juce::String name : { "Alpha", "Beta", "Gamma" })
+    {
+        juce::XmlElement xml("Parameters");
+        ASSERT_TRUE(xml.writeTo(directory.getChildFile(name + ".xml")));
+    }
+
+    TestAudioProcessor processor;
+    juce::AudioProcessorValueTreeState apvts(processor, nullptr, "Parameters", createTestParameterLayout());
+
+    for (const bool legacyXml : { false, true })
+    {
+        // The index reports on the message thread, so the state below is restored before
+        // this manager has seen the user presets
+        UserPresetIndex index(directory);
+        ProgramManager programManager(apvts, index);
+
+        int numFactoryPrograms = 0;
+        while (numFactoryPrograms < programManager.getNumPrograms()
+               && !programManager.isUserPreset(numFactoryPrograms))
+            ++numFactoryPrograms;
+        const int gammaProgram = numFactoryPrograms + 2;
+
+        juce::MemoryBlock state;
+        if (legacyXml)
+        {
+            auto xml = apvts.copyState().createXml();
+            ASSERT_NE(xml, nullptr);
+            xml->setAttribute("program", gammaProgram);
+            juce::AudioProcessor::copyXmlToBinary(*xml, state);
+        }
+        else
+        {
+            programManager.getStateInformation(state);
+            const auto stored = juce::ByteOrder::swapIfBigEndian(static_cast<juce::uint32>(gammaProgram));
+            std::memcpy(static_cast<char*>(state.getData()) + 8, &stored, sizeof(stored));
+        }
+
+        programManager.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+
+        ASSERT_TRUE(index.waitForRescan(5000));
+        index.dispatchPendingMessages();
+
+        ASSERT_EQ(programManager.getNumPrograms(), numFactoryPrograms + 3);
+        EXPECT_EQ(programManager.getCurrentProgram(), gammaProgram) << (legacyXml ? "XML" : "binary");
+        EXPECT_EQ(programManager.getProgramName(programManager.getCurrentProgram()), "Gamma");
+    }
+
+    directory.deleteRecursively();
+}
+
+TEST_F(ProgramManagerTest, LegacyXmlStateImport)
+{
+    TestAudioProcessor processor;
+    juce::AudioProcessorValueTreeState apvts(processor, nullptr, "Parameters", createTestParameterLayout());
+    ProgramManager programManager(apvts);
+
+    // State as written by earlier versions: APVTS tree as XML with the program attribute
+    apvts.getParameter(ParameterIds::waveType)->setValueNotifyingHost(0.25f);
+    auto xml = apvts.copyState().createXml();
+    ASSERT_NE(xml, nullptr);
+    xml->setAttribute("program", 1);
+
+    juce::MemoryBlock legacyState;
+    juce::AudioProcessor::copyXmlToBinary(*xml, legacyState);
+
+    apvts.getParameter(ParameterIds::waveType)->setValueNotifyingHost(1.0f);
+    programManager.setStateInformation(legacyState.getData(), static_cast<int>(legacyState.getSize()));
+
+    EXPECT_NEAR(apvts.getParameter(ParameterIds::waveType)->getValue(), 0.25f, 0.001f);
+    EXPECT_EQ(programManager.getCurrentProgram(), 1);
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../../Source/CS01Synth/LFOProcessor.h"
+#include "../../Source/CS01Synth/SharedTables.h"
+#include "../../Source/Parameters.h"
+
+// Test fixture for SharedTables tests
+class SharedTablesTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        dummyProcessor = std::make_unique<juce::AudioProcessorGraph>();
+
+        juce::AudioProcessorValueTreeState::ParameterLayout layout;
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            ParameterIds::lfoSpeed, "LFO Speed",
+            juce::NormalisableRange<float>(0.1f, 10.0f, 0.01f, 0.5f), 1.0f));
+        apvts = std::make_unique<juce::AudioProcessorValueTreeState>(*dummyProcessor, nullptr,
+                                                                     "PARAMETERS", std::move(layout));
+    }
+
+    void TearDown() override
+    {
+        apvts.reset();
+        dummyProcessor.reset();
+    }
+
+    std::unique_ptr<juce::AudioProcessorGraph> dummyProcessor;
+    std::unique_ptr<juce::AudioProcessorValueTreeState> apvts;
+};
+
+TEST_F(SharedTablesTest, InstancesShareOneCopy)
+{
+    juce::SharedResourcePointer<SharedTables> tables;
+    const int holders = tables.getReferenceCount();
+
+    {
+        LFOProcessor first(*apvts);
+        LFOProcessor second(*apvts);
+        juce::SharedResourcePointer<SharedTables> other;
+
+        EXPECT_EQ(&other.get(), &tables.get());
+        EXPECT_EQ(tables.getReferenceCount(), holders + 3);
+    }
+
+    EXPECT_EQ(tables.getReferenceCount(), holders);
+}
+
+TEST_F(SharedTablesTest, OscillatorTablesFollowTheirFunctions)
+{
+    juce::SharedResourcePointer<SharedTables> tables;
+    const float pi = juce::MathConstants<float>::pi;
+
+    for (float x = -pi; x < pi; x += 0.01f)
+    {
+        const float lfo = 1.0f - 4.0f * std::abs(std::round(x - 0.25f) - (x - 0.25f));
+        const float pwm = std::asin(std::sin(x)) * (2.0f / pi);
+
+        // Linear interpolation only rounds off the corners of the triangles; the LFO's are
+        // sharper, as its function repeats every unit of x
+        EXPECT_NEAR(tables->lfoTriangle(x), lfo, 0.1f) << "at " << x;
+        EXPECT_NEAR(tables->pwmTriangle(x), pwm, 0.02f) << "at " << x;
+    }
+}
+
+TEST_F(SharedTablesTest, IntegratorGainFollowsTan)
+{
+    juce::SharedResourcePointer<SharedTables> tables;
+
+    for (float frequency = 0.0005f; frequency < 0.46f; frequency *= 1.1f)
+    {
+        const float expected = static_cast<float>(std::tan(juce::MathConstants<double>::pi * frequency));
+        EXPECT_NEAR(tables->getIntegratorGain(frequency), expected, expected * 1.0e-4f)
+            << "at " << frequency;
+    }
+
+    // Frequencies at and above Nyquist are clamped instead of reaching the pole of tan()
+    EXPECT_TRUE(std::isfinite(tables->getIntegratorGain(0.5f)));
+    EXPECT_FLOAT_EQ(tables->getIntegratorGain(2.0f), tables->getIntegratorGain(0.49f));
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../../Source/CS01Synth/SpectrumAnalyser.h"
+
+// Test fixture for SpectrumAnalyser tests
+class SpectrumAnalyserTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        analyser = std::make_unique<SpectrumAnalyser>();
+        analyser->prepare(SAMPLE_RATE);
+    }
+
+    void TearDown() override
+    {
+        analyser.reset();
+    }
+
+    void pushSine(double frequency, float amplitude, int numBlocks)
+    {
+        std::vector<float> block(512);
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            for (auto& sample : block)
+            {
+                sample = amplitude * static_cast<float>(std::sin(phase));
+                phase += juce::MathConstants<double>::twoPi * frequency / SAMPLE_RATE;
+            }
+
+            analyser->pushSamples(block.data(), static_cast<int>(block.size()));
+        }
+    }
+
+    // Polls until a spectrum newer than the given version arrives
+    bool waitForSpectrum(std::vector<float>& spectrum, double& binWidth, int& version)
+    {
+        for (int i = 0; i < 200; ++i)
+        {
+            if (analyser->getLatestSpectrum(spectrum, binWidth, version))
+                return true;
+
+            juce::Thread::sleep(5);
+        }
+
+        return false;
+    }
+
+    static constexpr double SAMPLE_RATE = 44100.0;
+    std::unique_ptr<SpectrumAnalyser> analyser;
+    double phase = 0.0;
+};
+
+TEST_F(SpectrumAnalyserTest, DisabledAnalyserIgnoresInput)
+{
+    EXPECT_FALSE(analyser->isEnabled());
+
+    pushSine(1000.0, 0.8f, 16);
+    juce::Thread::sleep(50);
+
+    std::vector<float> spectrum;
+    double binWidth = 0.0;
+    int version = 0;
+    EXPECT_FALSE(analyser->getLatestSpectrum(spectrum, binWidth, version));
+}
+
+TEST_F(SpectrumAnalyserTest, FindsSinePeak)
+{
+    analyser->setAveraging(0.0f);
+    analyser->setEnabled(true);
+
+    // The analysis thread discards stale input when it starts
+    juce::Thread::sleep(20);
+    pushSine(1000.0, 0.8f, 16);
+
+    std::vector<float> spectrum;
+    double binWidth = 0.0;
+    int version = 0;
+    ASSERT_TRUE(waitForSpectrum(spectrum, binWidth, version));
+
+    const int fftSize = 1 << SpectrumAnalyser::DEFAULT_FFT_ORDER;
+    EXPECT_EQ(static_cast<int>(spectrum.size()), fftSize / 2 + 1);
+    EXPECT_NEAR(binWidth, SAMPLE_RATE / fftSize, 1.0e-9);
+
+    const auto peak = std::max_element(spectrum.begin(), spectrum.end());
+    const double peakFrequency = static_cast<double>(peak - spectrum.begin()) * binWidth;
+
+    // 0.8 amplitude is -1.9 dB; allow for the Hann window's scalloping loss
+    EXPECT_NEAR(peakFrequency, 1000.0, binWidth);
+    EXPECT_NEAR(*peak, -1.9f, 1.6f);
+
+    // Far away from the peak the window sidelobes are well down
+    EXPECT_LT(spectrum[static_cast<size_t>(10000.0 / binWidth)], -60.0f);
+
+    analyser->setEnabled(false);
+    EXPECT_FALSE(analyser->isEnabled());
+}
+
+TEST_F(SpectrumAnalyserTest, FftSizeCanBeChanged)
+{
+    analyser->setFftOrder(SpectrumAnalyser::MIN_FFT_ORDER);
+    analyser->setEnabled(true);
+    juce::Thread::sleep(20);
+    pushSine(440.0, 0.5f, 8);
+
+    std::vector<float> spectrum;
+    double binWidth = 0.0;
+    int version = 0;
+    ASSERT_TRUE(waitForSpectrum(spectrum, binWidth, version));
+    EXPECT_EQ(static_cast<int>(spectrum.size()), (1 << SpectrumAnalyser::MIN_FFT_ORDER) / 2 + 1);
+
+    // Out-of-range orders are clamped
+    analyser->setFftOrder(100);
+    EXPECT_EQ(analyser->getFftOrder(), SpectrumAnalyser::MAX_FFT_ORDER);
+}
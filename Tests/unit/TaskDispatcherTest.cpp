@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include <thread>
+#include "../../Source/CS01Synth/TaskDispatcher.h"
+
+// Stands in for a host thread pool: one thread per task, joined before returning
+class ThreadExecutor : public TaskDispatcher::Executor
+{
+public:
+    bool execute(TaskDispatcher& dispatcher, int numTasks) noexcept override
+    {
+        ++numBatches;
+        if (declines)
+            return false;
+
+        std::vector<std::thread> workers;
+        for (int i = 0; i < numTasks; ++i)
+            workers.emplace_back([&dispatcher, i] { dispatcher.runTask(i); });
+        for (auto& worker : workers)
+            worker.join();
+        return true;
+    }
+
+    int numBatches = 0;
+    bool declines = false;
+};
+
+// Test fixture for TaskDispatcher tests
+class TaskDispatcherTest : public ::testing::Test
+{
+protected:
+    struct Record
+    {
+        std::atomic<int> calls{0};
+        std::thread::id thread;
+        int order = -1;
+        std::atomic<int>* sequence = nullptr;
+    };
+
+    static void recordTask(void* context) noexcept
+    {
+        auto& record = *static_cast<Record*>(context);
+        record.thread = std::this_thread::get_id();
+        record.order = (*record.sequence)++;
+        ++record.calls;
+    }
+
+    void addTasks(int numTasks)
+    {
+        for (int i = 0; i < numTasks; ++i)
+        {
+            records[static_cast<size_t>(i)].sequence = &sequence;
+            dispatcher.add(recordTask, &records[static_cast<size_t>(i)]);
+        }
+    }
+
+    TaskDispatcher dispatcher;
+    std::array<Record, TaskDispatcher::MAX_TASKS + 1> records;
+    std::atomic<int> sequence{0};
+};
+
+TEST_F(TaskDispatcherTest, RunsSeriallyWithoutExecutor)
+{
+    addTasks(3);
+    EXPECT_EQ(dispatcher.getNumTasks(), 3);
+
+    dispatcher.run();
+
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(records[static_cast<size_t>(i)].calls.load(), 1);
+        EXPECT_EQ(records[static_cast<size_t>(i)].order, i);
+        EXPECT_EQ(records[static_cast<size_t>(i)].thread, std::this_thread::get_id());
+    }
+    EXPECT_EQ(dispatcher.getNumTasks(), 0);
+}
+
+TEST_F(TaskDispatcherTest, ExecutorRunsTasksOnItsWorkers)
+{
+    ThreadExecutor executor;
+    dispatcher.setExecutor(&executor);
+
+    addTasks(4);
+    dispatcher.run();
+
+    EXPECT_EQ(executor.numBatches, 1);
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(records[static_cast<size_t>(i)].calls.load(), 1);
+        EXPECT_NE(records[static_cast<size_t>(i)].thread, std::this_thread::get_id());
+    }
+}
+
+TEST_F(TaskDispatcherTest, DecliningExecutorFallsBackToSerial)
+{
+    ThreadExecutor executor;
+    executor.declines = true;
+    dispatcher.setExecutor(&executor);
+
+    addTasks(2);
+    dispatcher.run();
+
+    EXPECT_EQ(executor.numBatches, 1);
+    for (int i = 0; i < 2; ++i)
+    {
+        EXPECT_EQ(records[static_cast<size_t>(i)].calls.load(), 1);
+        EXPECT_EQ(records[static_cast<size_t>(i)].thread, std::this_thread::get_id());
+    }
+}
+
+TEST_F(TaskDispatcherTest, SingleTaskRunsInline)
+{
+    ThreadExecutor executor;
+    dispatcher.setExecutor(&executor);
+
+    addTasks(1);
+    dispatcher.run();
+
+    EXPECT_EQ(executor.numBatches, 0);
+    EXPECT_EQ(records[0].calls.load(), 1);
+    EXPECT_EQ(records[0].thread, std::this_thread::get_id());
+}
+
+TEST_F(TaskDispatcherTest, TasksBeyondCapacityRunImmediately)
+{
+    addTasks(TaskDispatcher::MAX_TASKS + 1);
+
+    EXPECT_EQ(dispatcher.getNumTasks(), TaskDispatcher::MAX_TASKS);
+    EXPECT_EQ(records[TaskDispatcher::MAX_TASKS].calls.load(), 1);
+
+    dispatcher.run();
+    for (const auto& record : records)
+        EXPECT_EQ(record.calls.load(), 1);
+}
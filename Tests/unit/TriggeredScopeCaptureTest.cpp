@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../../Source/CS01Synth/TriggeredScopeCapture.h"
+
+// Test fixture for TriggeredScopeCapture tests
+class TriggeredScopeCaptureTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        capture = std::make_unique<TriggeredScopeCapture>();
+        capture->prepare(SAMPLE_RATE);
+    }
+
+    // Feed a sine in host-sized blocks and collect every published snapshot
+    std::vector<TriggeredScopeCapture::Snapshot> processSine(double frequency, int numBlocks)
+    {
+        std::vector<TriggeredScopeCapture::Snapshot> snapshots;
+        std::vector<float> block(512);
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            for (auto& sample : block)
+            {
+                sample = 0.8f * static_cast<float>(std::sin(phase));
+                phase += juce::MathConstants<double>::twoPi * frequency / SAMPLE_RATE;
+            }
+
+            capture->process(block.data(), static_cast<int>(block.size()));
+
+            if (const auto* snapshot = capture->acquireLatest())
+                snapshots.push_back(*snapshot);
+        }
+
+        return snapshots;
+    }
+
+    static constexpr double SAMPLE_RATE = 48000.0;
+    std::unique_ptr<TriggeredScopeCapture> capture;
+    double phase = 0.1;
+};
+
+TEST_F(TriggeredScopeCaptureTest, CapturesWholePeriodsAtZeroCrossing)
+{
+    auto snapshots = processSine(440.0, 50);
+    ASSERT_FALSE(snapshots.empty());
+
+    const double expectedPeriod = SAMPLE_RATE / 440.0;
+
+    for (const auto& snapshot : snapshots)
+    {
+        ASSERT_TRUE(snapshot.triggered);
+        EXPECT_NEAR(snapshot.period, expectedPeriod, 0.01);
+        EXPECT_GE(snapshot.numPeriods, 2);
+        EXPECT_GE(static_cast<float>(snapshot.numSamples), snapshot.period * snapshot.numPeriods);
+
+        // The crossing lies between the first two samples
+        EXPECT_LT(snapshot.samples[0], 0.0f);
+        EXPECT_GE(snapshot.samples[1], 0.0f);
+
+        const float first = snapshot.samples[0];
+        const float crossing = first + (snapshot.samples[1] - first) * snapshot.startOffset;
+        EXPECT_NEAR(crossing, 0.0f, 0.01f);
+    }
+}
+
+TEST_F(TriggeredScopeCaptureTest, SnapshotRateIsLimited)
+{
+    // One second of audio at 48 kHz
+    auto snapshots = processSine(1000.0, 94);
+
+    EXPECT_GT(snapshots.size(), 10u);
+    EXPECT_LE(snapshots.size(), 60u) << "Snapshots should be rate limited";
+}
+
+TEST_F(TriggeredScopeCaptureTest, HighNotesCaptureEnoughSamples)
+{
+    auto snapshots = processSine(4000.0, 20);
+    ASSERT_FALSE(snapshots.empty());
+
+    // 12 samples per period; more periods are captured to fill the display
+    EXPECT_GE(snapshots.back().numSamples, 256);
+    EXPECT_GT(snapshots.back().numPeriods, 2);
+}
+
+TEST_F(TriggeredScopeCaptureTest, FreeRunsWithoutTrigger)
+{
+    std::vector<float> silence(512, 0.0f);
+    const TriggeredScopeCapture::Snapshot* snapshot = nullptr;
+
+    for (int b = 0; b < 20 && snapshot == nullptr; ++b)
+    {
+        capture->process(silence.data(), static_cast<int>(silence.size()));
+        snapshot = capture->acquireLatest();
+    }
+
+    ASSERT_NE(snapshot, nullptr) << "Silence should still produce untriggered snapshots";
+    EXPECT_FALSE(snapshot->triggered);
+    EXPECT_EQ(capture->acquireLatest(), nullptr) << "A snapshot is only delivered once";
+}
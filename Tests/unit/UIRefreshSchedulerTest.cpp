@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../../Source/UI/UIRefreshScheduler.h"
+
+namespace
+{
+    // Client that counts frames and optionally dirties a component
+    class CountingClient : public UIRefreshScheduler::Client
+    {
+    public:
+        void refresh() override
+        {
+            ++numRefreshes;
+
+            if (target != nullptr)
+            {
+                markDirty(*target, { 0, 0, 10, 10 });
+                markDirty(*target, { 5, 5, 10, 10 });
+            }
+
+            if (onRefresh)
+                onRefresh();
+        }
+
+        int numRefreshes = 0;
+        juce::Component* target = nullptr;
+        std::function<void()> onRefresh;
+    };
+}
+
+// Test fixture for UIRefreshScheduler tests
+class UIRefreshSchedulerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Without a peer the v-blank never fires; frames are dispatched by hand
+        host = std::make_unique<juce::Component>();
+        host->setSize(200, 100);
+        scheduler = std::make_unique<UIRefreshScheduler>(*host);
+    }
+
+    void TearDown() override
+    {
+        scheduler.reset();
+        host.reset();
+    }
+
+    std::unique_ptr<juce::Component> host;
+    std::unique_ptr<UIRefreshScheduler> scheduler;
+};
+
+TEST_F(UIRefreshSchedulerTest, ClientsAreRefreshedOncePerFrame)
+{
+    CountingClient first, second;
+    scheduler->addClient(first);
+    scheduler->addClient(second);
+    scheduler->addClient(first);  // Adding twice is harmless
+    EXPECT_EQ(scheduler->getNumClients(), 2);
+
+    scheduler->dispatchFrame();
+    scheduler->dispatchFrame();
+
+    EXPECT_EQ(first.numRefreshes, 2);
+    EXPECT_EQ(second.numRefreshes, 2);
+
+    scheduler->removeClient(first);
+    scheduler->dispatchFrame();
+
+    EXPECT_EQ(first.numRefreshes, 2);
+    EXPECT_EQ(second.numRefreshes, 3);
+}
+
+TEST_F(UIRefreshSchedulerTest, DirtyRegionsAreCoalescedPerComponent)
+{
+    juce::Component child;
+    child.setSize(50, 50);
+
+    scheduler->markDirty(child, { 0, 0, 10, 10 });
+    scheduler->markDirty(child, { 20, 20, 10, 10 });
+    scheduler->markDirty(*host, { 0, 0, 10, 10 });
+    EXPECT_EQ(scheduler->getNumDirtyComponents(), 2);
+
+    // Areas outside the component are ignored
+    juce::Component empty;
+    scheduler->markDirty(empty, { 0, 0, 10, 10 });
+    EXPECT_EQ(scheduler->getNumDirtyComponents(), 2);
+
+    scheduler->dispatchFrame();
+    EXPECT_EQ(scheduler->getNumDirtyComponents(), 0);
+}
+
+TEST_F(UIRefreshSchedulerTest, ClientDirtyRegionsAreFlushedAfterTheFrame)
+{
+    auto child = std::make_unique<juce::Component>();
+    child->setSize(50, 50);
+
+    CountingClient client;
+    client.target = child.get();
+    client.onRefresh = [this]
+    {
+        // Requests are held until all clients have run
+        EXPECT_EQ(scheduler->getNumDirtyComponents(), 1);
+    };
+    scheduler->addClient(client);
+
+    scheduler->dispatchFrame();
+    EXPECT_EQ(scheduler->getNumDirtyComponents(), 0);
+
+    // A component deleted before the flush is skipped
+    scheduler->markDirty(*child, { 0, 0, 10, 10 });
+    child.reset();
+    client.target = nullptr;
+    client.onRefresh = nullptr;
+    scheduler->dispatchFrame();
+    EXPECT_EQ(scheduler->getNumDirtyComponents(), 0);
+}
+
+TEST_F(UIRefreshSchedulerTest, ClientsUnregisterThemselves)
+{
+    auto client = std::make_unique<CountingClient>();
+    scheduler->addClient(*client);
+    EXPECT_EQ(scheduler->getNumClients(), 1);
+
+    client.reset();
+    EXPECT_EQ(scheduler->getNumClients(), 0);
+
+    // Removing a client from inside its own refresh takes effect after the frame
+    CountingClient selfRemoving, other;
+    selfRemoving.onRefresh = [this, &selfRemoving] { scheduler->removeClient(selfRemoving); };
+    scheduler->addClient(selfRemoving);
+    scheduler->addClient(other);
+
+    scheduler->dispatchFrame();
+    scheduler->dispatchFrame();
+
+    EXPECT_EQ(selfRemoving.numRefreshes, 1);
+    EXPECT_EQ(other.numRefreshes, 2);
+    EXPECT_EQ(scheduler->getNumClients(), 1);
+}
+
+TEST_F(UIRefreshSchedulerTest, ClientsOutliveScheduler)
+{
+    CountingClient client;
+    scheduler->addClient(client);
+    scheduler.reset();
+
+    // Must not touch the destroyed scheduler
+    SUCCEED();
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <JuceHeader.h>
+#include "../../Source/UserPresetIndex.h"
+
+// Test fixture for UserPresetIndex tests
+class UserPresetIndexTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                        .getNonexistentChildFile("CS01PresetIndexTest", "");
+        ASSERT_TRUE(directory.createDirectory());
+    }
+
+    void TearDown() override
+    {
+        directory.deleteRecursively();
+    }
+
+    void writePreset(const juce::String& name, float cutoff)
+    {
+        juce::XmlElement xml("Parameters");
+        auto* param = xml.createNewChildElement("PARAM");
+        param->setAttribute("id", "CUTOFF");
+        param->setAttribute("value", cutoff);
+
+        ASSERT_TRUE(xml.writeTo(directory.getChildFile(name + ".xml")));
+    }
+
+    static float getCutoff(const UserPresetIndex::Entry& entry)
+    {
+        auto value = entry.values->find("CUTOFF");
+        return value != entry.values->end() ? value->second : -1.0f;
+    }
+
+    static constexpr int TIMEOUT_MS = 5000;
+
+    juce::File directory;
+};
+
+TEST_F(UserPresetIndexTest, IndexesExistingPresets)
+{
+    writePreset("Zeta", 1000.0f);
+    writePreset("Alpha", 2000.0f);
+
+    UserPresetIndex index(directory);
+    ASSERT_TRUE(index.waitForRescan(TIMEOUT_MS));
+
+    auto entries = index.getEntries();
+    ASSERT_EQ(entries.size(), 2u);
+
+    // Sorted by name with decoded values
+    EXPECT_EQ(entries[0].name, "Alpha");
+    EXPECT_EQ(entries[0].filename, "Alpha.xml");
+    EXPECT_FLOAT_EQ(getCutoff(entries[0]), 2000.0f);
+    EXPECT_EQ(entries[1].name, "Zeta");
+    EXPECT_FLOAT_EQ(getCutoff(entries[1]), 1000.0f);
+    EXPECT_NE(entries[0].parameterHash, entries[1].parameterHash);
+}
+
+TEST_F(UserPresetIndexTest, TracksDirectoryChanges)
+{
+    writePreset("First", 1000.0f);
+    writePreset("Second", 2000.0f);
+
+    UserPresetIndex index(directory);
+    ASSERT_TRUE(index.waitForRescan(TIMEOUT_MS));
+    const int generation = index.getGeneration();
+
+    // Add, modify and remove presets behind the index's back
+    writePreset("Third", 3000.0f);
+    writePreset("First", 1500.0f);
+    auto firstFile = directory.getChildFile("First.xml");
+    firstFile.setLastModificationTime(juce::Time::getCurrentTime() + juce::RelativeTime::seconds(10));
+    directory.getChildFile("Second.xml").deleteFile();
+
+    ASSERT_TRUE(index.waitForRescan(TIMEOUT_MS));
+    EXPECT_GT(index.getGeneration(), generation);
+
+    auto entries = index.getEntries();
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries[0].name, "First");
+    EXPECT_FLOAT_EQ(getCutoff(entries[0]), 1500.0f);
+    EXPECT_EQ(entries[1].name, "Third");
+}
+
+TEST_F(UserPresetIndexTest, UnchangedDirectoryKeepsGeneration)
+{
+    writePreset("Only", 1000.0f);
+
+    UserPresetIndex index(directory);
+    ASSERT_TRUE(index.waitForRescan(TIMEOUT_MS));
+    const int generation = index.getGeneration();
+
+    ASSERT_TRUE(index.waitForRescan(TIMEOUT_MS));
+    EXPECT_EQ(index.getGeneration(), generation);
+}
+
+TEST_F(UserPresetIndexTest, MissingDirectoryIsNotCreated)
+{
+    auto missing = directory.getChildFile("DoesNotExist");
+
+    UserPresetIndex index(missing);
+    ASSERT_TRUE(index.waitForRescan(TIMEOUT_MS));
+
+    EXPECT_TRUE(index.getEntries().empty());
+    EXPECT_FALSE(missing.exists());
+}
+
+TEST_F(UserPresetIndexTest, ParameterHashDependsOnValues)
+{
+    std::map<juce::String, float> a{{"CUTOFF", 1000.0f}, {"RESONANCE", 0.5f}};
+    std::map<juce::String, float> b = a;
+
+    EXPECT_EQ(UserPresetIndex::calculateParameterHash(a), UserPresetIndex::calculateParameterHash(b));
+
+    b["RESONANCE"] = 0.6f;
+    EXPECT_NE(UserPresetIndex::calculateParameterHash(a), UserPresetIndex::calculateParameterHash(b));
+}
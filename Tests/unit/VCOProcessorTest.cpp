@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include <JuceHeader.h>
+#include <cmath>
+#include <thread>
 #include "../../Source/CS01Synth/VCOProcessor.h"
+#include "../../Source/CS01Synth/SynthConstants.h"
 #include "../../Source/Parameters.h"
 #include "../mocks/MockToneGenerator.h"
 
@@ -68,6 +71,10 @@ protected:
         layout.add(std::make_unique<juce::AudioParameterFloat>(
             ParameterIds::pwmSpeed, "PWM Speed", 
             juce::NormalisableRange<float>(0.1f, 10.0f), 1.0f));
+
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            ParameterIds::pitchBend, "Pitch Bend",
+            juce::NormalisableRange<float>(0.0f, 12.0f), 0.0f));
         
         // Add parameters for MockToneGenerator
         layout.add(std::make_unique<juce::AudioParameterFloat>(
@@ -170,6 +177,21 @@ TEST_F(VCOProcessorTest, NoteHandling)
     }
 }
 
+TEST_F(VCOProcessorTest, RenderBeforePrepareTerminates)
+{
+    // The tone generator works in chunks; before prepareToPlay it must still make progress
+    ISoundGenerator* noteHandler = processor->getSoundGenerator();
+    ASSERT_NE(noteHandler, nullptr);
+
+    noteHandler->startNote(60, 1.0f, 8192);
+    juce::AudioBuffer<float> buffer(1, 300);
+    buffer.clear();
+    noteHandler->renderNextBlock(buffer, 0, buffer.getNumSamples());
+
+    for (int i = 0; i < buffer.getNumSamples(); ++i)
+        EXPECT_TRUE(std::isfinite(buffer.getSample(0, i)));
+}
+
 TEST_F(VCOProcessorTest, WaveformChange)
 {
     try {
@@ -382,3 +404,99 @@ TEST_F(VCOProcessorTest, BufferProcessing)
         FAIL() << "Exception in BufferProcessing test: " << e.what();
     }
 }
+
+TEST_F(VCOProcessorTest, LfoModulatesPitchWithinBlock)
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numSamples = 1024;
+
+    apvts->getParameter(ParameterIds::modDepth)->setValueNotifyingHost(1.0f);
+    auto* waveTypeParam = dynamic_cast<juce::AudioParameterChoice*>(apvts->getParameter(ParameterIds::waveType));
+    waveTypeParam->setValueNotifyingHost(waveTypeParam->convertTo0to1(1)); // Sawtooth
+
+    // A 21 Hz LFO starting at zero, so reading it once per block would leave it unmodulated
+    std::vector<float> lfo(numSamples);
+    for (int i = 0; i < numSamples; ++i)
+        lfo[static_cast<size_t>(i)] = std::sin(juce::MathConstants<float>::twoPi * 21.0f * i / static_cast<float>(sampleRate));
+
+    const auto render = [this](const std::vector<float>& lfoSignal, int blockSize)
+    {
+        VCOProcessor vco(*apvts);
+        vco.prepareToPlay(sampleRate, numSamples);
+        vco.getSoundGenerator()->startNote(69, 1.0f, 8192);
+
+        std::vector<float> output;
+        juce::MidiBuffer midi;
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            // The LFO comes in on the channel the output goes out on
+            juce::AudioBuffer<float> buffer(1, blockSize);
+            buffer.copyFrom(0, 0, lfoSignal.data() + start, blockSize);
+            vco.processBlock(buffer, midi);
+            output.insert(output.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + blockSize);
+        }
+        return output;
+    };
+
+    const auto modulated = render(lfo, numSamples);
+    EXPECT_NE(modulated, render(std::vector<float>(numSamples, 0.0f), numSamples));
+
+    // The same LFO split over smaller blocks gives the same output
+    EXPECT_EQ(render(lfo, 256), modulated);
+    EXPECT_EQ(render(lfo, 32), modulated);
+}
+
+TEST_F(VCOProcessorTest, NoiseGeneratorCreatedOnDemand)
+{
+    auto* feetParam = dynamic_cast<juce::AudioParameterChoice*>(apvts->getParameter(ParameterIds::feet));
+    const float whiteNoise = feetParam->convertTo0to1(static_cast<float>(Feet::WhiteNoise));
+    const float eightFeet = feetParam->convertTo0to1(2.0f);
+
+    VCOProcessor vco(*apvts, false, true);
+    EXPECT_FALSE(vco.hasNoiseGenerator());
+
+    // Before prepareToPlay a switch creates it right away
+    feetParam->setValueNotifyingHost(whiteNoise);
+    EXPECT_TRUE(vco.hasNoiseGenerator());
+    EXPECT_TRUE(vco.isNoiseMode());
+    feetParam->setValueNotifyingHost(eightFeet);
+
+    // After prepareToPlay the message thread still creates it right away, and the switch
+    // is made by the next block
+    VCOProcessor edited(*apvts, false, true);
+    edited.prepareToPlay(44100.0, 512);
+    feetParam->setValueNotifyingHost(whiteNoise);
+    EXPECT_TRUE(edited.hasNoiseGenerator());
+    EXPECT_TRUE(edited.isNoiseMode());
+
+    auto* toneGenerator = edited.getSoundGenerator();
+    juce::AudioBuffer<float> buffer(1, 512);
+    juce::MidiBuffer midi;
+    edited.processBlock(buffer, midi);
+    EXPECT_NE(edited.getSoundGenerator(), toneGenerator);
+    EXPECT_FALSE(edited.createPendingNoiseGenerator());
+    feetParam->setValueNotifyingHost(eightFeet);
+
+    // From the audio thread the tone generator stays until the message thread has created
+    // the noise generator
+    VCOProcessor prepared(*apvts, false, true);
+    prepared.prepareToPlay(44100.0, 512);
+    std::thread([&] { feetParam->setValueNotifyingHost(whiteNoise); }).join();
+    EXPECT_FALSE(prepared.hasNoiseGenerator());
+    EXPECT_FALSE(prepared.isNoiseMode());
+
+    EXPECT_TRUE(prepared.createPendingNoiseGenerator());
+    EXPECT_TRUE(prepared.isNoiseMode());
+    EXPECT_FALSE(prepared.createPendingNoiseGenerator());
+
+    // A request that was withdrawn creates nothing
+    std::thread([&] { feetParam->setValueNotifyingHost(eightFeet); }).join();
+    VCOProcessor withdrawn(*apvts, false, true);
+    withdrawn.prepareToPlay(44100.0, 512);
+    std::thread([&] {
+        feetParam->setValueNotifyingHost(whiteNoise);
+        feetParam->setValueNotifyingHost(eightFeet);
+    }).join();
+    EXPECT_FALSE(withdrawn.createPendingNoiseGenerator());
+    EXPECT_FALSE(withdrawn.hasNoiseGenerator());
+}